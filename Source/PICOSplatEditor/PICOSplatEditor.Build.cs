@@ -14,6 +14,7 @@ public class PICOSplatEditor : ModuleRules
 			new string[]
 			{
 				"AssetDefinition",
+				"AssetRegistry",
 				"Core",
 				"CoreUObject",
 				"GeometryCore",
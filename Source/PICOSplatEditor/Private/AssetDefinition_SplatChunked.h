@@ -0,0 +1,39 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "AssetDefinitionDefault.h"
+#include "SplatChunkedAsset.h"
+#include "SplatConstants.h"
+
+#include "AssetDefinition_SplatChunked.generated.h"
+
+/**
+ * Metadata about `USplatChunkedAsset` for Editor UI.
+ */
+UCLASS()
+class UAssetDefinition_SplatChunked final : public UAssetDefinitionDefault
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UAssetDefinition Interface
+	virtual FText GetAssetDisplayName() const override
+	{
+		return NSLOCTEXT(
+			"AssetTypeActions",
+			"AssetTypeActions_SplatChunked",
+			"Chunked Splat Asset");
+	}
+	virtual TSoftClassPtr<UObject> GetAssetClass() const override
+	{
+		return USplatChunkedAsset::StaticClass();
+	}
+	virtual FLinearColor GetAssetColor() const override
+	{
+		return PICO::Splat::EditorColor.ReinterpretAsLinear();
+	}
+	//~ End UAssetDefinition Interface
+};
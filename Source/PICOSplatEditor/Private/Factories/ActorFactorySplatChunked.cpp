@@ -0,0 +1,33 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "ActorFactorySplatChunked.h"
+
+#include "Misc/AssertionMacros.h"
+
+bool UActorFactorySplatChunked::CanCreateActorFrom(
+	const FAssetData& AssetData, FText& OutErrorMsg)
+{
+	if (!AssetData.IsValid() ||
+	    !AssetData.IsInstanceOf(USplatChunkedAsset::StaticClass()))
+	{
+		OutErrorMsg = NSLOCTEXT(
+			"CanCreateActor",
+			"NoSplatChunkedAsset",
+			"A valid chunked splat asset must be specified.");
+		return false;
+	}
+
+	return true;
+}
+
+void UActorFactorySplatChunked::PostSpawnActor(
+	UObject* Asset, AActor* NewActor)
+{
+	ASplatChunkedActor* ChunkedActor =
+		CastChecked<ASplatChunkedActor>(NewActor);
+	check(ChunkedActor->ChunkedComponent);
+	ChunkedActor->ChunkedComponent->Asset =
+		CastChecked<USplatChunkedAsset>(Asset);
+}
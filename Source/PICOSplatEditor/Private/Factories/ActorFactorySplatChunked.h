@@ -0,0 +1,31 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "ActorFactories/ActorFactory.h"
+#include "SplatChunkedActor.h"
+
+#include "ActorFactorySplatChunked.generated.h"
+
+/**
+ * Creates `ASplatChunkedActor`s from `USplatChunkedAsset`s in Editor.
+ */
+UCLASS()
+class UActorFactorySplatChunked final : public UActorFactory
+{
+	GENERATED_BODY()
+
+public:
+	UActorFactorySplatChunked()
+	{
+		NewActorClass = ASplatChunkedActor::StaticClass();
+	}
+
+	//~ Begin UActorFactory Interface
+	virtual bool CanCreateActorFrom(
+		const FAssetData& AssetData, FText& OutErrorMsg) override;
+	virtual void PostSpawnActor(UObject* Asset, AActor* NewActor) override;
+	//~ End UActorFactory Interface
+};
@@ -0,0 +1,622 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "CompactSplatReader.h"
+
+#include "Logging.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/Compression.h"
+#include "SplatConstants.h"
+#include "String/Find.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+// Coefficient of the 0th degree spherical harmonic, mapping base colors to
+// colors.
+constexpr float SH_C0 = 0.28209479177387814f;
+
+constexpr uint32 SPZ_MAGIC = 0x5053474e;
+constexpr int32 SPZ_HEADER_SIZE = 16;
+// Scale of base colors in a `.spz`, relative to 8 bits.
+constexpr float SPZ_COLOR_SCALE = 0.15f;
+
+constexpr int32 SPLAT_STRIDE = 32;
+
+constexpr int32 CHUNK_SIZE = 256;
+// Largest header searched for compressed `.ply` elements, in bytes.
+constexpr int32 MAX_PLY_HEADER_SIZE = 64 * 1024;
+
+/**
+ * @param Probability - Probability, in [0, 1].
+ * @return The logit of the probability, clamped to be finite.
+ */
+float Logit(float Probability)
+{
+	const float P = FMath::Clamp(Probability, 1e-6f, 1.f - 1e-6f);
+	return FMath::Loge(P / (1.f - P));
+}
+
+/**
+ * @param Buffer - Buffer to read from.
+ * @param Offset - Offset to read at, in bytes.
+ * @return The little-endian value at the offset.
+ */
+template <typename T>
+T ReadValue(TConstArrayView<uint8> Buffer, int64 Offset)
+{
+	T Value;
+	FMemory::Memcpy(&Value, &Buffer[Offset], sizeof(T));
+	return Value;
+}
+
+/**
+ * @param Packed - Packed value.
+ * @param Shift - Offset of the field, in bits.
+ * @param Bits - Size of the field, in bits.
+ * @return The field, as a normalized value in [0, 1].
+ */
+float UnpackUnorm(uint32 Packed, int32 Shift, int32 Bits)
+{
+	const uint32 Max = (1u << Bits) - 1;
+	return float((Packed >> Shift) & Max) / Max;
+}
+
+/**
+ * Unpacks a vector packed with 11, 10, then 11 bits, within bounds.
+ *
+ * @param Packed - Packed vector.
+ * @param Bounds - Bounds the vector is quantized within.
+ * @return The vector.
+ */
+FVector3f Unpack111011(uint32 Packed, const FBox3f& Bounds)
+{
+	const FVector3f Alpha(
+		UnpackUnorm(Packed, 21, 11),
+		UnpackUnorm(Packed, 11, 10),
+		UnpackUnorm(Packed, 0, 11));
+	return Bounds.Min + Alpha * (Bounds.Max - Bounds.Min);
+}
+
+/**
+ * Finds the degree of spherical harmonics from the coefficients stored, up to
+ * the highest degree supported.
+ *
+ * @param NumPerChannel - Number of coefficients stored per channel.
+ * @return The degree, or 0 if there are none.
+ */
+uint32 FindSHDegree(int32 NumPerChannel)
+{
+	uint32 Degree = 0;
+	while (Degree < MaxSupportedSHDegree &&
+	       int32(GetNumSHCoefficients(Degree + 1)) <= NumPerChannel)
+	{
+		++Degree;
+	}
+	return Degree;
+}
+
+/**
+ * @param Buffer - Start of a `.ply`.
+ * @param Element - Name of an element.
+ * @return True, if the header of the `.ply` declares the element.
+ */
+bool HasPlyElement(TConstArrayView<uint8> Buffer, FAnsiStringView Element)
+{
+	const FAnsiStringView Header(
+		reinterpret_cast<const ANSICHAR*>(Buffer.GetData()),
+		FMath::Min(Buffer.Num(), MAX_PLY_HEADER_SIZE));
+	const int32 End = UE::String::FindFirst(Header, "end_header");
+	if (End == INDEX_NONE)
+	{
+		return false;
+	}
+
+	TAnsiStringBuilder<64> Declaration;
+	Declaration << "\nelement " << Element << ' ';
+	return UE::String::FindFirst(Header.Left(End), Declaration) != INDEX_NONE;
+}
+
+} // namespace
+
+float FPlySplat::GetProperty(std::string_view Name) const
+{
+	if (Name.size() == 1)
+	{
+		switch (Name[0])
+		{
+		case 'x':
+			return Position.X;
+		case 'y':
+			return Position.Y;
+		case 'z':
+			return Position.Z;
+		}
+		return 0.f;
+	}
+	if (Name == "opacity")
+	{
+		return Opacity;
+	}
+
+	// Properties suffixed with an index.
+	const int32 Index = Name.back() - '0';
+	const std::string_view Prefix = Name.substr(0, Name.size() - 1);
+	if (Prefix == "scale_" && Index >= 0 && Index < 3)
+	{
+		return LogScale[Index];
+	}
+	if (Prefix == "rot_" && Index >= 0 && Index < 4)
+	{
+		return Rotation[Index];
+	}
+	if (Prefix == "f_dc_" && Index >= 0 && Index < 3)
+	{
+		return ColorDC[Index];
+	}
+	return 0.f;
+}
+
+bool FCompactSplatReader::FindFormat(
+	const FString& Extension,
+	TConstArrayView<uint8> Buffer,
+	EFormat& OutFormat)
+{
+	if (Extension.Equals(TEXT("spz"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = EFormat::Spz;
+		return true;
+	}
+	if (Extension.Equals(TEXT("splat"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = EFormat::Splat;
+		return true;
+	}
+	if (Extension.Equals(TEXT("ply"), ESearchCase::IgnoreCase) &&
+	    HasPlyElement(Buffer, "chunk"))
+	{
+		OutFormat = EFormat::CompressedPly;
+		return true;
+	}
+	return false;
+}
+
+bool FCompactSplatReader::Parse(TConstArrayView<uint8> Buffer, EFormat InFormat)
+{
+	Format = InFormat;
+	NumSplats = 0;
+	SHDegree = 0;
+	NumStoredSH = 0;
+	Data = TConstArrayView<uint8>();
+	Decompressed.Empty();
+	SpzVersion = 0;
+	Chunks.Empty();
+	SHProperties.Reset();
+
+	switch (Format)
+	{
+	case EFormat::Spz:
+		return ParseSpz(Buffer);
+	case EFormat::Splat:
+		return ParseSplat(Buffer);
+	case EFormat::CompressedPly:
+		return ParseCompressedPly(Buffer);
+	}
+	checkNoEntry();
+	return false;
+}
+
+bool FCompactSplatReader::ParseSpz(TConstArrayView<uint8> Buffer)
+{
+	// Gzip stores the size of its contents, modulo 2^32, last.
+	constexpr int32 GZIP_HEADER_SIZE = 10;
+	constexpr int32 GZIP_TRAILER_SIZE = 8;
+	if (Buffer.Num() < GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE)
+	{
+		PICO_LOGE(".spz is too small.");
+		return false;
+	}
+	const uint32 Size = ReadValue<uint32>(Buffer, Buffer.Num() - 4);
+	if (Size < SPZ_HEADER_SIZE || Size > uint32(MAX_int32))
+	{
+		PICO_LOGE(".spz has an invalid size.");
+		return false;
+	}
+	Decompressed.SetNumUninitialized(Size);
+	if (!FCompression::UncompressMemory(
+			NAME_Gzip,
+			Decompressed.GetData(),
+			Decompressed.Num(),
+			Buffer.GetData(),
+			Buffer.Num()))
+	{
+		PICO_LOGE("Failed to decompress .spz.");
+		return false;
+	}
+	Data = Decompressed;
+
+	const uint32 Magic = ReadValue<uint32>(Data, 0);
+	SpzVersion = ReadValue<uint32>(Data, 4);
+	const uint32 NumPoints = ReadValue<uint32>(Data, 8);
+	const uint8 StoredSHDegree = Data[12];
+	const uint8 FractionalBits = Data[13];
+	if (Magic != SPZ_MAGIC)
+	{
+		PICO_LOGE("Not a .spz.");
+		return false;
+	}
+	if (SpzVersion < 2 || SpzVersion > 3)
+	{
+		PICO_LOGE("Unsupported .spz version %u.", SpzVersion);
+		return false;
+	}
+	if (StoredSHDegree > 3 || FractionalBits > 24)
+	{
+		PICO_LOGE("Invalid .spz header.");
+		return false;
+	}
+
+	NumStoredSH = GetNumSHCoefficients(StoredSHDegree);
+	SHDegree = FindSHDegree(NumStoredSH);
+	SpzPositionScale = 1.f / float(1 << FractionalBits);
+
+	// Each property is stored for every splat in turn.
+	const int64 RotationSize = SpzVersion >= 3 ? 4 : 3;
+	SpzPositions = SPZ_HEADER_SIZE;
+	SpzAlphas = SpzPositions + int64(NumPoints) * 9;
+	SpzColors = SpzAlphas + NumPoints;
+	SpzScales = SpzColors + int64(NumPoints) * 3;
+	SpzRotations = SpzScales + int64(NumPoints) * 3;
+	SpzSH = SpzRotations + int64(NumPoints) * RotationSize;
+	const int64 End = SpzSH + int64(NumPoints) * 3 * NumStoredSH;
+	if (NumPoints == 0 || End > Data.Num())
+	{
+		PICO_LOGE(".spz has no splats, or is truncated.");
+		return false;
+	}
+
+	NumSplats = NumPoints;
+	return true;
+}
+
+bool FCompactSplatReader::ParseSplat(TConstArrayView<uint8> Buffer)
+{
+	if (Buffer.Num() == 0 || Buffer.Num() % SPLAT_STRIDE != 0)
+	{
+		PICO_LOGE(".splat has no splats, or is truncated.");
+		return false;
+	}
+
+	Data = Buffer;
+	NumSplats = Buffer.Num() / SPLAT_STRIDE;
+	return true;
+}
+
+bool FCompactSplatReader::ParseCompressedPly(TConstArrayView<uint8> Buffer)
+{
+	FPlyVertexReader ChunkReader;
+	if (!ChunkReader.Parse(Buffer, TEXT("chunk")) ||
+	    !Vertices.Parse(Buffer, TEXT("vertex")))
+	{
+		return false;
+	}
+
+	PackedPosition = Vertices.FindProperty(TEXT("packed_position"));
+	PackedRotation = Vertices.FindProperty(TEXT("packed_rotation"));
+	PackedScale = Vertices.FindProperty(TEXT("packed_scale"));
+	PackedColor = Vertices.FindProperty(TEXT("packed_color"));
+	if (PackedPosition == INDEX_NONE || PackedRotation == INDEX_NONE ||
+	    PackedScale == INDEX_NONE || PackedColor == INDEX_NONE)
+	{
+		PICO_LOGE("Compressed .ply is missing packed properties.");
+		return false;
+	}
+
+	NumSplats = Vertices.GetNumVertices();
+	if (ChunkReader.GetNumVertices() <
+	    FMath::DivideAndRoundUp(NumSplats, CHUNK_SIZE))
+	{
+		PICO_LOGE("Compressed .ply has too few chunks.");
+		return false;
+	}
+
+	// Properties of the bounds of each chunk, as min X, Y, Z, then max.
+	using FBoundsProperties = TArray<int32, TFixedAllocator<6>>;
+	auto FindBounds = [&ChunkReader](const TCHAR* Infix)
+	{
+		FBoundsProperties Properties;
+		for (const TCHAR* Bound : {TEXT("min"), TEXT("max")})
+		{
+			for (const TCHAR* Axis : {TEXT("x"), TEXT("y"), TEXT("z")})
+			{
+				Properties.Add(ChunkReader.FindProperty(
+					FString::Printf(TEXT("%s%s%s"), Bound, Infix, Axis)));
+			}
+		}
+		return Properties;
+	};
+	const FBoundsProperties PositionBounds = FindBounds(TEXT("_"));
+	const FBoundsProperties ScaleBounds = FindBounds(TEXT("_scale_"));
+	if (PositionBounds.Contains(INDEX_NONE) ||
+	    ScaleBounds.Contains(INDEX_NONE))
+	{
+		PICO_LOGE("Compressed .ply is missing chunk bounds.");
+		return false;
+	}
+	// Bounds of colors are optional.
+	FBoundsProperties ColorBounds;
+	for (const TCHAR* Name :
+	     {TEXT("min_r"),
+	      TEXT("min_g"),
+	      TEXT("min_b"),
+	      TEXT("max_r"),
+	      TEXT("max_g"),
+	      TEXT("max_b")})
+	{
+		ColorBounds.Add(ChunkReader.FindProperty(Name));
+	}
+
+	Chunks.SetNumUninitialized(ChunkReader.GetNumVertices());
+	for (int32 Index = 0; Index < Chunks.Num(); ++Index)
+	{
+		auto ReadBox = [&ChunkReader, Index](TConstArrayView<int32> Properties)
+		{
+			return FBox3f(
+				FVector3f(
+					ChunkReader.Read(Index, Properties[0]),
+					ChunkReader.Read(Index, Properties[1]),
+					ChunkReader.Read(Index, Properties[2])),
+				FVector3f(
+					ChunkReader.Read(Index, Properties[3]),
+					ChunkReader.Read(Index, Properties[4]),
+					ChunkReader.Read(Index, Properties[5])));
+		};
+		FChunk& Chunk = Chunks[Index];
+		Chunk.Positions = ReadBox(PositionBounds);
+		Chunk.Scales = ReadBox(ScaleBounds);
+		Chunk.Colors = ColorBounds.Contains(INDEX_NONE)
+		                   ? FBox3f(FVector3f(0.f), FVector3f(1.f))
+		                   : ReadBox(ColorBounds);
+	}
+
+	// Spherical harmonics are an optional element of their own.
+	if (HasPlyElement(Buffer, "sh") && SH.Parse(Buffer, TEXT("sh")) &&
+	    SH.GetNumVertices() == NumSplats)
+	{
+		while (true)
+		{
+			const int32 Property = SH.FindProperty(
+				FString::Printf(TEXT("f_rest_%d"), SHProperties.Num()));
+			if (Property == INDEX_NONE)
+			{
+				break;
+			}
+			SHProperties.Add(Property);
+		}
+		NumStoredSH = SHProperties.Num() / 3;
+		SHDegree = FindSHDegree(NumStoredSH);
+	}
+
+	return true;
+}
+
+void FCompactSplatReader::Read(int32 Index, FPlySplat& OutSplat) const
+{
+	check(Index >= 0 && Index < NumSplats);
+	switch (Format)
+	{
+	case EFormat::Spz:
+		ReadSpz(Index, OutSplat);
+		return;
+	case EFormat::Splat:
+		ReadSplat(Index, OutSplat);
+		return;
+	case EFormat::CompressedPly:
+		ReadCompressedPly(Index, OutSplat);
+		return;
+	}
+	checkNoEntry();
+}
+
+void FCompactSplatReader::ReadSpz(int32 Index, FPlySplat& OutSplat) const
+{
+	// `.spz`s are right-handed, with Y up and Z back, whereas `.ply`s have Y
+	// down and Z forward, i.e. are rotated 180 degrees about X.
+	const FVector3f Position = ReadSourcePosition(Index);
+	OutSplat.Position = FVector3f(Position.X, -Position.Y, -Position.Z);
+
+	OutSplat.Opacity = Logit(Data[SpzAlphas + Index] / 255.f);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const uint8 Color = Data[SpzColors + int64(Index) * 3 + Axis];
+		OutSplat.ColorDC[Axis] = (Color / 255.f - 0.5f) / SPZ_COLOR_SCALE;
+		const uint8 Scale = Data[SpzScales + int64(Index) * 3 + Axis];
+		OutSplat.LogScale[Axis] = Scale / 16.f - 10.f;
+	}
+
+	// Rotations are stored as X, Y, Z, W.
+	float Rotation[4];
+	if (SpzVersion >= 3)
+	{
+		// The largest component is dropped, and the rest stored as 9-bit
+		// magnitudes and signs.
+		constexpr uint32 MAGNITUDE_MASK = (1u << 9) - 1;
+		uint32 Packed =
+			ReadValue<uint32>(Data, SpzRotations + int64(Index) * 4);
+		const int32 Largest = Packed >> 30;
+		float SumSquared = 0.f;
+		for (int32 Component = 3; Component >= 0; --Component)
+		{
+			if (Component == Largest)
+			{
+				continue;
+			}
+			const float Magnitude = UE_INV_SQRT_2 *
+			                        float(Packed & MAGNITUDE_MASK) /
+			                        MAGNITUDE_MASK;
+			Rotation[Component] = (Packed >> 9) & 1 ? -Magnitude : Magnitude;
+			SumSquared += Magnitude * Magnitude;
+			Packed >>= 10;
+		}
+		Rotation[Largest] = FMath::Sqrt(FMath::Max(0.f, 1.f - SumSquared));
+	}
+	else
+	{
+		// W is dropped, being positive.
+		float SumSquared = 0.f;
+		for (int32 Component = 0; Component < 3; ++Component)
+		{
+			Rotation[Component] =
+				Data[SpzRotations + int64(Index) * 3 + Component] / 127.5f -
+				1.f;
+			SumSquared += Rotation[Component] * Rotation[Component];
+		}
+		Rotation[3] = FMath::Sqrt(FMath::Max(0.f, 1.f - SumSquared));
+	}
+	OutSplat.Rotation[0] = Rotation[3];
+	OutSplat.Rotation[1] = Rotation[0];
+	OutSplat.Rotation[2] = -Rotation[1];
+	OutSplat.Rotation[3] = -Rotation[2];
+}
+
+void FCompactSplatReader::ReadSplat(int32 Index, FPlySplat& OutSplat) const
+{
+	const int64 Offset = int64(Index) * SPLAT_STRIDE;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		OutSplat.Position[Axis] =
+			ReadValue<float>(Data, Offset + Axis * sizeof(float));
+		OutSplat.LogScale[Axis] = FMath::Loge(FMath::Max(
+			ReadValue<float>(Data, Offset + (3 + Axis) * sizeof(float)),
+			UE_SMALL_NUMBER));
+	}
+
+	const uint8* Color = &Data[Offset + 24];
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		OutSplat.ColorDC[Axis] = (Color[Axis] / 255.f - 0.5f) / SH_C0;
+	}
+	OutSplat.Opacity = Logit(Color[3] / 255.f);
+
+	// Rotations are stored as W, X, Y, Z.
+	const uint8* Rotation = &Data[Offset + 28];
+	for (int32 Component = 0; Component < 4; ++Component)
+	{
+		OutSplat.Rotation[Component] = (Rotation[Component] - 128.f) / 128.f;
+	}
+}
+
+void FCompactSplatReader::ReadCompressedPly(
+	int32 Index, FPlySplat& OutSplat) const
+{
+	const FChunk& Chunk = Chunks[Index / CHUNK_SIZE];
+	OutSplat.Position = Unpack111011(
+		Vertices.ReadUInt(Index, PackedPosition), Chunk.Positions);
+	OutSplat.LogScale =
+		Unpack111011(Vertices.ReadUInt(Index, PackedScale), Chunk.Scales);
+
+	const uint32 Color = Vertices.ReadUInt(Index, PackedColor);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const float Alpha = UnpackUnorm(Color, 24 - 8 * Axis, 8);
+		const float Value = FMath::Lerp(
+			Chunk.Colors.Min[Axis], Chunk.Colors.Max[Axis], Alpha);
+		OutSplat.ColorDC[Axis] = (Value - 0.5f) / SH_C0;
+	}
+	OutSplat.Opacity = Logit(UnpackUnorm(Color, 0, 8));
+
+	// The largest component is dropped, and the rest stored as 10 bits in
+	// [-1/sqrt(2), 1/sqrt(2)]. Components are ordered X, Y, Z, W, as packed
+	// by `packRot` in SuperSplat's `splat-serialize.ts` from `rot_1`, `rot_2`,
+	// `rot_3` and `rot_0`, and unpacked by `unpackRotation` in PlayCanvas's
+	// compressed splat shader, so are rotated into W, X, Y, Z.
+	const uint32 Rotation = Vertices.ReadUInt(Index, PackedRotation);
+	const int32 Largest = Rotation >> 30;
+	float SumSquared = 0.f;
+	int32 Shift = 20;
+	for (int32 Component = 0; Component < 4; ++Component)
+	{
+		if (Component == Largest)
+		{
+			continue;
+		}
+		const float Value =
+			(UnpackUnorm(Rotation, Shift, 10) - 0.5f) * UE_SQRT_2;
+		OutSplat.Rotation[(Component + 1) % 4] = Value;
+		SumSquared += Value * Value;
+		Shift -= 10;
+	}
+	OutSplat.Rotation[(Largest + 1) % 4] =
+		FMath::Sqrt(FMath::Max(0.f, 1.f - SumSquared));
+}
+
+void FCompactSplatReader::ReadSH(int32 Index, float* OutCoefficients) const
+{
+	check(SHDegree > 0);
+	check(Index >= 0 && Index < NumSplats);
+	const int32 NumCoefficients = GetNumSHCoefficients(SHDegree);
+	switch (Format)
+	{
+	case EFormat::Spz:
+	{
+		// Stored by coefficient then channel.
+		const uint8* Stored = &Data[SpzSH + int64(Index) * 3 * NumStoredSH];
+		for (int32 Coefficient = 0; Coefficient < 3 * NumCoefficients;
+		     ++Coefficient)
+		{
+			OutCoefficients[Coefficient] =
+				(Stored[Coefficient] - 128.f) / 128.f;
+		}
+		return;
+	}
+	case EFormat::CompressedPly:
+	{
+		// Stored by channel then coefficient.
+		for (int32 Coefficient = 0; Coefficient < NumCoefficients;
+		     ++Coefficient)
+		{
+			for (int32 Channel = 0; Channel < 3; ++Channel)
+			{
+				const int32 Property =
+					SHProperties[Channel * NumStoredSH + Coefficient];
+				const float Stored = SH.Read(Index, Property);
+				*OutCoefficients++ = ((Stored + 0.5f) / 256.f - 0.5f) * 8.f;
+			}
+		}
+		return;
+	}
+	case EFormat::Splat:
+		break;
+	}
+	checkNoEntry();
+}
+
+FVector3f FCompactSplatReader::ReadSourcePosition(int32 Index) const
+{
+	check(Index >= 0 && Index < NumSplats);
+	if (Format != EFormat::Spz)
+	{
+		FPlySplat Splat;
+		Read(Index, Splat);
+		return Splat.Position;
+	}
+
+	// 24-bit signed fixed point.
+	const uint8* Stored = &Data[SpzPositions + int64(Index) * 9];
+	FVector3f Position;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		int32 Fixed = Stored[Axis * 3] | (Stored[Axis * 3 + 1] << 8) |
+		              (Stored[Axis * 3 + 2] << 16);
+		if (Fixed & 0x800000)
+		{
+			Fixed |= int32(0xff000000);
+		}
+		Position[Axis] = Fixed * SpzPositionScale;
+	}
+	return Position;
+}
+
+} // namespace PICO::Splat
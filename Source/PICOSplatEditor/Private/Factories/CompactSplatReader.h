@@ -0,0 +1,173 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <string_view>
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/Box.h"
+#include "Math/Vector.h"
+#include "PlyVertexReader.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * A splat with the properties of a 3DGS `.ply`, for the third-party converter.
+ */
+struct FPlySplat
+{
+	FVector3f Position = FVector3f::ZeroVector;
+	// Natural logarithm of the scale, at one standard deviation.
+	FVector3f LogScale = FVector3f::ZeroVector;
+	// Rotation as `rot_0` to `rot_3`, i.e. W, X, Y, Z. Need not be normalized.
+	float Rotation[4] = {1.f, 0.f, 0.f, 0.f};
+	// Logit of the opacity.
+	float Opacity = 0.f;
+	// Base color, as the coefficient of the 0th degree spherical harmonic.
+	FVector3f ColorDC = FVector3f::ZeroVector;
+
+	/**
+	 * Gets a property by its `.ply` name.
+	 *
+	 * @param Name - Name of the property (e.g. `scale_0`).
+	 * @return The value, or 0 if not a property above.
+	 */
+	float GetProperty(std::string_view Name) const;
+};
+
+/**
+ * Decodes splats from compact interchange formats, one at a time and in any
+ * order, so they can be decoded in parallel without unpacking the whole file.
+ *
+ * Supports:
+ * - `.spz`: gzipped, with fixed-point positions, and 8-bit everything else.
+ * - `.splat`: 32 bytes per splat, with float positions and scales, and 8-bit
+ *   colors and rotations.
+ * - Compressed `.ply`: positions, scales, rotations and colors packed in 32
+ *   bits each, relative to the bounds of chunks of 256 splats, and optional
+ *   8-bit spherical harmonics.
+ */
+class FCompactSplatReader
+{
+public:
+	enum class EFormat : uint8
+	{
+		Spz,
+		Splat,
+		CompressedPly
+	};
+
+	/**
+	 * Finds the compact format of a file, if it is one.
+	 *
+	 * @param Extension - Extension of the file, without the dot.
+	 * @param Buffer - The whole file, or at least its header.
+	 * @param OutFormat - Returns the format.
+	 * @return False, if the file is not in a compact format.
+	 */
+	static bool FindFormat(
+		const FString& Extension,
+		TConstArrayView<uint8> Buffer,
+		EFormat& OutFormat);
+
+	/**
+	 * Parses a file. The buffer *must* outlive this reader.
+	 *
+	 * @param Buffer - The whole file.
+	 * @param InFormat - Format of the file.
+	 * @return True, if splats can be read.
+	 */
+	bool Parse(TConstArrayView<uint8> Buffer, EFormat InFormat);
+
+	/**
+	 * @return The number of splats.
+	 */
+	int32 Num() const { return NumSplats; }
+
+	/**
+	 * @return Degree of higher-order spherical harmonics, or 0 if there are
+	 * none.
+	 */
+	uint32 GetSHDegree() const { return SHDegree; }
+
+	/**
+	 * Decodes a splat.
+	 *
+	 * @param Index - Index of the splat, in [0, `Num()`).
+	 * @param OutSplat - Returns the splat, in the axes of a 3DGS `.ply`.
+	 */
+	void Read(int32 Index, FPlySplat& OutSplat) const;
+
+	/**
+	 * Decodes the higher-order spherical harmonics of a splat, in the axes of
+	 * the source. *Must* only be called if `GetSHDegree()` is above 0.
+	 *
+	 * @param Index - Index of the splat, in [0, `Num()`).
+	 * @param OutCoefficients - Returns `3 * GetNumSHCoefficients(
+	 * GetSHDegree())` coefficients, ordered by coefficient then channel.
+	 */
+	void ReadSH(int32 Index, float* OutCoefficients) const;
+
+	/**
+	 * Decodes the position of a splat, in the axes of the source, in which
+	 * spherical harmonics are evaluated.
+	 *
+	 * @param Index - Index of the splat, in [0, `Num()`).
+	 * @return The position.
+	 */
+	FVector3f ReadSourcePosition(int32 Index) const;
+
+private:
+	// Bounds of a chunk of a compressed `.ply`.
+	struct FChunk
+	{
+		FBox3f Positions;
+		// Bounds of the logarithm of scales.
+		FBox3f Scales;
+		// Bounds of base colors, in [0, 1], or [0, 1] if not stored.
+		FBox3f Colors;
+	};
+
+	bool ParseSpz(TConstArrayView<uint8> Buffer);
+	bool ParseSplat(TConstArrayView<uint8> Buffer);
+	bool ParseCompressedPly(TConstArrayView<uint8> Buffer);
+
+	void ReadSpz(int32 Index, FPlySplat& OutSplat) const;
+	void ReadSplat(int32 Index, FPlySplat& OutSplat) const;
+	void ReadCompressedPly(int32 Index, FPlySplat& OutSplat) const;
+
+	EFormat Format = EFormat::Splat;
+	int32 NumSplats = 0;
+	uint32 SHDegree = 0;
+	// Coefficients per channel stored, which may be more than used.
+	int32 NumStoredSH = 0;
+
+	// Splats of a `.splat`, or the decompressed contents of a `.spz`.
+	TConstArrayView<uint8> Data;
+	TArray<uint8> Decompressed;
+	// Layout of a `.spz`.
+	uint32 SpzVersion = 0;
+	float SpzPositionScale = 1.f;
+	int64 SpzPositions = 0;
+	int64 SpzAlphas = 0;
+	int64 SpzColors = 0;
+	int64 SpzScales = 0;
+	int64 SpzRotations = 0;
+	int64 SpzSH = 0;
+
+	// Elements of a compressed `.ply`.
+	FPlyVertexReader Vertices;
+	FPlyVertexReader SH;
+	TArray<FChunk> Chunks;
+	int32 PackedPosition = INDEX_NONE;
+	int32 PackedRotation = INDEX_NONE;
+	int32 PackedScale = INDEX_NONE;
+	int32 PackedColor = INDEX_NONE;
+	TArray<int32> SHProperties;
+};
+
+} // namespace PICO::Splat
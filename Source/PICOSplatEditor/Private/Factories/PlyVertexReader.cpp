@@ -0,0 +1,327 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "PlyVertexReader.h"
+
+#include "Logging.h"
+#include "Misc/AssertionMacros.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+/**
+ * Gets the next line of a `.ply` header, without its line ending.
+ *
+ * @param Buffer - The start of the file.
+ * @param InOutOffset - Offset of the line, in bytes. Returns the offset of the
+ * next line.
+ * @param OutLine - Returns the line.
+ * @return False, if the buffer ends before the line does.
+ */
+bool ReadLine(
+	TConstArrayView<uint8> Buffer, int32& InOutOffset, FString& OutLine)
+{
+	const int32 Begin = InOutOffset;
+	while (InOutOffset < Buffer.Num() && Buffer[InOutOffset] != '\n')
+	{
+		++InOutOffset;
+	}
+	if (InOutOffset == Buffer.Num())
+	{
+		return false;
+	}
+
+	int32 End = InOutOffset++;
+	if (End > Begin && Buffer[End - 1] == '\r')
+	{
+		--End;
+	}
+	OutLine = FString::ConstructFromPtrSize(
+		reinterpret_cast<const ANSICHAR*>(&Buffer[Begin]), End - Begin);
+	return true;
+}
+} // namespace
+
+bool FPlyVertexReader::Parse(
+	TConstArrayView<uint8> Buffer, const FString& Element)
+{
+	if (!ParseHeader(Buffer, Buffer.Num(), Element))
+	{
+		return false;
+	}
+
+	SetWindow(&Buffer[DataOffset], 0, NumVertices);
+	return true;
+}
+
+bool FPlyVertexReader::ParseHeader(
+	TConstArrayView<uint8> Buffer, int64 FileSize, const FString& Element)
+{
+	static const TMap<FString, EType> TYPES = {
+		{TEXT("char"), EType::Int8},
+		{TEXT("int8"), EType::Int8},
+		{TEXT("uchar"), EType::UInt8},
+		{TEXT("uint8"), EType::UInt8},
+		{TEXT("short"), EType::Int16},
+		{TEXT("int16"), EType::Int16},
+		{TEXT("ushort"), EType::UInt16},
+		{TEXT("uint16"), EType::UInt16},
+		{TEXT("int"), EType::Int32},
+		{TEXT("int32"), EType::Int32},
+		{TEXT("uint"), EType::UInt32},
+		{TEXT("uint32"), EType::UInt32},
+		{TEXT("float"), EType::Float32},
+		{TEXT("float32"), EType::Float32},
+		{TEXT("double"), EType::Float64},
+		{TEXT("float64"), EType::Float64}};
+	static const int32 SIZES[] = {1, 1, 2, 2, 4, 4, 4, 8};
+
+	Properties.Reset();
+	DataOffset = 0;
+	Stride = 0;
+	NumVertices = 0;
+	Data = nullptr;
+	FirstVertex = 0;
+	NumWindowVertices = 0;
+
+	int32 Offset = 0;
+	FString Line;
+	if (!ReadLine(Buffer, Offset, Line) || Line != TEXT("ply"))
+	{
+		PICO_LOGE("Missing .ply magic number.");
+		return false;
+	}
+
+	// Only properties of the element read are kept. Elements before it are
+	// skipped over, so *must* have no list properties.
+	enum class EState : uint8
+	{
+		Before,
+		Reading,
+		After
+	};
+	EState State = EState::Before;
+	int64 SkippedSize = 0;
+	int64 NumSkipped = 0;
+	int64 SkippedStride = 0;
+	bool bSkippedList = false;
+	auto SkipElement = [&]()
+	{
+		if (bSkippedList && NumSkipped > 0)
+		{
+			PICO_LOGE("Unsupported .ply element before %s.", *Element);
+			return false;
+		}
+		SkippedSize += NumSkipped * SkippedStride;
+		NumSkipped = 0;
+		SkippedStride = 0;
+		bSkippedList = false;
+		return true;
+	};
+
+	while (true)
+	{
+		if (!ReadLine(Buffer, Offset, Line))
+		{
+			PICO_LOGE("Unterminated .ply header.");
+			return false;
+		}
+
+		TArray<FString> Tokens;
+		Line.ParseIntoArrayWS(Tokens);
+		if (Tokens.IsEmpty() || Tokens[0] == TEXT("comment") ||
+		    Tokens[0] == TEXT("obj_info"))
+		{
+			continue;
+		}
+
+		if (Tokens[0] == TEXT("end_header"))
+		{
+			break;
+		}
+		else if (Tokens[0] == TEXT("format"))
+		{
+			if (Tokens.Num() < 2 || Tokens[1] != TEXT("binary_little_endian"))
+			{
+				PICO_LOGE("Unsupported .ply format: %s", *Line);
+				return false;
+			}
+		}
+		else if (Tokens[0] == TEXT("element"))
+		{
+			if (Tokens.Num() < 3)
+			{
+				PICO_LOGE("Invalid .ply element: %s", *Line);
+				return false;
+			}
+			if (State == EState::Before)
+			{
+				if (!SkipElement())
+				{
+					return false;
+				}
+				if (Tokens[1] == Element)
+				{
+					State = EState::Reading;
+					NumVertices = FCString::Atoi(*Tokens[2]);
+				}
+				else
+				{
+					NumSkipped = FCString::Atoi64(*Tokens[2]);
+				}
+			}
+			else
+			{
+				State = EState::After;
+			}
+		}
+		else if (Tokens[0] == TEXT("property") && State == EState::Reading)
+		{
+			const EType* Type = Tokens.Num() == 3 ? TYPES.Find(Tokens[1])
+			                                      : nullptr;
+			if (!Type)
+			{
+				PICO_LOGE("Unsupported .ply property: %s", *Line);
+				return false;
+			}
+			Properties.Add({Tokens[2], *Type, Stride});
+			Stride += SIZES[uint8(*Type)];
+		}
+		else if (Tokens[0] == TEXT("property") && State == EState::Before)
+		{
+			const EType* Type = Tokens.Num() == 3 ? TYPES.Find(Tokens[1])
+			                                      : nullptr;
+			if (Type)
+			{
+				SkippedStride += SIZES[uint8(*Type)];
+			}
+			else
+			{
+				bSkippedList = true;
+			}
+		}
+	}
+
+	if (NumVertices <= 0 || Stride == 0)
+	{
+		PICO_LOGE("No %s elements in .ply.", *Element);
+		return false;
+	}
+	DataOffset = Offset + SkippedSize;
+	if (FileSize - DataOffset < int64(NumVertices) * Stride)
+	{
+		PICO_LOGE("Truncated .ply %s data.", *Element);
+		return false;
+	}
+
+	return true;
+}
+
+void FPlyVertexReader::SetWindow(
+	const uint8* InData, int32 InFirstVertex, int32 InNumWindowVertices)
+{
+	check(InData);
+	check(InFirstVertex >= 0 && InNumWindowVertices >= 0);
+	check(int64(InFirstVertex) + InNumWindowVertices <= NumVertices);
+
+	Data = InData;
+	FirstVertex = InFirstVertex;
+	NumWindowVertices = InNumWindowVertices;
+}
+
+int32 FPlyVertexReader::FindProperty(const FString& Name) const
+{
+	return Properties.IndexOfByPredicate([&Name](const FProperty& Property)
+	                                     { return Property.Name == Name; });
+}
+
+float FPlyVertexReader::Read(int32 Vertex, int32 Property) const
+{
+	check(Data);
+	check(Vertex >= FirstVertex && Vertex - FirstVertex < NumWindowVertices);
+	check(Properties.IsValidIndex(Property));
+
+	const FProperty& Info = Properties[Property];
+	const uint8* Value =
+		Data + int64(Vertex - FirstVertex) * Stride + Info.Offset;
+	switch (Info.Type)
+	{
+	case EType::Int8:
+		return float(*reinterpret_cast<const int8*>(Value));
+	case EType::UInt8:
+		return float(*Value);
+	case EType::Int16:
+	{
+		int16 Result;
+		FMemory::Memcpy(&Result, Value, sizeof(Result));
+		return float(Result);
+	}
+	case EType::UInt16:
+	{
+		uint16 Result;
+		FMemory::Memcpy(&Result, Value, sizeof(Result));
+		return float(Result);
+	}
+	case EType::Int32:
+	{
+		int32 Result;
+		FMemory::Memcpy(&Result, Value, sizeof(Result));
+		return float(Result);
+	}
+	case EType::UInt32:
+	{
+		uint32 Result;
+		FMemory::Memcpy(&Result, Value, sizeof(Result));
+		return float(Result);
+	}
+	case EType::Float32:
+	{
+		float Result;
+		FMemory::Memcpy(&Result, Value, sizeof(Result));
+		return Result;
+	}
+	case EType::Float64:
+	{
+		double Result;
+		FMemory::Memcpy(&Result, Value, sizeof(Result));
+		return float(Result);
+	}
+	}
+	checkNoEntry();
+	return 0.f;
+}
+
+uint32 FPlyVertexReader::ReadUInt(int32 Vertex, int32 Property) const
+{
+	check(Data);
+	check(Vertex >= FirstVertex && Vertex - FirstVertex < NumWindowVertices);
+	check(Properties.IsValidIndex(Property));
+
+	const FProperty& Info = Properties[Property];
+	const uint8* Value =
+		Data + int64(Vertex - FirstVertex) * Stride + Info.Offset;
+	switch (Info.Type)
+	{
+	case EType::UInt8:
+		return *Value;
+	case EType::UInt16:
+	{
+		uint16 Result;
+		FMemory::Memcpy(&Result, Value, sizeof(Result));
+		return Result;
+	}
+	case EType::UInt32:
+	{
+		uint32 Result;
+		FMemory::Memcpy(&Result, Value, sizeof(Result));
+		return Result;
+	}
+	default:
+		checkNoEntry();
+		return 0;
+	}
+}
+
+} // namespace PICO::Splat
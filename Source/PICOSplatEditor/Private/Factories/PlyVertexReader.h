@@ -0,0 +1,153 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/UnrealString.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Reads arbitrary per-vertex properties from a binary little-endian `.ply`.
+ *
+ * The third-party parser only converts the properties every splat has, so this
+ * gives access to the rest (e.g. higher-order spherical harmonics). Other
+ * elements can be read in place of vertices (e.g. the chunks of compressed
+ * `.ply`s), with each instance read as a vertex. The element read, and those
+ * before it, *must* have no list properties.
+ *
+ * Vertices are either read from the whole file, or from a window of it at a
+ * time, for files too large to load at once.
+ */
+class FPlyVertexReader
+{
+public:
+	/**
+	 * Parses the header of a `.ply`. The buffer *must* outlive this reader.
+	 *
+	 * @param Buffer - The whole file.
+	 * @param Element - Name of the element to read.
+	 * @return True, if vertices can be read.
+	 */
+	bool Parse(
+		TConstArrayView<uint8> Buffer, const FString& Element = TEXT("vertex"));
+
+	/**
+	 * Parses only the header of a `.ply`, to read vertices a window at a time
+	 * with `SetWindow`.
+	 *
+	 * @param Buffer - The start of the file, holding at least the header.
+	 * @param FileSize - Size of the whole file, in bytes.
+	 * @param Element - Name of the element to read.
+	 * @return True, if vertices can be read.
+	 */
+	bool ParseHeader(
+		TConstArrayView<uint8> Buffer,
+		int64 FileSize,
+		const FString& Element = TEXT("vertex"));
+
+	/**
+	 * Sets the vertices which can be read. The window *must* outlive its use.
+	 *
+	 * @param InData - Data of the first vertex of the window.
+	 * @param InFirstVertex - Index of the first vertex of the window.
+	 * @param InNumWindowVertices - Number of vertices in the window.
+	 */
+	void SetWindow(
+		const uint8* InData, int32 InFirstVertex, int32 InNumWindowVertices);
+
+	/**
+	 * @return Offset of the first vertex in the file, in bytes.
+	 */
+	int64 GetDataOffset() const { return DataOffset; }
+
+	/**
+	 * @return Size of each vertex, in bytes.
+	 */
+	int32 GetStride() const { return Stride; }
+
+	/**
+	 * @return The number of vertices.
+	 */
+	int32 GetNumVertices() const { return NumVertices; }
+
+	/**
+	 * @return The number of properties of each vertex.
+	 */
+	int32 GetNumProperties() const { return Properties.Num(); }
+
+	/**
+	 * @param Property - Index of the property, in [0, `GetNumProperties()`).
+	 * @return Name of the property, as in the header.
+	 */
+	const FString& GetPropertyName(int32 Property) const
+	{
+		return Properties[Property].Name;
+	}
+
+	/**
+	 * Finds a property by name.
+	 *
+	 * @param Name - Name of the property, as in the header.
+	 * @return Index of the property, or `INDEX_NONE` if absent.
+	 */
+	int32 FindProperty(const FString& Name) const;
+
+	/**
+	 * Reads a property of a vertex, converted to a float.
+	 *
+	 * @param Vertex - Index of the vertex, in [0, `GetNumVertices()`), and in
+	 * the window if one is set.
+	 * @param Property - Index of the property, from `FindProperty`.
+	 * @return The value.
+	 */
+	float Read(int32 Vertex, int32 Property) const;
+
+	/**
+	 * Reads an integer property of a vertex, exactly, as floats only hold 24
+	 * bits (e.g. for packed properties).
+	 *
+	 * @param Vertex - Index of the vertex, as in `Read`.
+	 * @param Property - Index of the property, from `FindProperty`. *Must* be
+	 * an unsigned integer.
+	 * @return The value.
+	 */
+	uint32 ReadUInt(int32 Vertex, int32 Property) const;
+
+private:
+	enum class EType : uint8
+	{
+		Int8,
+		UInt8,
+		Int16,
+		UInt16,
+		Int32,
+		UInt32,
+		Float32,
+		Float64
+	};
+
+	struct FProperty
+	{
+		FString Name;
+		EType Type;
+		// Offset of the property within each vertex, in bytes.
+		int32 Offset;
+	};
+
+	TArray<FProperty> Properties;
+	int64 DataOffset = 0;
+	// Size of each vertex, in bytes.
+	int32 Stride = 0;
+	int32 NumVertices = 0;
+	// Vertices which can be read, from the first vertex of the window.
+	const uint8* Data = nullptr;
+	int32 FirstVertex = 0;
+	int32 NumWindowVertices = 0;
+};
+
+} // namespace PICO::Splat
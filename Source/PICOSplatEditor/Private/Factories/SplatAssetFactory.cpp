@@ -4,10 +4,34 @@
 
 #include "SplatAssetFactory.h"
 
+#include <string>
+#include <string_view>
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Containers/BitArray.h"
 #include "CompGeom/ConvexHull3.h"
+#include "CompactSplatReader.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
 #include "Logging.h"
 #include "Misc/AssertionMacros.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ObjectTools.h"
+#include "PackedTypes.h"
+#include "PlyVertexReader.h"
+#include "SplatChunkedAsset.h"
+#include "SplatChunking.h"
 #include "SplatConstants.h"
+#include "SplatImportance.h"
+#include "SplatLOD.h"
+#include "SplatPartition.h"
+#include "SplatPruning.h"
+#include "SplatSpatialOrder.h"
 #include "import/ply/splat_ply_conversion.h"
 #include "import/ply/splat_ply_parsing.h"
 
@@ -16,40 +40,124 @@ using import::GetPropertyFn;
 using import::Metadata;
 using import::ParseSplatFn;
 using import::ply::SplatParserPly;
+using PICO::Splat::FCompactSplatReader;
+using PICO::Splat::FImportedSplats;
+using PICO::Splat::FPackedPos;
+using PICO::Splat::FPlySplat;
+using PICO::Splat::FPlyVertexReader;
+using PICO::Splat::FSplatCluster;
+using PICO::Splat::FSplatLODNode;
+using PICO::Splat::FSplatPartitioner;
+using PICO::Splat::FSplatPruningOptions;
+using PICO::Splat::FSplatPruningStats;
+using PICO::Splat::BuildSplatLOD;
+using PICO::Splat::GetNumSHCoefficients;
+using PICO::Splat::MaxSupportedSHDegree;
 using PICO::Splat::MetersToCentimeters;
+using PICO::Splat::OrderSplatsByImportance;
+using PICO::Splat::PruneSplats;
+using PICO::Splat::SortSplatsAlongCurve;
+using PICO::Splat::SplitSplatsIntoChunks;
 
 namespace
 {
-void MaybeAddIndex(TMap<uint32, uint32>& IndexMap, uint32 Index)
+// Splats parsed, or built, at once.
+constexpr int32 WINDOW_SIZE = 256 * 1024;
+// Splats per spatial cluster, when streaming.
+constexpr int32 CLUSTER_SIZE = 64 * 1024;
+// Work of each stage of building an asset, relative to those of importing.
+constexpr float LOD_WORK = 1.f;
+constexpr float BUILD_WORK = 2.f;
+constexpr float HULL_WORK = 1.f;
+
+/**
+ * Reduces positions to candidates for their convex hull: the corners of the
+ * bounds of each column of a grid over them, along Z. Every position is in the
+ * bounds of its column, so the hull of the candidates contains them all, and
+ * is at most about a column wider than their exact hull.
+ *
+ * @param Positions - Positions, in meters.
+ * @param Opacities - Opacity of each position.
+ * @param MinOpacity - Positions less opaque than this are left out.
+ * @param OutCandidates - Returns the candidates, in meters.
+ */
+void FindHullCandidates(
+	TConstArrayView<FVector3f> Positions,
+	TConstArrayView<uint8> Opacities,
+	uint8 MinOpacity,
+	TArray<FVector3f>& OutCandidates)
 {
-	if (!IndexMap.Contains(Index))
+	constexpr int32 GRID_SIZE = 64;
+
+	FBox3f Bounds(ForceInit);
+	for (int32 Index = 0; Index < Positions.Num(); ++Index)
 	{
-		IndexMap.Add(Index, IndexMap.Num());
+		if (Opacities[Index] >= MinOpacity)
+		{
+			Bounds += Positions[Index];
+		}
+	}
+	OutCandidates.Reset();
+	if (!Bounds.IsValid)
+	{
+		return;
 	}
-}
-
-TMap<uint32, uint32>
-RemapIndices(TConstArrayView<UE::Geometry::FIndex3i> Indices)
-{
-	TMap<uint32, uint32> IndexMap{};
 
-	for (const auto& Index3 : Indices)
+	const FVector3f Extent = Bounds.GetSize().ComponentMax(
+		FVector3f(UE_KINDA_SMALL_NUMBER));
+	TArray<FBox3f> Columns;
+	Columns.Init(FBox3f(ForceInit), GRID_SIZE * GRID_SIZE);
+	for (int32 Index = 0; Index < Positions.Num(); ++Index)
 	{
-		MaybeAddIndex(IndexMap, Index3.A);
-		MaybeAddIndex(IndexMap, Index3.B);
-		MaybeAddIndex(IndexMap, Index3.C);
+		if (Opacities[Index] < MinOpacity)
+		{
+			continue;
+		}
+		const FVector3f Cell =
+			GRID_SIZE * (Positions[Index] - Bounds.Min) / Extent;
+		const int32 X = FMath::Clamp(int32(Cell.X), 0, GRID_SIZE - 1);
+		const int32 Y = FMath::Clamp(int32(Cell.Y), 0, GRID_SIZE - 1);
+		Columns[Y * GRID_SIZE + X] += Positions[Index];
 	}
 
-	return IndexMap;
+	for (const FBox3f& Column : Columns)
+	{
+		if (!Column.IsValid)
+		{
+			continue;
+		}
+		for (int32 Corner = 0; Corner < 8; ++Corner)
+		{
+			OutCandidates.Emplace(
+				Corner & 1 ? Column.Max.X : Column.Min.X,
+				Corner & 2 ? Column.Max.Y : Column.Min.Y,
+				Corner & 4 ? Column.Max.Z : Column.Min.Z);
+		}
+	}
 }
 
+/**
+ * Generates a convex hull containing splats, for collision and bounds.
+ *
+ * @param Positions - Positions of the splats, in meters.
+ * @param Opacities - Opacity of each splat.
+ * @param MinOpacity - Splats less opaque than this may be outside the hull.
+ * @param OutVertices - Returns the vertices of the hull, in centimeters.
+ * @param OutIndices - Returns the triangles of the hull.
+ * @return False, if no hull could be solved for (e.g. the splats are flat).
+ */
 bool GenerateConvexHull(
 	TConstArrayView<FVector3f> Positions,
+	TConstArrayView<uint8> Opacities,
+	uint8 MinOpacity,
 	TArray<FVector3f>& OutVertices,
 	TArray<uint32>& OutIndices)
 {
+	TArray<FVector3f> Candidates;
+	FindHullCandidates(Positions, Opacities, MinOpacity, Candidates);
+
 	UE::Geometry::TConvexHull3<float> ConvexHull{};
-	bool Success = ConvexHull.Solve<FVector3f>(Positions);
+	bool Success = ConvexHull.Solve<FVector3f>(Candidates);
 	if (!Success)
 	{
 		PICO_LOGE("Failed to solve for convex hull.");
@@ -59,26 +167,447 @@ bool GenerateConvexHull(
 	TArray<UE::Geometry::FIndex3i> HullIndices = ConvexHull.MoveTriangles();
 
 	// Convert indices to only reference vertices in hull.
-
-	TMap<uint32, uint32> IndexMap = RemapIndices(HullIndices);
-
+	TArray<int32> Remap;
+	Remap.Init(INDEX_NONE, Candidates.Num());
+	OutVertices.Reset();
 	OutIndices.SetNumUninitialized(HullIndices.Num() * 3);
 	for (int32 Index = 0; Index < HullIndices.Num(); ++Index)
 	{
-		OutIndices[Index * 3 + 0] = IndexMap[HullIndices[Index].A];
-		OutIndices[Index * 3 + 1] = IndexMap[HullIndices[Index].B];
-		OutIndices[Index * 3 + 2] = IndexMap[HullIndices[Index].C];
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			const int32 Candidate = HullIndices[Index][Corner];
+			if (Remap[Candidate] == INDEX_NONE)
+			{
+				Remap[Candidate] = OutVertices.Add(
+					MetersToCentimeters * Candidates[Candidate]);
+			}
+			OutIndices[Index * 3 + Corner] = Remap[Candidate];
+		}
+	}
+
+	PICO_LOGL(
+		"Convex hull has %d vertices, from %d candidates.",
+		OutVertices.Num(),
+		Candidates.Num());
+	return true;
+}
+
+/**
+ * Finds the properties of higher-order spherical harmonics, up to the highest
+ * degree supported. `.ply`s store these per channel, as `f_rest_*`.
+ *
+ * @param Reader - Reader for the `.ply`.
+ * @param OutProperties - Returns the properties, in the order stored.
+ * @return Degree of the spherical harmonics, or 0 if there are none.
+ */
+uint32 FindSHProperties(
+	const FPlyVertexReader& Reader, TArray<int32>& OutProperties)
+{
+	OutProperties.Reset();
+	while (true)
+	{
+		const int32 Property = Reader.FindProperty(
+			FString::Printf(TEXT("f_rest_%d"), OutProperties.Num()));
+		if (Property == INDEX_NONE)
+		{
+			break;
+		}
+		OutProperties.Add(Property);
+	}
+
+	const uint32 NumPerChannel = OutProperties.Num() / 3;
+	uint32 Degree = 0;
+	while (Degree < MaxSupportedSHDegree &&
+	       GetNumSHCoefficients(Degree + 1) <= NumPerChannel)
+	{
+		++Degree;
+	}
+	return Degree;
+}
+
+/**
+ * Reads the higher-order spherical harmonics of a window of splats.
+ *
+ * @param Reader - Reader for the `.ply`, with the window readable.
+ * @param Properties - Properties of the spherical harmonics, from
+ * `FindSHProperties`.
+ * @param Degree - Degree of the spherical harmonics, from `FindSHProperties`.
+ * *Must* be above 0.
+ * @param First - Index of the first splat of the window.
+ * @param Num - Number of splats in the window.
+ * @param OutCoefficients - Returns the coefficients of each splat of the
+ * window, ordered by coefficient then channel.
+ */
+void ReadSphericalHarmonics(
+	const FPlyVertexReader& Reader,
+	TConstArrayView<int32> Properties,
+	uint32 Degree,
+	int32 First,
+	int32 Num,
+	TArray<float>& OutCoefficients)
+{
+	check(Degree > 0);
+	const uint32 NumPerChannel = Properties.Num() / 3;
+	const uint32 NumCoefficients = GetNumSHCoefficients(Degree);
+	OutCoefficients.SetNumUninitialized(Num * 3 * NumCoefficients);
+	ParallelFor(
+		Num,
+		[&](int32 Offset)
+		{
+			float* Out = &OutCoefficients[Offset * 3 * NumCoefficients];
+			for (uint32 Coefficient = 0; Coefficient < NumCoefficients;
+			     ++Coefficient)
+			{
+				for (uint32 Channel = 0; Channel < 3; ++Channel)
+				{
+					const int32 Property =
+						Properties[Channel * NumPerChannel + Coefficient];
+					*Out++ = Reader.Read(First + Offset, Property);
+				}
+			}
+		});
+}
+
+/**
+ * Finds how local axes map to the axes of a source file, in which spherical
+ * harmonics are evaluated. Conversion may swap and flip axes, so each local
+ * axis is matched to the source axis it correlates with most.
+ *
+ * @param GetSourcePosition - Gets the position of a splat, as in the source.
+ * @param Positions - Converted positions of the first splats.
+ * @param OutLocalToSH - Returns the matrix from local directions to source
+ * directions, as row vectors.
+ * @return False, if axes could not be matched.
+ */
+bool FindLocalToSH(
+	TFunctionRef<FVector3f(int32 Index)> GetSourcePosition,
+	TConstArrayView<FVector3f> Positions,
+	FMatrix44f& OutLocalToSH)
+{
+	constexpr int32 MAX_SAMPLES = 4096;
+	// Converted axes are the source's up to sign and scale, so matches are
+	// near exact.
+	constexpr double MIN_CORRELATION = 0.99;
+
+	// Sums of local and source coordinates, then of their products.
+	const int32 NumSamples = FMath::Min(Positions.Num(), MAX_SAMPLES);
+	double Local[3] = {};
+	double LocalSquared[3] = {};
+	double Source[3] = {};
+	double SourceSquared[3] = {};
+	double Products[3][3] = {};
+	for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+	{
+		const int32 Index = int64(Sample) * Positions.Num() / NumSamples;
+		const FVector3f SourcePosition = GetSourcePosition(Index);
+		double S[3];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			S[Axis] = SourcePosition[Axis];
+			Source[Axis] += S[Axis];
+			SourceSquared[Axis] += S[Axis] * S[Axis];
+		}
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const double L = Positions[Index][Axis];
+			Local[Axis] += L;
+			LocalSquared[Axis] += L * L;
+			for (int32 SourceAxis = 0; SourceAxis < 3; ++SourceAxis)
+			{
+				Products[Axis][SourceAxis] += L * S[SourceAxis];
+			}
+		}
+	}
+
+	OutLocalToSH = FMatrix44f::Identity;
+	uint32 MatchedAxes = 0;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		OutLocalToSH.M[Axis][Axis] = 0.f;
+
+		int32 Best = INDEX_NONE;
+		double BestCorrelation = 0.0;
+		for (int32 SourceAxis = 0; SourceAxis < 3; ++SourceAxis)
+		{
+			const double Covariance = Products[Axis][SourceAxis] -
+			                          Local[Axis] * Source[SourceAxis] /
+			                              NumSamples;
+			const double Variance =
+				(LocalSquared[Axis] - Local[Axis] * Local[Axis] / NumSamples) *
+				(SourceSquared[SourceAxis] -
+			     Source[SourceAxis] * Source[SourceAxis] / NumSamples);
+			const double Correlation =
+				Variance > 0.0 ? Covariance / FMath::Sqrt(Variance) : 0.0;
+			if (FMath::Abs(Correlation) > FMath::Abs(BestCorrelation))
+			{
+				Best = SourceAxis;
+				BestCorrelation = Correlation;
+			}
+		}
+
+		if (Best == INDEX_NONE ||
+		    FMath::Abs(BestCorrelation) < MIN_CORRELATION ||
+		    (MatchedAxes & (1u << Best)))
+		{
+			OutLocalToSH = FMatrix44f::Identity;
+			return false;
+		}
+		MatchedAxes |= 1u << Best;
+		OutLocalToSH.M[Axis][Best] = BestCorrelation > 0.0 ? 1.f : -1.f;
 	}
 
-	OutVertices.SetNumUninitialized(IndexMap.Num());
-	for (const auto& Pair : IndexMap)
+	return true;
+}
+
+/**
+ * Finds how local axes map to the axes of a `.ply`, as above.
+ *
+ * @param Reader - Reader for the `.ply`, with the splats readable.
+ * @param Positions - Converted positions of the first splats.
+ * @param OutLocalToSH - Returns the matrix from local directions to `.ply`
+ * directions, as row vectors.
+ * @return False, if axes could not be matched.
+ */
+bool FindLocalToSH(
+	const FPlyVertexReader& Reader,
+	TConstArrayView<FVector3f> Positions,
+	FMatrix44f& OutLocalToSH)
+{
+	const int32 X = Reader.FindProperty(TEXT("x"));
+	const int32 Y = Reader.FindProperty(TEXT("y"));
+	const int32 Z = Reader.FindProperty(TEXT("z"));
+	if (X == INDEX_NONE || Y == INDEX_NONE || Z == INDEX_NONE)
+	{
+		return false;
+	}
+
+	return FindLocalToSH(
+		[&Reader, X, Y, Z](int32 Index)
+		{
+			return FVector3f(
+				Reader.Read(Index, X),
+				Reader.Read(Index, Y),
+				Reader.Read(Index, Z));
+		},
+		Positions,
+		OutLocalToSH);
+}
+
+/**
+ * Parses and converts a window of splats in parallel, as the third-party
+ * parser only does so serially.
+ *
+ * @param Reader - Reader for the `.ply`, with the window readable.
+ * @param Begin - Index of the first splat of the window.
+ * @param End - Index past the last splat of the window.
+ * @param ParseSplat - Converts a splat, given its index and properties.
+ */
+void ParseSplatWindow(
+	const FPlyVertexReader& Reader,
+	int32 Begin,
+	int32 End,
+	const ParseSplatFn& ParseSplat)
+{
+	constexpr int32 BATCH_SIZE = 1024;
+
+	// Names as the converter requests them, so no strings are built per splat.
+	TArray<std::string> Names;
+	for (int32 Property = 0; Property < Reader.GetNumProperties(); ++Property)
+	{
+		Names.Emplace(TCHAR_TO_ANSI(*Reader.GetPropertyName(Property)));
+	}
+	auto FindProperty = [&Names](std::string_view Name)
+	{
+		return Names.IndexOfByPredicate([Name](const std::string& Other)
+		                                { return Other == Name; });
+	};
+
+	ParallelFor(
+		TEXT("ParseSplats"),
+		End - Begin,
+		BATCH_SIZE,
+		[&](int32 Offset)
+		{
+			const int32 Vertex = Begin + Offset;
+			ParseSplat(
+				uint32_t(Vertex),
+				[&Reader, &FindProperty, Vertex](const auto& Name) -> float
+				{
+					const int32 Property = FindProperty(std::string_view(Name));
+					return Property != INDEX_NONE
+					           ? Reader.Read(Vertex, Property)
+					           : 0.f;
+				});
+		});
+}
+
+/**
+ * Parses and converts a window of splats of a compact format in parallel.
+ *
+ * @param Reader - Reader for the file.
+ * @param Begin - Index of the first splat of the window.
+ * @param End - Index past the last splat of the window.
+ * @param ParseSplat - Converts a splat, given its index and properties.
+ */
+void ParseCompactSplatWindow(
+	const FCompactSplatReader& Reader,
+	int32 Begin,
+	int32 End,
+	const ParseSplatFn& ParseSplat)
+{
+	constexpr int32 BATCH_SIZE = 1024;
+
+	ParallelFor(
+		TEXT("ParseCompactSplats"),
+		End - Begin,
+		BATCH_SIZE,
+		[&](int32 Offset)
+		{
+			const int32 Index = Begin + Offset;
+			FPlySplat Splat;
+			Reader.Read(Index, Splat);
+			ParseSplat(
+				uint32_t(Index),
+				[&Splat](const auto& Name) -> float
+				{ return Splat.GetProperty(std::string_view(Name)); });
+		});
+}
+
+/**
+ * Reads the higher-order spherical harmonics of every splat of a compact
+ * format, in parallel.
+ *
+ * @param Reader - Reader for the file. *Must* have spherical harmonics.
+ * @param OutCoefficients - Returns the coefficients of each splat, ordered by
+ * coefficient then channel.
+ */
+void ReadCompactSphericalHarmonics(
+	const FCompactSplatReader& Reader, TArray<float>& OutCoefficients)
+{
+	const int32 Dimension = 3 * GetNumSHCoefficients(Reader.GetSHDegree());
+	OutCoefficients.SetNumUninitialized(Reader.Num() * Dimension);
+	ParallelFor(
+		Reader.Num(),
+		[&](int32 Index)
+		{ Reader.ReadSH(Index, &OutCoefficients[Index * Dimension]); });
+}
+
+/**
+ * Parses and converts splats in parallel, a window at a time, checking for
+ * cancellation between windows.
+ *
+ * @param NumSplats - Number of splats to parse.
+ * @param ParseWindow - Parses the splats from the first index given, up to the
+ * second.
+ * @return False, if cancelled.
+ */
+bool ParseSplatsParallel(
+	int32 NumSplats, TFunctionRef<void(int32 Begin, int32 End)> ParseWindow)
+{
+	const int32 NumWindows = FMath::DivideAndRoundUp(NumSplats, WINDOW_SIZE);
+	FScopedSlowTask SlowTask(NumWindows);
+	for (int32 Window = 0; Window < NumWindows; ++Window)
 	{
-		OutVertices[Pair.Value] = MetersToCentimeters * Positions[Pair.Key];
+		if (SlowTask.ShouldCancel())
+		{
+			return false;
+		}
+		SlowTask.EnterProgressFrame();
+
+		const int32 Begin = Window * WINDOW_SIZE;
+		const int32 End = FMath::Min(Begin + WINDOW_SIZE, NumSplats);
+		ParseWindow(Begin, End);
 	}
 
 	return true;
 }
 
+/**
+ * Checks a `.ply` has the properties every splat needs.
+ *
+ * @param Reader - Reader for the `.ply`.
+ * @return The first property missing, or empty if there are none.
+ */
+FString FindMissingProperty(const FPlyVertexReader& Reader)
+{
+	static const TCHAR* const REQUIRED[] = {
+		TEXT("x"),
+		TEXT("y"),
+		TEXT("z"),
+		TEXT("f_dc_0"),
+		TEXT("f_dc_1"),
+		TEXT("f_dc_2"),
+		TEXT("opacity"),
+		TEXT("scale_0"),
+		TEXT("scale_1"),
+		TEXT("scale_2"),
+		TEXT("rot_0"),
+		TEXT("rot_1"),
+		TEXT("rot_2"),
+		TEXT("rot_3")};
+	for (const TCHAR* Name : REQUIRED)
+	{
+		if (Reader.FindProperty(Name) == INDEX_NONE)
+		{
+			return Name;
+		}
+	}
+	return FString();
+}
+
+/**
+ * Finds assets named as chunks of a chunked asset, beside it, e.g. those left
+ * by an earlier import.
+ *
+ * @param PackagePath - Path of the chunked asset's package.
+ * @param Name - Name of the chunked asset.
+ * @return Assets found, by chunk index.
+ */
+TMap<int32, FAssetData>
+FindExistingChunks(const FString& PackagePath, FName Name)
+{
+	const FString Prefix = Name.ToString() + TEXT("_Chunk_");
+	TArray<FAssetData> Assets;
+	IAssetRegistry::GetChecked().GetAssetsByPath(FName(PackagePath), Assets);
+
+	TMap<int32, FAssetData> Chunks;
+	for (FAssetData& Asset : Assets)
+	{
+		const FString AssetName = Asset.AssetName.ToString();
+		if (!AssetName.StartsWith(Prefix, ESearchCase::CaseSensitive))
+		{
+			continue;
+		}
+		const FString Suffix = AssetName.RightChop(Prefix.Len());
+		const int32 Index = FCString::Atoi(*Suffix);
+		if (Index >= 0 && FString::FromInt(Index) == Suffix)
+		{
+			Chunks.Add(Index, MoveTemp(Asset));
+		}
+	}
+	return Chunks;
+}
+
+/**
+ * @return Size of the columns newly imported scans are split into, in
+ * centimeters, or 0 to never split them. Columns are at most the chunk size,
+ * and narrow enough for positions to be quantized horizontally within the
+ * max position step.
+ */
+float GetImportChunkSize()
+{
+	const float ChunkSizeCM = USplatSettings::GetChunkSize();
+	const float MaxStepCM = USplatSettings::GetMaxPositionStep();
+	if (MaxStepCM <= 0.f)
+	{
+		return ChunkSizeCM;
+	}
+	const float PreciseSizeCM =
+		MaxStepCM * FMath::Min(FPackedPos::MAX.X, FPackedPos::MAX.Y);
+	return ChunkSizeCM > 0.f ? FMath::Min(ChunkSizeCM, PreciseSizeCM)
+	                         : PreciseSizeCM;
+}
+
 } // namespace
 
 USplatAssetFactory::USplatAssetFactory()
@@ -86,6 +615,8 @@ USplatAssetFactory::USplatAssetFactory()
 	SupportedClass = USplatAsset::StaticClass();
 
 	Formats.Emplace(TEXT("ply;Gaussian splat"));
+	Formats.Emplace(TEXT("spz;Gaussian splat (SPZ)"));
+	Formats.Emplace(TEXT("splat;Antimatter15 splat"));
 	bEditorImport = true;
 }
 
@@ -102,30 +633,70 @@ UObject* USplatAssetFactory::FactoryCreateBinary(
 {
 	PICO_LOGL("Loading splats from %s.", *InName.ToString());
 
-	SplatParserPly Parser;
+	// Work of each stage, relative to the others.
+	constexpr float PARSE_WORK = 4.f;
+	constexpr float SH_WORK = 1.f;
+	constexpr float PRUNE_WORK = 1.f;
+	FScopedSlowTask SlowTask(
+		PARSE_WORK + SH_WORK + PRUNE_WORK + LOD_WORK + BUILD_WORK + HULL_WORK,
+		FText::Format(
+			NSLOCTEXT("SplatAssetFactory", "Importing", "Importing {0}..."),
+			FText::FromName(InName)));
+	SlowTask.MakeDialog(/*bShowCancelButton=*/true);
+	auto IsCancelled = [&SlowTask, &InName]()
+	{
+		if (!SlowTask.ShouldCancel())
+		{
+			return false;
+		}
+		PICO_LOGW("Cancelled importing %s.", *InName.ToString());
+		return true;
+	};
 
-	Metadata PLYMetadata;
-	std::span<const uint8_t> BufferView(Buffer, BufferEnd);
-	if (!Parser.parse_metadata(BufferView, PLYMetadata))
+	// Compact formats are decoded by the plugin. Others are `.ply`s, as the
+	// third-party parser supports.
+	const TConstArrayView<uint8> File(Buffer, BufferEnd - Buffer);
+	FCompactSplatReader::EFormat CompactFormat;
+	const bool bCompact =
+		FCompactSplatReader::FindFormat(Type, File, CompactFormat);
+	FCompactSplatReader CompactReader;
+	SplatParserPly Parser;
+	int32 NumSplats = 0;
+	if (bCompact)
 	{
-		PICO_LOGE("Failed to parse metadata from %s.", *InName.ToString());
-		return nullptr;
+		if (!CompactReader.Parse(File, CompactFormat))
+		{
+			PICO_LOGE("Failed to parse %s.", *InName.ToString());
+			return nullptr;
+		}
+		NumSplats = CompactReader.Num();
 	}
-
-	if (!ply::validate_metadata(PLYMetadata))
+	else
 	{
-		PICO_LOGE("Invalid metadata for %s.", *InName.ToString());
-		return nullptr;
+		Metadata PLYMetadata;
+		std::span<const uint8_t> BufferView(Buffer, BufferEnd);
+		if (!Parser.parse_metadata(BufferView, PLYMetadata))
+		{
+			PICO_LOGE("Failed to parse metadata from %s.", *InName.ToString());
+			return nullptr;
+		}
+
+		if (!ply::validate_metadata(PLYMetadata))
+		{
+			PICO_LOGE("Invalid metadata for %s.", *InName.ToString());
+			return nullptr;
+		}
+		NumSplats = PLYMetadata.num_splats;
 	}
 
 	TArray<FVector3f> Positions;
-	Positions.SetNumUninitialized(PLYMetadata.num_splats);
+	Positions.SetNumUninitialized(NumSplats);
 	TArray<FQuat4f> Rotations;
-	Rotations.SetNumUninitialized(PLYMetadata.num_splats);
+	Rotations.SetNumUninitialized(NumSplats);
 	TArray<FVector3f> Scales;
-	Scales.SetNumUninitialized(PLYMetadata.num_splats);
+	Scales.SetNumUninitialized(NumSplats);
 	TArray<FColor> Colors;
-	Colors.SetNumUninitialized(PLYMetadata.num_splats);
+	Colors.SetNumUninitialized(NumSplats);
 
 	ParseSplatFn ParseSplat =
 		[P = std::span<FVector3f>(&Positions[0], Positions.Num()),
@@ -135,20 +706,714 @@ UObject* USplatAssetFactory::FactoryCreateBinary(
 			uint32_t Index, GetPropertyFn Get)
 	{ ply::convert_splat<FVector3f, FQuat4f, FColor>(Index, Get, P, R, S, C); };
 
-	if (!Parser.parse_data(ParseSplat))
+	// Files the plugin's reader supports (i.e. binary little-endian) are
+	// parsed in parallel. Others fall back to the third-party parser.
+	SlowTask.EnterProgressFrame(
+		PARSE_WORK,
+		NSLOCTEXT("SplatAssetFactory", "Parsing", "Parsing splats..."));
+	FPlyVertexReader Reader;
+	const bool bReaderValid = !bCompact && Reader.Parse(File) &&
+	                          Reader.GetNumVertices() == NumSplats;
+	auto ParseWindow = [&](int32 Begin, int32 End)
+	{
+		if (bCompact)
+		{
+			ParseCompactSplatWindow(CompactReader, Begin, End, ParseSplat);
+		}
+		else
+		{
+			ParseSplatWindow(Reader, Begin, End, ParseSplat);
+		}
+	};
+	if (bCompact || bReaderValid)
+	{
+		if (!ParseSplatsParallel(NumSplats, ParseWindow))
+		{
+			PICO_LOGW("Cancelled importing %s.", *InName.ToString());
+			return nullptr;
+		}
+	}
+	else if (!Parser.parse_data(ParseSplat))
 	{
 		PICO_LOGE("Failed to parse splats from %s.", *InName.ToString());
 		return nullptr;
 	}
+	if (IsCancelled())
+	{
+		return nullptr;
+	}
+
+	// The third-party converter only converts base colors, so higher-order
+	// spherical harmonics are read separately.
+	SlowTask.EnterProgressFrame(
+		SH_WORK,
+		NSLOCTEXT(
+			"SplatAssetFactory",
+			"ReadingSH",
+			"Reading spherical harmonics..."));
+	uint32 SHDegree = 0;
+	TArray<float> SHCoefficients;
+	FMatrix44f LocalToSH = FMatrix44f::Identity;
+	TArray<int32> SHProperties;
+	if (USplatSettings::GetSHFormat() != ESHFormat::None)
+	{
+		if (bCompact)
+		{
+			SHDegree = CompactReader.GetSHDegree();
+		}
+		else if (bReaderValid)
+		{
+			SHDegree = FindSHProperties(Reader, SHProperties);
+		}
+	}
+	if (SHDegree > 0)
+	{
+		bool bMatchedAxes = false;
+		if (bCompact)
+		{
+			ReadCompactSphericalHarmonics(CompactReader, SHCoefficients);
+			bMatchedAxes = FindLocalToSH(
+				[&CompactReader](int32 Index)
+				{ return CompactReader.ReadSourcePosition(Index); },
+				Positions,
+				LocalToSH);
+		}
+		else
+		{
+			ReadSphericalHarmonics(
+				Reader, SHProperties, SHDegree, 0, NumSplats, SHCoefficients);
+			bMatchedAxes = FindLocalToSH(Reader, Positions, LocalToSH);
+		}
+		if (!bMatchedAxes)
+		{
+			PICO_LOGW(
+				"Could not match axes of %s, so view-dependent colors may be "
+				"wrong.",
+				*InName.ToString());
+		}
+	}
+	if (IsCancelled())
+	{
+		return nullptr;
+	}
+
+	SlowTask.EnterProgressFrame(
+		PRUNE_WORK,
+		NSLOCTEXT("SplatAssetFactory", "Pruning", "Pruning splats..."));
+	FImportedSplats Splats;
+	Splats.Positions = std::move(Positions);
+	Splats.Rotations = std::move(Rotations);
+	Splats.Scales = std::move(Scales);
+	Splats.Colors = std::move(Colors);
+	Splats.SHDegree = SHDegree;
+	Splats.SHCoefficients = std::move(SHCoefficients);
+
+	FSplatPruningOptions Options;
+	Options.MinOpacity = USplatSettings::GetMinImportOpacity();
+	Options.MinScaleCM = USplatSettings::GetMinImportScale();
+	Options.MergeDistanceCM = USplatSettings::GetImportMergeDistance();
+	const FSplatPruningStats Stats = PruneSplats(Splats, Options);
+	PICO_LOGL(
+		"Pruned %s: removed %d transparent and %d degenerate splats, merged "
+		"%d, keeping %d of %d (estimated error %.2f%%).",
+		*InName.ToString(),
+		Stats.NumTransparent,
+		Stats.NumDegenerate,
+		Stats.NumMerged,
+		Splats.Num(),
+		NumSplats,
+		100.f * Stats.EstimatedError);
+	if (Splats.Num() == 0)
+	{
+		PICO_LOGE("No splats left in %s after pruning.", *InName.ToString());
+		return nullptr;
+	}
+	if (IsCancelled())
+	{
+		return nullptr;
+	}
+
+	if (USplatSettings::ShouldGenerateLOD() &&
+	    USplatSettings::ShouldOrderByImportance())
+	{
+		PICO_LOGW(
+			"Splats with levels of detail are ordered by their hierarchy, so "
+			"%s is not ordered by importance.",
+			*InName.ToString());
+	}
+
+	// Scans wider than a chunk are split, so only chunks near streaming
+	// sources need be loaded, and each is quantized finely enough.
+	const float ChunkSizeCM = GetImportChunkSize();
+	const FVector3f SizeCM =
+		MetersToCentimeters * FBox3f(Splats.Positions).GetSize();
+	if (ChunkSizeCM > 0.f && FMath::Max(SizeCM.X, SizeCM.Y) > ChunkSizeCM)
+	{
+		return BuildChunkedAsset(
+			Splats,
+			LocalToSH,
+			InParent,
+			InName,
+			Flags,
+			ChunkSizeCM,
+			SlowTask,
+			IsCancelled);
+	}
+	return BuildAsset(
+		Splats,
+		LocalToSH,
+		InParent,
+		InName,
+		Flags,
+		SlowTask,
+		/*WorkScale=*/1.f,
+		IsCancelled);
+}
+
+USplatAsset* USplatAssetFactory::BuildAsset(
+	FImportedSplats& Splats,
+	const FMatrix44f& LocalToSH,
+	UObject* InParent,
+	FName InName,
+	EObjectFlags Flags,
+	FScopedSlowTask& SlowTask,
+	float WorkScale,
+	TFunctionRef<bool()> IsCancelled)
+{
+	// Levels of detail order splats by their hierarchy, so take precedence.
+	const bool bGenerateLOD = USplatSettings::ShouldGenerateLOD();
+	const bool bOrderByImportance =
+		!bGenerateLOD && USplatSettings::ShouldOrderByImportance();
+	SlowTask.EnterProgressFrame(
+		WorkScale * LOD_WORK,
+		bOrderByImportance
+			? NSLOCTEXT(
+				  "SplatAssetFactory",
+				  "OrderingByImportance",
+				  "Ordering splats by importance...")
+			: NSLOCTEXT(
+				  "SplatAssetFactory",
+				  "GeneratingLOD",
+				  "Generating levels of detail..."));
+	// Trainers output splats in no particular order, so sort them along a
+	// curve, keeping neighbours together in every stream. Levels of detail
+	// and importance order from this, leaving nearby splats near each other,
+	// and importance ranks blocks of neighbours along it.
+	SortSplatsAlongCurve(Splats);
+
+	TArray<FSplatLODNode> LODNodes;
+	TArray<float> PrefixCoverage;
+	if (bOrderByImportance)
+	{
+		OrderSplatsByImportance(Splats, PrefixCoverage);
+		PICO_LOGL(
+			"Ordered %d splats of %s by importance, the first half keeping "
+			"%.1f%% of their coverage.",
+			Splats.Num(),
+			*InName.ToString(),
+			100.f * PrefixCoverage[PrefixCoverage.Num() / 2 - 1]);
+	}
+	if (bGenerateLOD)
+	{
+		const int32 NumLeaves = Splats.Num();
+		const int32 NumLevels = BuildSplatLOD(Splats, LODNodes);
+		PICO_LOGL(
+			"Generated %d levels of detail for %s, adding %d coarser splats to "
+			"%d.",
+			NumLevels,
+			*InName.ToString(),
+			Splats.Num() - NumLeaves,
+			NumLeaves);
+	}
+	if (IsCancelled())
+	{
+		return nullptr;
+	}
+
+	SlowTask.EnterProgressFrame(
+		WorkScale * BUILD_WORK,
+		NSLOCTEXT("SplatAssetFactory", "Building", "Building splats..."));
+	USplatAsset* Asset = NewObject<USplatAsset>(InParent, InName, Flags);
+	Asset->SetNumSplats(Splats.Num());
+	Asset->SetPositionsMeters(std::move(Splats.Positions));
+	Asset->SetCovariancesQuatScaleMeters(Splats.Rotations, Splats.Scales);
+	Asset->SetColorsLinear(std::move(Splats.Colors));
+	if (Splats.SHDegree > 0)
+	{
+		Asset->SetSphericalHarmonics(
+			Splats.SHDegree, Splats.SHCoefficients, LocalToSH);
+	}
+	if (!LODNodes.IsEmpty())
+	{
+		Asset->SetLODNodes(std::move(LODNodes));
+	}
+	if (!PrefixCoverage.IsEmpty())
+	{
+		Asset->SetPrefixCoverage(std::move(PrefixCoverage));
+	}
+	if (IsCancelled())
+	{
+		return nullptr;
+	}
+
+	SlowTask.EnterProgressFrame(
+		WorkScale * HULL_WORK,
+		NSLOCTEXT(
+			"SplatAssetFactory",
+			"GeneratingHull",
+			"Generating convex hull..."));
+	const uint8 HullMinOpacity =
+		uint8(FMath::RoundToInt(255.f * USplatSettings::GetHullMinOpacity()));
+	if (!GenerateConvexHull(
+			Asset->PositionsFullPrecision,
+			Asset->GetOpacities(),
+			HullMinOpacity,
+			Asset->ConvexHullVertices,
+			Asset->ConvexHullIndices))
+	{
+		PICO_LOGE("Failed to generate convex hull for %s.", *InName.ToString());
+		return nullptr;
+	}
+
+	Asset->BeginInit();
+
+	return Asset;
+}
+
+USplatChunkedAsset* USplatAssetFactory::BuildChunkedAsset(
+	FImportedSplats& Splats,
+	const FMatrix44f& LocalToSH,
+	UObject* InParent,
+	FName InName,
+	EObjectFlags Flags,
+	float ChunkSizeCM,
+	FScopedSlowTask& SlowTask,
+	TFunctionRef<bool()> IsCancelled)
+{
+	const int32 NumSplats = Splats.Num();
+	TArray<FImportedSplats> Chunks;
+	SplitSplatsIntoChunks(Splats, ChunkSizeCM, Chunks);
+	PICO_LOGL(
+		"Split %d splats of %s into %d chunks.",
+		NumSplats,
+		*InName.ToString(),
+		Chunks.Num());
+
+	// Each chunk is saved in its own package beside the chunked asset, so is
+	// loaded only when referenced.
+	check(InParent);
+	const FString PackagePath =
+		FPackageName::GetLongPackagePath(InParent->GetOutermost()->GetName());
+
+	// Chunks of an earlier import are overwritten, and those not overwritten
+	// are deleted once built. Other assets in the way are left, and fail the
+	// import, rather than being replaced.
+	const TMap<int32, FAssetData> ExistingChunks =
+		FindExistingChunks(PackagePath, InName);
+	for (const auto& [Index, Existing] : ExistingChunks)
+	{
+		if (Index < Chunks.Num() &&
+		    !Existing.IsInstanceOf(USplatAsset::StaticClass()))
+		{
+			PICO_LOGE(
+				"%s is in the way of chunk %d of %s, and is not a splat asset.",
+				*Existing.GetObjectPathString(),
+				Index,
+				*InName.ToString());
+			return nullptr;
+		}
+	}
+
+	USplatChunkedAsset* ChunkedAsset =
+		NewObject<USplatChunkedAsset>(InParent, InName, Flags);
+	TBitArray<> Built(false, Chunks.Num());
+	for (int32 Index = 0; Index < Chunks.Num(); ++Index)
+	{
+		const FString ChunkName =
+			FString::Printf(TEXT("%s_Chunk_%d"), *InName.ToString(), Index);
+		// Earlier chunks are loaded first, so they are replaced in place.
+		if (const FAssetData* Existing = ExistingChunks.Find(Index))
+		{
+			Existing->GetAsset();
+		}
+		UPackage* Package = CreatePackage(*(PackagePath / ChunkName));
+		USplatAsset* Asset = BuildAsset(
+			Chunks[Index],
+			LocalToSH,
+			Package,
+			FName(ChunkName),
+			Flags | RF_Public | RF_Standalone,
+			SlowTask,
+			float(Chunks[Index].Num()) / NumSplats,
+			IsCancelled);
+		Chunks[Index] = FImportedSplats();
+		if (!Asset)
+		{
+			// Chunks of a few splats may have no hull, and can be left out.
+			if (IsCancelled())
+			{
+				return nullptr;
+			}
+			PICO_LOGW("Left chunk %d out of %s.", Index, *InName.ToString());
+			continue;
+		}
+
+		FAssetRegistryModule::AssetCreated(Asset);
+		Package->MarkPackageDirty();
+		ChunkedAsset->AddChunk(Asset);
+		Built[Index] = true;
+	}
+
+	if (ChunkedAsset->GetChunks().IsEmpty())
+	{
+		PICO_LOGE("No chunks left in %s.", *InName.ToString());
+		return nullptr;
+	}
+
+	TArray<UObject*> StaleChunks;
+	for (const auto& [Index, Existing] : ExistingChunks)
+	{
+		if ((Index >= Chunks.Num() || !Built[Index]) &&
+		    Existing.IsInstanceOf(USplatAsset::StaticClass()))
+		{
+			if (UObject* Object = Existing.GetAsset())
+			{
+				StaleChunks.Add(Object);
+			}
+		}
+	}
+	if (!StaleChunks.IsEmpty())
+	{
+		PICO_LOGL(
+			"Deleting %d chunks of %s left by an earlier import.",
+			StaleChunks.Num(),
+			*InName.ToString());
+		ObjectTools::ForceDeleteObjects(
+			StaleChunks, /*ShowConfirmation=*/false);
+	}
+	return ChunkedAsset;
+}
+
+UObject* USplatAssetFactory::FactoryCreateFile(
+	UClass* InClass,
+	UObject* InParent,
+	FName InName,
+	EObjectFlags Flags,
+	const FString& Filename,
+	const TCHAR* Parms,
+	FFeedbackContext* Warn,
+	bool& bOutOperationCanceled)
+{
+	// Only `.ply`s are streamed, as compact formats are far smaller.
+	if (!FPaths::GetExtension(Filename).Equals(
+			TEXT("ply"), ESearchCase::IgnoreCase) ||
+	    IFileManager::Get().FileSize(*Filename) <
+	        USplatSettings::GetStreamedImportSize())
+	{
+		return Super::FactoryCreateFile(
+			InClass,
+			InParent,
+			InName,
+			Flags,
+			Filename,
+			Parms,
+			Warn,
+			bOutOperationCanceled);
+	}
+
+	return ImportStreamed(
+		InParent, InName, Flags, Filename, bOutOperationCanceled);
+}
+
+USplatAsset* USplatAssetFactory::ImportStreamed(
+	UObject* InParent,
+	FName InName,
+	EObjectFlags Flags,
+	const FString& Filename,
+	bool& bOutOperationCanceled)
+{
+	PICO_LOGL("Streaming splats from %s.", *Filename);
+
+	// Largest header read, in bytes.
+	constexpr int64 MAX_HEADER_SIZE = 64 * 1024;
+
+	// Work of each stage, relative to the others.
+	constexpr float PARSE_WORK = 4.f;
+	constexpr float PARTITION_WORK = 2.f;
+	FScopedSlowTask SlowTask(
+		PARSE_WORK + PARTITION_WORK + BUILD_WORK + HULL_WORK,
+		FText::Format(
+			NSLOCTEXT("SplatAssetFactory", "Importing", "Importing {0}..."),
+			FText::FromName(InName)));
+	SlowTask.MakeDialog(/*bShowCancelButton=*/true);
+	auto IsCancelled = [&SlowTask, &InName, &bOutOperationCanceled]()
+	{
+		if (!SlowTask.ShouldCancel())
+		{
+			return false;
+		}
+		PICO_LOGW("Cancelled importing %s.", *InName.ToString());
+		bOutOperationCanceled = true;
+		return true;
+	};
+
+	// Windows of the file are memory-mapped one at a time, or read where files
+	// cannot be mapped.
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	FOpenMappedResult MapResult =
+		FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Filename);
+	if (MapResult.HasValue())
+	{
+		MappedFile = MapResult.StealValue();
+	}
+	TUniquePtr<FArchive> FileReader;
+	if (!MappedFile)
+	{
+		FileReader.Reset(IFileManager::Get().CreateFileReader(*Filename));
+		if (!FileReader)
+		{
+			PICO_LOGE("Failed to open %s.", *Filename);
+			return nullptr;
+		}
+	}
+	const int64 FileSize =
+		MappedFile ? MappedFile->GetFileSize() : FileReader->TotalSize();
+
+	TUniquePtr<IMappedFileRegion> Region;
+	TArray<uint8> Buffer;
+	auto LoadWindow = [&](int64 Offset, int64 Size) -> const uint8*
+	{
+		if (MappedFile)
+		{
+			// Unmaps the last window first.
+			Region.Reset();
+			Region.Reset(MappedFile->MapRegion(Offset, Size));
+			return Region ? Region->GetMappedPtr() : nullptr;
+		}
+		Buffer.SetNumUninitialized(Size);
+		FileReader->Seek(Offset);
+		FileReader->Serialize(Buffer.GetData(), Size);
+		return FileReader->IsError() ? nullptr : Buffer.GetData();
+	};
+
+	FPlyVertexReader Reader;
+	const int64 HeaderWindow = FMath::Min(FileSize, MAX_HEADER_SIZE);
+	const uint8* Header = LoadWindow(0, HeaderWindow);
+	if (!Header ||
+	    !Reader.ParseHeader(
+			TConstArrayView<uint8>(Header, HeaderWindow), FileSize))
+	{
+		PICO_LOGE("Failed to parse header of %s.", *Filename);
+		return nullptr;
+	}
+	const FString Missing = FindMissingProperty(Reader);
+	if (!Missing.IsEmpty())
+	{
+		PICO_LOGE("Missing property %s in %s.", *Missing, *Filename);
+		return nullptr;
+	}
+
+	TArray<int32> SHProperties;
+	const uint32 SHDegree = USplatSettings::GetSHFormat() != ESHFormat::None
+	                            ? FindSHProperties(Reader, SHProperties)
+	                            : 0;
+	FMatrix44f LocalToSH = FMatrix44f::Identity;
+
+	// Merging needs neighbours from every window, so only thresholds apply.
+	FSplatPruningOptions Options;
+	Options.MinOpacity = USplatSettings::GetMinImportOpacity();
+	Options.MinScaleCM = USplatSettings::GetMinImportScale();
+	if (USplatSettings::GetImportMergeDistance() > 0.f)
+	{
+		PICO_LOGW(
+			"Streamed imports do not merge splats, so %s is not merged.",
+			*InName.ToString());
+	}
+	if (USplatSettings::ShouldGenerateLOD())
+	{
+		PICO_LOGW(
+			"Streamed imports do not generate levels of detail, so %s has "
+			"none.",
+			*InName.ToString());
+	}
+	if (USplatSettings::ShouldOrderByImportance())
+	{
+		PICO_LOGW(
+			"Streamed imports do not order splats by importance, so %s is "
+			"not ordered.",
+			*InName.ToString());
+	}
+	if (GetImportChunkSize() > 0.f)
+	{
+		PICO_LOGW(
+			"Streamed imports are not split into chunks, so %s is one asset.",
+			*InName.ToString());
+	}
+
+	// Convert and prune each window, spilling what is kept.
+	SlowTask.EnterProgressFrame(
+		PARSE_WORK,
+		NSLOCTEXT("SplatAssetFactory", "Parsing", "Parsing splats..."));
+	FSplatPartitioner Partitioner(SHDegree);
+	FSplatPruningStats Stats;
+	{
+		const int32 NumVertices = Reader.GetNumVertices();
+		const int32 NumWindows =
+			FMath::DivideAndRoundUp(NumVertices, WINDOW_SIZE);
+		FScopedSlowTask ParseTask(NumWindows);
+		FImportedSplats Window;
+		Window.SHDegree = SHDegree;
+		for (int32 Index = 0; Index < NumWindows; ++Index)
+		{
+			if (IsCancelled())
+			{
+				return nullptr;
+			}
+			ParseTask.EnterProgressFrame();
+
+			const int32 First = Index * WINDOW_SIZE;
+			const int32 Num = FMath::Min(WINDOW_SIZE, NumVertices - First);
+			const uint8* Data = LoadWindow(
+				Reader.GetDataOffset() + int64(First) * Reader.GetStride(),
+				int64(Num) * Reader.GetStride());
+			if (!Data)
+			{
+				PICO_LOGE("Failed to read splats from %s.", *Filename);
+				return nullptr;
+			}
+			Reader.SetWindow(Data, First, Num);
+
+			Window.Positions.SetNumUninitialized(Num);
+			Window.Rotations.SetNumUninitialized(Num);
+			Window.Scales.SetNumUninitialized(Num);
+			Window.Colors.SetNumUninitialized(Num);
+			ParseSplatFn ParseSplat =
+				[P = std::span<FVector3f>(Window.Positions.GetData(), Num),
+			     R = std::span<FQuat4f>(Window.Rotations.GetData(), Num),
+			     S = std::span<FVector3f>(Window.Scales.GetData(), Num),
+			     C = std::span<FColor>(Window.Colors.GetData(), Num),
+			     First](uint32_t Vertex, GetPropertyFn Get)
+			{
+				ply::convert_splat<FVector3f, FQuat4f, FColor>(
+					Vertex - First, Get, P, R, S, C);
+			};
+			ParseSplatWindow(Reader, First, First + Num, ParseSplat);
+
+			if (SHDegree > 0)
+			{
+				ReadSphericalHarmonics(
+					Reader,
+					SHProperties,
+					SHDegree,
+					First,
+					Num,
+					Window.SHCoefficients);
+				// Axes are matched from the first window alone.
+				if (First == 0 &&
+				    !FindLocalToSH(Reader, Window.Positions, LocalToSH))
+				{
+					PICO_LOGW(
+						"Could not match axes of %s, so view-dependent colors "
+						"may be wrong.",
+						*InName.ToString());
+				}
+			}
+
+			const FSplatPruningStats WindowStats = PruneSplats(Window, Options);
+			Stats.NumTransparent += WindowStats.NumTransparent;
+			Stats.NumDegenerate += WindowStats.NumDegenerate;
+			if (!Partitioner.Add(Window))
+			{
+				return nullptr;
+			}
+		}
+	}
+	Region.Reset();
+	Buffer.Empty();
+
+	PICO_LOGL(
+		"Pruned %s: removed %d transparent and %d degenerate splats, keeping "
+		"%d of %d.",
+		*InName.ToString(),
+		Stats.NumTransparent,
+		Stats.NumDegenerate,
+		Partitioner.Num(),
+		Reader.GetNumVertices());
+	if (Partitioner.Num() == 0)
+	{
+		PICO_LOGE("No splats left in %s after pruning.", *InName.ToString());
+		return nullptr;
+	}
 
+	SlowTask.EnterProgressFrame(
+		PARTITION_WORK,
+		NSLOCTEXT(
+			"SplatAssetFactory", "Partitioning", "Partitioning splats..."));
+	if (!Partitioner.Partition(CLUSTER_SIZE))
+	{
+		bOutOperationCanceled = SlowTask.ShouldCancel();
+		PICO_LOGE("Failed to partition splats of %s.", *InName.ToString());
+		return nullptr;
+	}
+	int32 LargestCluster = 0;
+	for (const FSplatCluster& Cluster : Partitioner.GetClusters())
+	{
+		LargestCluster = FMath::Max(LargestCluster, Cluster.Num);
+	}
+	PICO_LOGL(
+		"Partitioned %s into %d clusters, of up to %d splats.",
+		*InName.ToString(),
+		Partitioner.GetClusters().Num(),
+		LargestCluster);
+	if (IsCancelled())
+	{
+		return nullptr;
+	}
+
+	// Splats are added in cluster order, so nearby splats are stored
+	// together.
+	SlowTask.EnterProgressFrame(
+		BUILD_WORK,
+		NSLOCTEXT("SplatAssetFactory", "Building", "Building splats..."));
 	USplatAsset* Asset = NewObject<USplatAsset>(InParent, InName, Flags);
-	Asset->SetNumSplats(PLYMetadata.num_splats);
-	Asset->SetPositionsMeters(std::move(Positions));
-	Asset->SetCovariancesQuatScaleMeters(Rotations, Scales);
-	Asset->SetColorsLinear(std::move(Colors));
+	Asset->BeginStreamedSplats(
+		Partitioner.Num(), SHDegree, Partitioner.GetSHSample(), LocalToSH);
+	const bool bRead = Partitioner.Read(
+		WINDOW_SIZE,
+		[Asset](int32 First, const FImportedSplats& Window)
+		{
+			Asset->AddStreamedSplats(
+				First,
+				Window.Positions,
+				Window.Rotations,
+				Window.Scales,
+				Window.Colors,
+				Window.SHCoefficients);
+		});
+	if (!bRead)
+	{
+		bOutOperationCanceled = SlowTask.ShouldCancel();
+		PICO_LOGE("Failed to build splats of %s.", *InName.ToString());
+		return nullptr;
+	}
+	Asset->EndStreamedSplats();
+	if (IsCancelled())
+	{
+		return nullptr;
+	}
 
+	SlowTask.EnterProgressFrame(
+		HULL_WORK,
+		NSLOCTEXT(
+			"SplatAssetFactory",
+			"GeneratingHull",
+			"Generating convex hull..."));
+	const uint8 HullMinOpacity =
+		uint8(FMath::RoundToInt(255.f * USplatSettings::GetHullMinOpacity()));
 	if (!GenerateConvexHull(
 			Asset->PositionsFullPrecision,
+			Asset->GetOpacities(),
+			HullMinOpacity,
 			Asset->ConvexHullVertices,
 			Asset->ConvexHullIndices))
 	{
@@ -5,12 +5,18 @@
 #pragma once
 
 #include "Factories/Factory.h"
+#include "Misc/ScopedSlowTask.h"
 #include "SplatAsset.h"
+#include "SplatChunkedAsset.h"
+#include "SplatPruning.h"
+#include "Templates/Function.h"
 
 #include "SplatAssetFactory.generated.h"
 
 /**
- * Importer for 3DGS `.ply` files.
+ * Importer for 3DGS `.ply` files, and the compact `.spz`, `.splat` and
+ * compressed `.ply` formats. Scans wider than the chunk size are imported as
+ * `USplatChunkedAsset`s.
  */
 UCLASS()
 class USplatAssetFactory final : public UFactory
@@ -19,12 +25,13 @@ class USplatAssetFactory final : public UFactory
 
 public:
 	/**
-	 * Registers `.ply` file type for import as a Gaussian Splat asset.
+	 * Registers `.ply`, `.spz` and `.splat` file types for import as a Gaussian
+	 * Splat asset.
 	 */
 	USplatAssetFactory();
 
 	/**
-	 * Imports splat `.ply` files into `USplatAsset`s.
+	 * Imports splat files into `USplatAsset`s.
 	 */
 	virtual UObject* FactoryCreateBinary(
 		UClass* InClass,
@@ -36,4 +43,89 @@ public:
 		const uint8*& Buffer,
 		const uint8* BufferEnd,
 		FFeedbackContext* Warn) override;
+
+	/**
+	 * Imports files too large to load at once a window at a time, and others
+	 * as binary.
+	 */
+	virtual UObject* FactoryCreateFile(
+		UClass* InClass,
+		UObject* InParent,
+		FName InName,
+		EObjectFlags Flags,
+		const FString& Filename,
+		const TCHAR* Parms,
+		FFeedbackContext* Warn,
+		bool& bOutOperationCanceled) override;
+
+private:
+	/**
+	 * Orders splats by importance, or generates levels of detail, as set, then
+	 * builds them into a new asset and starts initializing it.
+	 *
+	 * @param Splats - Splats to build, after pruning. Returns reordered.
+	 * @param LocalToSH - Transform from local axes to the axes spherical
+	 * harmonics are evaluated in.
+	 * @param InParent - Outer of the new asset.
+	 * @param InName - Name of the new asset.
+	 * @param Flags - Flags of the new asset.
+	 * @param SlowTask - Task to report the progress of each stage to.
+	 * @param WorkScale - Fraction of each stage's work this asset is.
+	 * @param IsCancelled - Returns whether import was cancelled.
+	 * @return The new asset, or null if building failed or was cancelled.
+	 */
+	static USplatAsset* BuildAsset(
+		PICO::Splat::FImportedSplats& Splats,
+		const FMatrix44f& LocalToSH,
+		UObject* InParent,
+		FName InName,
+		EObjectFlags Flags,
+		FScopedSlowTask& SlowTask,
+		float WorkScale,
+		TFunctionRef<bool()> IsCancelled);
+
+	/**
+	 * Splits splats into chunks, and builds each into its own asset, in its
+	 * own package beside a new chunked asset referencing them all.
+	 *
+	 * @param Splats - Splats to build, after pruning. Returns empty.
+	 * @param LocalToSH - Transform from local axes to the axes spherical
+	 * harmonics are evaluated in.
+	 * @param InParent - Outer of the new chunked asset.
+	 * @param InName - Name of the new chunked asset.
+	 * @param Flags - Flags of the new chunked asset.
+	 * @param ChunkSizeCM - Size of the columns to split splats into.
+	 * @param SlowTask - Task to report the progress of each stage to.
+	 * @param IsCancelled - Returns whether import was cancelled.
+	 * @return The new chunked asset, or null if building every chunk failed,
+	 * an asset other than a chunk is named as one, or import was cancelled.
+	 */
+	static USplatChunkedAsset* BuildChunkedAsset(
+		PICO::Splat::FImportedSplats& Splats,
+		const FMatrix44f& LocalToSH,
+		UObject* InParent,
+		FName InName,
+		EObjectFlags Flags,
+		float ChunkSizeCM,
+		FScopedSlowTask& SlowTask,
+		TFunctionRef<bool()> IsCancelled);
+
+	/**
+	 * Imports a `.ply` a window of splats at a time, mapping or reading only
+	 * the window from the file, and spilling converted splats to temporary
+	 * files to group them into spatial clusters.
+	 *
+	 * @param InParent - Outer of the new asset.
+	 * @param InName - Name of the new asset.
+	 * @param Flags - Flags of the new asset.
+	 * @param Filename - Path of the `.ply`.
+	 * @param bOutOperationCanceled - Returns whether import was cancelled.
+	 * @return The new asset, or null if import failed or was cancelled.
+	 */
+	USplatAsset* ImportStreamed(
+		UObject* InParent,
+		FName InName,
+		EObjectFlags Flags,
+		const FString& Filename,
+		bool& bOutOperationCanceled);
 };
\ No newline at end of file
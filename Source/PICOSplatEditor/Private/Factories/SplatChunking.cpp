@@ -0,0 +1,88 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatChunking.h"
+
+#include "Math/Box.h"
+#include "Misc/AssertionMacros.h"
+#include "SplatConstants.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+/**
+ * Copies a contiguous range of splats.
+ *
+ * @param Splats - Splats to copy from.
+ * @param First - Index of the first splat to copy.
+ * @param Num - Number of splats to copy.
+ * @param OutSplats - Returns the copied splats.
+ */
+void CopySplats(
+	const FImportedSplats& Splats,
+	int32 First,
+	int32 Num,
+	FImportedSplats& OutSplats)
+{
+	OutSplats.Positions = TArray<FVector3f>(&Splats.Positions[First], Num);
+	OutSplats.Rotations = TArray<FQuat4f>(&Splats.Rotations[First], Num);
+	OutSplats.Scales = TArray<FVector3f>(&Splats.Scales[First], Num);
+	OutSplats.Colors = TArray<FColor>(&Splats.Colors[First], Num);
+	OutSplats.SHDegree = Splats.SHDegree;
+	if (Splats.SHDegree > 0)
+	{
+		const int32 Stride = 3 * GetNumSHCoefficients(Splats.SHDegree);
+		OutSplats.SHCoefficients =
+			TArray<float>(&Splats.SHCoefficients[First * Stride], Num * Stride);
+	}
+}
+} // namespace
+
+void SplitSplatsIntoChunks(
+	FImportedSplats& Splats,
+	float ChunkSizeCM,
+	TArray<FImportedSplats>& OutChunks)
+{
+	check(ChunkSizeCM > 0.f);
+	const int32 NumSplats = Splats.Num();
+	check(NumSplats > 0);
+
+	// Group splats by column, keyed by the column's X then Y.
+	const FBox3f Bounds(Splats.Positions);
+	const float ChunkSizeM = ChunkSizeCM / MetersToCentimeters;
+	TArray<TPair<uint64, int32>> Keys;
+	Keys.SetNumUninitialized(NumSplats);
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		const FVector3f Offset = Splats.Positions[Index] - Bounds.Min;
+		const uint64 X = uint64(FMath::FloorToInt32(Offset.X / ChunkSizeM));
+		const uint64 Y = uint64(FMath::FloorToInt32(Offset.Y / ChunkSizeM));
+		Keys[Index] = {(X << 32) | Y, Index};
+	}
+	Keys.Sort();
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumSplats);
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		Order[Index] = Keys[Index].Value;
+	}
+	ReorderSplats(Splats, Order);
+
+	OutChunks.Reset();
+	int32 First = 0;
+	for (int32 Index = 1; Index <= NumSplats; ++Index)
+	{
+		if (Index == NumSplats || Keys[Index].Key != Keys[First].Key)
+		{
+			CopySplats(
+				Splats, First, Index - First, OutChunks.AddDefaulted_GetRef());
+			First = Index;
+		}
+	}
+	Splats = FImportedSplats();
+}
+
+} // namespace PICO::Splat
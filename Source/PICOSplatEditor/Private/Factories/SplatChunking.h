@@ -0,0 +1,27 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "SplatPruning.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Splits splats into columns of a grid over X and Y, so each can be loaded on
+ * its own. Columns span every height, as scans are far wider than tall.
+ *
+ * @param Splats - Splats to split. Returns empty.
+ * @param ChunkSizeCM - Width of each column, in centimeters.
+ * @param OutChunks - Returns the splats of each column holding any, ordered by
+ * column.
+ */
+void SplitSplatsIntoChunks(
+	FImportedSplats& Splats,
+	float ChunkSizeCM,
+	TArray<FImportedSplats>& OutChunks);
+
+} // namespace PICO::Splat
@@ -0,0 +1,134 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatImportance.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/AssertionMacros.h"
+#include "SplatConstants.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+// Splats per block, ranked against one another.
+constexpr int32 BLOCK_SIZE = 256;
+// Prefixes whose coverage is sampled.
+constexpr int32 NUM_PREFIX_SAMPLES = 16;
+// Added to the contrast of each splat, so splats matching their block's mean
+// color are still ranked by opacity and volume.
+constexpr float MIN_CONTRAST = 0.05f;
+
+/**
+ * @param Color - Color of the splat, with opacity in alpha.
+ * @param Scale - Scale of the splat, in meters.
+ * @param MeanColor - Mean color of the splat's block, in [0, 1].
+ * @return Importance of the splat within its block.
+ */
+float GetImportance(
+	const FColor& Color, const FVector3f& Scale, const FVector3f& MeanColor)
+{
+	const FVector3f RGB = FVector3f(Color.R, Color.G, Color.B) / 255.f;
+	const float Contrast = FVector3f::Distance(RGB, MeanColor);
+	return Color.A / 255.f * Scale.X * Scale.Y * Scale.Z *
+	       (Contrast + MIN_CONTRAST);
+}
+} // namespace
+
+void OrderSplatsByImportance(
+	FImportedSplats& Splats, TArray<float>& OutPrefixCoverage)
+{
+	const int32 NumSplats = Splats.Num();
+	check(NumSplats > 0);
+
+	// Splats are sorted along a curve, so each block is a compact
+	// neighbourhood. Rank splats within each block, keying each by its rank
+	// relative to the size of its block. Ties are left in curve order, so
+	// prefixes stay spread evenly over space.
+	const int32 NumBlocks = FMath::DivideAndRoundUp(NumSplats, BLOCK_SIZE);
+	TArray<TPair<float, int32>> Keys;
+	Keys.SetNumUninitialized(NumSplats);
+	ParallelFor(
+		TEXT("SplatImportanceRanks"),
+		NumBlocks,
+		1,
+		[&](int32 Block)
+		{
+			const int32 First = Block * BLOCK_SIZE;
+			const int32 Num = FMath::Min(BLOCK_SIZE, NumSplats - First);
+
+			FVector3f MeanColor = FVector3f::ZeroVector;
+			for (int32 Member = First; Member < First + Num; ++Member)
+			{
+				const FColor& Color = Splats.Colors[Member];
+				MeanColor += FVector3f(Color.R, Color.G, Color.B) / 255.f;
+			}
+			MeanColor /= float(Num);
+
+			TArray<TPair<float, int32>, TInlineAllocator<BLOCK_SIZE>> Ranked;
+			for (int32 Member = First; Member < First + Num; ++Member)
+			{
+				Ranked.Emplace(
+					-GetImportance(
+						Splats.Colors[Member],
+						Splats.Scales[Member],
+						MeanColor),
+					Member);
+			}
+			Ranked.Sort();
+			for (int32 Rank = 0; Rank < Num; ++Rank)
+			{
+				Keys[Ranked[Rank].Value] = {
+					(Rank + 0.5f) / float(Num),
+					Ranked[Rank].Value};
+			}
+		});
+	Keys.Sort();
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumSplats);
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		Order[Index] = Keys[Index].Value;
+	}
+	ReorderSplats(Splats, Order);
+
+	// Sample how much of the total coverage each prefix keeps.
+	TArray<double> Coverages;
+	Coverages.SetNumUninitialized(NumSplats);
+	ParallelFor(
+		TEXT("SplatImportanceCoverage"),
+		NumSplats,
+		16 * 1024,
+		[&](int32 Index)
+		{
+			Coverages[Index] = GetSplatCoverage(
+				Splats.Colors[Index],
+				MetersToCentimeters * Splats.Scales[Index]);
+		});
+	double TotalCoverage = 0.0;
+	for (const double Coverage : Coverages)
+	{
+		TotalCoverage += Coverage;
+	}
+
+	OutPrefixCoverage.Reset(NUM_PREFIX_SAMPLES);
+	double PrefixCoverage = 0.0;
+	int32 Index = 0;
+	for (int32 Sample = 1; Sample <= NUM_PREFIX_SAMPLES; ++Sample)
+	{
+		const int32 End = int32(int64(NumSplats) * Sample / NUM_PREFIX_SAMPLES);
+		for (; Index < End; ++Index)
+		{
+			PrefixCoverage += Coverages[Index];
+		}
+		OutPrefixCoverage.Add(
+			TotalCoverage > 0.0
+				? float(PrefixCoverage / TotalCoverage)
+				: float(Sample) / NUM_PREFIX_SAMPLES);
+	}
+	OutPrefixCoverage.Last() = 1.f;
+}
+
+} // namespace PICO::Splat
@@ -0,0 +1,31 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "SplatPruning.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Orders splats so that any prefix of them is a spatially even selection of
+ * the most important, and can be drawn in place of all.
+ *
+ * Splats, already sorted along a curve, are split into blocks of neighbours.
+ * Within each block, they are ranked by importance: their opacity times
+ * volume, weighted by how much their color stands out from the block's mean.
+ * Splats are then ordered by their rank relative to the size of their block,
+ * so the first tenth of splats are about the first tenth of every block.
+ *
+ * @param Splats - Splats to order, in place. *Must* be sorted along a curve,
+ * e.g. by `SortSplatsAlongCurve`.
+ * @param OutPrefixCoverage - Returns the fraction of the coverage of every
+ * splat kept by each of evenly spaced prefixes, the last being every splat.
+ */
+void OrderSplatsByImportance(
+	FImportedSplats& Splats, TArray<float>& OutPrefixCoverage);
+
+} // namespace PICO::Splat
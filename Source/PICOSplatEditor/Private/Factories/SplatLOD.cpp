@@ -0,0 +1,312 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatLOD.h"
+
+#include "Math/Box.h"
+#include "Misc/AssertionMacros.h"
+#include "SplatConstants.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+// Most levels built above the original splats.
+constexpr int32 MAX_LEVELS = 24;
+// Each level has at most this fraction of the splats of the level below.
+constexpr int32 REDUCTION = 4;
+// Most children of a parent. Crowded cells are split into several parents.
+constexpr int32 MAX_CHILDREN = 8;
+// Cells along the largest axis of the bounds, for the first level.
+constexpr float FIRST_LEVEL_CELLS = 1024.f;
+// Bits of each cell coordinate in a grid key.
+constexpr int32 CELL_BITS = 21;
+
+/**
+ * Bounds and errors of nodes being built, in meters, already rounded up to
+ * how they are stored.
+ */
+struct FLODBuild
+{
+	TArray<int32> Parents;
+	TArray<float> Radii;
+	TArray<float> Errors;
+	// Added to each parent's radius, so bounds nest even between positions
+	// as packed for the GPU.
+	float PaddingM = 0.f;
+};
+
+/**
+ * @param Value - Value to round, at least 0.
+ * @return The nearest half at least as large as the value.
+ */
+FFloat16 RoundUpToHalf(float Value)
+{
+	FFloat16 Half(Value);
+	if (Half.GetFloat() < Value)
+	{
+		++Half.Encoded;
+	}
+	return Half;
+}
+
+/**
+ * Gets the key of the grid cell a position is in.
+ *
+ * @param Offset - Position, relative to the minimum of the grid, in meters.
+ * @param CellSize - Size of each cell, in meters.
+ * @return Key of the cell.
+ */
+uint64 GetCellKey(const FVector3f& Offset, float CellSize)
+{
+	constexpr uint64 MASK = (uint64(1) << CELL_BITS) - 1;
+	const uint64 X = uint64(FMath::FloorToInt(Offset.X / CellSize));
+	const uint64 Y = uint64(FMath::FloorToInt(Offset.Y / CellSize));
+	const uint64 Z = uint64(FMath::FloorToInt(Offset.Z / CellSize));
+	return ((X & MASK) << (2 * CELL_BITS)) | ((Y & MASK) << CELL_BITS) |
+	       (Z & MASK);
+}
+
+/**
+ * Adds a parent for a group of splats, fit to their coverage-weighted mean and
+ * covariance.
+ *
+ * @param Splats - All splats. Returns with the parent appended.
+ * @param Group - Children of the parent.
+ * @param Build - Nodes built so far. Returns with the parent appended.
+ * @return Index of the parent.
+ */
+int32 AddParent(
+	FImportedSplats& Splats, TConstArrayView<int32> Group, FLODBuild& Build)
+{
+	TArray<double, TInlineAllocator<MAX_CHILDREN>> Weights;
+	double TotalCoverage = 0.0;
+	for (const int32 Index : Group)
+	{
+		const float Coverage = GetSplatCoverage(
+			Splats.Colors[Index], MetersToCentimeters * Splats.Scales[Index]);
+		Weights.Add(FMath::Max(Coverage, UE_SMALL_NUMBER));
+		TotalCoverage += Weights.Last();
+	}
+	for (double& Weight : Weights)
+	{
+		Weight /= TotalCoverage;
+	}
+
+	const int32 Parent = Splats.Num();
+	Splats.Positions.AddUninitialized();
+	Splats.Rotations.AddUninitialized();
+	Splats.Scales.AddUninitialized();
+	Splats.Colors.AddDefaulted();
+	if (Splats.SHDegree > 0)
+	{
+		Splats.SHCoefficients.AddUninitialized(
+			3 * GetNumSHCoefficients(Splats.SHDegree));
+	}
+	FitSplat(Splats, Group, Weights, Parent);
+
+	// Seen from afar, the parent covers about as much as its children did.
+	const FVector3f ScaleCM = MetersToCentimeters * Splats.Scales[Parent];
+	const double Area =
+		FMath::Max(GetSplatCoverage(FColor::Black, ScaleCM), UE_SMALL_NUMBER);
+	Splats.Colors[Parent].A = uint8(
+		FMath::RoundToInt(255.0 * FMath::Min(TotalCoverage / Area, 1.0)));
+
+	// Bounds nest, and errors only grow towards the root, so a parent is never
+	// chosen over a child too detailed to be drawn.
+	const FVector3f& Position = Splats.Positions[Parent];
+	float Radius = 0.f;
+	float Error = FMath::Max(Splats.Scales[Parent].GetMax(), UE_SMALL_NUMBER);
+	for (const int32 Child : Group)
+	{
+		Build.Parents[Child] = Parent;
+		Radius = FMath::Max(
+			Radius,
+			FVector3f::Distance(Splats.Positions[Child], Position) +
+				Build.Radii[Child]);
+		Error = FMath::Max(Error, Build.Errors[Child]);
+	}
+	Build.Parents.Add(INDEX_NONE);
+	Build.Radii.Add(RoundUpToHalf(Radius + Build.PaddingM).GetFloat());
+	Build.Errors.Add(RoundUpToHalf(Error).GetFloat());
+
+	return Parent;
+}
+} // namespace
+
+int32 BuildSplatLOD(FImportedSplats& Splats, TArray<FSplatLODNode>& OutNodes)
+{
+	const int32 NumLeaves = Splats.Num();
+	check(NumLeaves > 0);
+
+	const FBox3f Bounds(Splats.Positions);
+	const FVector3f Extent = Bounds.GetSize();
+	FLODBuild Build;
+	Build.Parents.Init(INDEX_NONE, NumLeaves);
+	Build.Radii.Init(0.f, NumLeaves);
+	Build.Errors.Init(0.f, NumLeaves);
+	// Parents are inside their children's bounds, so do not change the steps
+	// positions are packed in. Each packed position is within half a step
+	// diagonal of its own.
+	Build.PaddingM = (Extent / FPackedPos::MAX).Size();
+
+	TArray<int32> Level;
+	Level.SetNumUninitialized(NumLeaves);
+	for (int32 Index = 0; Index < NumLeaves; ++Index)
+	{
+		Level[Index] = Index;
+	}
+
+	TArray<TPair<uint64, int32>> Cells;
+	TArray<int32> NextLevel;
+	TArray<int32, TInlineAllocator<MAX_CHILDREN>> Group;
+	float CellSize =
+		FMath::Max(Extent.GetMax() / FIRST_LEVEL_CELLS, UE_KINDA_SMALL_NUMBER);
+	int32 NumLevels = 0;
+	while (Level.Num() > 1 && NumLevels < MAX_LEVELS)
+	{
+		// Coarsen the grid until it has few enough occupied cells, or one.
+		// Sorting by cell keeps each cell's splats contiguous, in the order
+		// they were added, which is itself by cell a level finer.
+		int32 NumCells = 0;
+		for (;;)
+		{
+			Cells.Reset();
+			for (const int32 Node : Level)
+			{
+				Cells.Emplace(
+					GetCellKey(Splats.Positions[Node] - Bounds.Min, CellSize),
+					Node);
+			}
+			Cells.Sort();
+
+			NumCells = 1;
+			for (int32 Index = 1; Index < Cells.Num(); ++Index)
+			{
+				NumCells += Cells[Index].Key != Cells[Index - 1].Key;
+			}
+			if (NumCells * REDUCTION <= Level.Num() || NumCells == 1)
+			{
+				break;
+			}
+			CellSize *= 2.f;
+		}
+
+		NextLevel.Reset();
+		for (int32 Begin = 0; Begin < Cells.Num();)
+		{
+			int32 End = Begin + 1;
+			while (End < Cells.Num() && Cells[End].Key == Cells[Begin].Key)
+			{
+				++End;
+			}
+
+			// Crowded cells are split evenly into runs of neighbours.
+			const int32 Size = End - Begin;
+			const int32 NumGroups = FMath::DivideAndRoundUp(Size, MAX_CHILDREN);
+			for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+			{
+				const int32 First = Begin + Size * GroupIndex / NumGroups;
+				const int32 Last = Begin + Size * (GroupIndex + 1) / NumGroups;
+				if (Last - First == 1)
+				{
+					NextLevel.Add(Cells[First].Value);
+					continue;
+				}
+
+				Group.Reset();
+				for (int32 Member = First; Member < Last; ++Member)
+				{
+					Group.Add(Cells[Member].Value);
+				}
+				NextLevel.Add(AddParent(Splats, Group, Build));
+			}
+			Begin = End;
+		}
+
+		Swap(Level, NextLevel);
+		CellSize *= 2.f;
+		++NumLevels;
+	}
+
+	// Count the splats of each subtree. Parents are added after their
+	// children, so each count is complete before it is added to its parent's.
+	const int32 NumNodes = Splats.Num();
+	TArray<int32> Sizes;
+	Sizes.Init(1, NumNodes);
+	TArray<int32> FirstChild;
+	FirstChild.Init(0, NumNodes + 1);
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		const int32 Parent = Build.Parents[Node];
+		if (Parent != INDEX_NONE)
+		{
+			Sizes[Parent] += Sizes[Node];
+			++FirstChild[Parent + 1];
+		}
+	}
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		FirstChild[Node + 1] += FirstChild[Node];
+	}
+	TArray<int32> Children;
+	Children.SetNumUninitialized(FirstChild[NumNodes]);
+	TArray<int32> ChildCursors(FirstChild.GetData(), NumNodes);
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		const int32 Parent = Build.Parents[Node];
+		if (Parent != INDEX_NONE)
+		{
+			Children[ChildCursors[Parent]++] = Node;
+		}
+	}
+
+	// Place roots one after another, then each node's children after it, in
+	// the order they were added. Parents come after their children, so are
+	// placed first when walking backwards.
+	TArray<int32> Placements;
+	Placements.Init(INDEX_NONE, NumNodes);
+	int32 Cursor = 0;
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		if (Build.Parents[Node] == INDEX_NONE)
+		{
+			Placements[Node] = Cursor;
+			Cursor += Sizes[Node];
+		}
+	}
+	check(Cursor == NumNodes);
+	for (int32 Node = NumNodes - 1; Node >= 0; --Node)
+	{
+		int32 Next = Placements[Node] + 1;
+		for (int32 Child = FirstChild[Node]; Child < FirstChild[Node + 1];
+		     ++Child)
+		{
+			Placements[Children[Child]] = Next;
+			Next += Sizes[Children[Child]];
+		}
+	}
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumNodes);
+	OutNodes.SetNumUninitialized(NumNodes);
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		const int32 Placement = Placements[Node];
+		const int32 Parent = Build.Parents[Node];
+		Order[Placement] = Node;
+
+		FSplatLODNode& Out = OutNodes[Placement];
+		Out.SubtreeEnd = uint32(Placement + Sizes[Node]);
+		Out.Parent = Parent == INDEX_NONE ? INDEX_NONE : Placements[Parent];
+		Out.BoundsRadius = FFloat16(Build.Radii[Node]);
+		Out.Error = FFloat16(Build.Errors[Node]);
+	}
+
+	ReorderSplats(Splats, Order);
+
+	return NumLevels;
+}
+
+} // namespace PICO::Splat
@@ -0,0 +1,33 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "PackedTypes.h"
+#include "SplatPruning.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Builds a level of detail hierarchy over splats, adding coarser splats as
+ * parents of finer ones.
+ *
+ * Levels are built bottom up. Each groups the splats of the level below by the
+ * cells of a grid, coarsened until there are at most a quarter as many cells
+ * as splats, and replaces each group with a parent preserving its mean and
+ * covariance, as merging does when pruning. Parents are as opaque as needed to
+ * cover as much as their children, and their error is the largest scale of any
+ * parent in their subtree. Splats are then reordered into pre-order, so each
+ * subtree is contiguous (see `FSplatLODNode`).
+ *
+ * @param Splats - Splats to build over, in place. Returns with parents added,
+ * and every splat in pre-order.
+ * @param OutNodes - Returns the node of each splat.
+ * @return The number of levels built above the original splats.
+ */
+int32 BuildSplatLOD(FImportedSplats& Splats, TArray<FSplatLODNode>& OutNodes);
+
+} // namespace PICO::Splat
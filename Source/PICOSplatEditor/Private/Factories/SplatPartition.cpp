@@ -0,0 +1,466 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatPartition.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Logging.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "SplatConstants.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+// Splats read from the spill file at once.
+constexpr int32 SPILL_WINDOW_SIZE = 64 * 1024;
+// Largest number of clusters, as each holds a write buffer while
+// distributing.
+constexpr int32 MAX_CLUSTERS = 1024;
+// Size of each cluster's write buffer, in bytes.
+constexpr int32 CLUSTER_BUFFER_SIZE = 32 * 1024;
+// Largest number of splats whose spherical harmonics are sampled.
+constexpr int32 MAX_SH_SAMPLES = 64 * 1024;
+
+// Layout of each splat in the temporary files, followed by its spherical
+// harmonics.
+constexpr int32 POSITION_OFFSET = 0;
+constexpr int32 ROTATION_OFFSET = POSITION_OFFSET + sizeof(FVector3f);
+constexpr int32 SCALE_OFFSET = ROTATION_OFFSET + sizeof(FQuat4f);
+constexpr int32 COLOR_OFFSET = SCALE_OFFSET + sizeof(FVector3f);
+constexpr int32 SH_OFFSET = COLOR_OFFSET + sizeof(FColor);
+
+/**
+ * Reads a field of a splat in a temporary file.
+ *
+ * @param Record - The splat.
+ * @param Offset - Offset of the field, in bytes.
+ * @return The field.
+ */
+template <typename T> T ReadField(const uint8* Record, int32 Offset)
+{
+	T Result;
+	FMemory::Memcpy(&Result, Record + Offset, sizeof(T));
+	return Result;
+}
+
+/**
+ * Writes a splat as stored in the temporary files.
+ *
+ * @param Splats - Splats holding the splat.
+ * @param Index - Index of the splat.
+ * @param SHDimension - Number of spherical harmonics coefficients per splat.
+ * @param OutRecord - Returns the splat.
+ */
+void WriteRecord(
+	const FImportedSplats& Splats,
+	int32 Index,
+	int32 SHDimension,
+	uint8* OutRecord)
+{
+	FMemory::Memcpy(
+		OutRecord + POSITION_OFFSET,
+		&Splats.Positions[Index],
+		sizeof(FVector3f));
+	FMemory::Memcpy(
+		OutRecord + ROTATION_OFFSET, &Splats.Rotations[Index], sizeof(FQuat4f));
+	FMemory::Memcpy(
+		OutRecord + SCALE_OFFSET, &Splats.Scales[Index], sizeof(FVector3f));
+	FMemory::Memcpy(
+		OutRecord + COLOR_OFFSET, &Splats.Colors[Index], sizeof(FColor));
+	if (SHDimension > 0)
+	{
+		FMemory::Memcpy(
+			OutRecord + SH_OFFSET,
+			&Splats.SHCoefficients[Index * SHDimension],
+			SHDimension * sizeof(float));
+	}
+}
+
+/**
+ * Reads a splat as stored in the temporary files.
+ *
+ * @param Record - The splat.
+ * @param SHDimension - Number of spherical harmonics coefficients per splat.
+ * @param OutSplats - Splats to return the splat in. *Must* be large enough.
+ * @param Index - Index to return the splat at.
+ */
+void ReadRecord(
+	const uint8* Record,
+	int32 SHDimension,
+	FImportedSplats& OutSplats,
+	int32 Index)
+{
+	OutSplats.Positions[Index] = ReadField<FVector3f>(Record, POSITION_OFFSET);
+	OutSplats.Rotations[Index] = ReadField<FQuat4f>(Record, ROTATION_OFFSET);
+	OutSplats.Scales[Index] = ReadField<FVector3f>(Record, SCALE_OFFSET);
+	OutSplats.Colors[Index] = ReadField<FColor>(Record, COLOR_OFFSET);
+	if (SHDimension > 0)
+	{
+		FMemory::Memcpy(
+			&OutSplats.SHCoefficients[Index * SHDimension],
+			Record + SH_OFFSET,
+			SHDimension * sizeof(float));
+	}
+}
+} // namespace
+
+FSplatPartitioner::FSplatPartitioner(uint32 InSHDegree)
+	: SHDegree(InSHDegree)
+	, SHDimension(3 * GetNumSHCoefficients(InSHDegree))
+{
+	const FString Directory = FPaths::ProjectIntermediateDir();
+	SpillFilename = FPaths::CreateTempFilename(
+		*Directory, TEXT("SplatSpill"), TEXT(".tmp"));
+	PartitionFilename = FPaths::CreateTempFilename(
+		*Directory, TEXT("SplatPartition"), TEXT(".tmp"));
+
+	SpillWriter.Reset(IFileManager::Get().CreateFileWriter(*SpillFilename));
+	if (!SpillWriter)
+	{
+		PICO_LOGE("Failed to create %s.", *SpillFilename);
+	}
+}
+
+FSplatPartitioner::~FSplatPartitioner()
+{
+	SpillWriter.Reset();
+	IFileManager::Get().Delete(*SpillFilename, false, false, true);
+	IFileManager::Get().Delete(*PartitionFilename, false, false, true);
+}
+
+bool FSplatPartitioner::Add(const FImportedSplats& Window)
+{
+	check(Window.SHDegree == SHDegree);
+	if (!SpillWriter)
+	{
+		return false;
+	}
+
+	const int32 RecordSize = GetRecordSize();
+	TArray<uint8> Records;
+	Records.SetNumUninitialized(Window.Num() * RecordSize);
+	ParallelFor(
+		Window.Num(),
+		[&](int32 Index)
+		{
+			WriteRecord(
+				Window, Index, SHDimension, &Records[Index * RecordSize]);
+		});
+	SpillWriter->Serialize(Records.GetData(), Records.Num());
+	if (SpillWriter->IsError())
+	{
+		PICO_LOGE("Failed to write %s.", *SpillFilename);
+		return false;
+	}
+
+	for (const FVector3f& Position : Window.Positions)
+	{
+		Bounds += Position;
+	}
+
+	// Reservoir sampling, so every splat added is equally likely to be kept.
+	for (int32 Index = 0; Index < Window.Num() && SHDimension > 0; ++Index)
+	{
+		const int32 Seen = NumSplats + Index;
+		const int32 Row =
+			Seen < MAX_SH_SAMPLES ? Seen : SHRandom.RandRange(0, Seen);
+		if (Row >= MAX_SH_SAMPLES)
+		{
+			continue;
+		}
+		if (Row * SHDimension == SHSample.Num())
+		{
+			SHSample.AddUninitialized(SHDimension);
+		}
+		FMemory::Memcpy(
+			&SHSample[Row * SHDimension],
+			&Window.SHCoefficients[Index * SHDimension],
+			SHDimension * sizeof(float));
+	}
+
+	NumSplats += Window.Num();
+	return true;
+}
+
+bool FSplatPartitioner::Partition(int32 TargetClusterSize)
+{
+	check(TargetClusterSize > 0);
+	if (!SpillWriter)
+	{
+		return false;
+	}
+	SpillWriter->Close();
+	const bool bSpillError = SpillWriter->IsError();
+	SpillWriter.Reset();
+	if (bSpillError)
+	{
+		PICO_LOGE("Failed to write %s.", *SpillFilename);
+		return false;
+	}
+	if (NumSplats == 0)
+	{
+		return true;
+	}
+
+	// Halve the longest side of the cells until there are about as many as
+	// clusters wanted.
+	const int32 NumTargetClusters = FMath::Clamp(
+		FMath::DivideAndRoundUp(NumSplats, TargetClusterSize), 1, MAX_CLUSTERS);
+	const FVector3f Extent = Bounds.GetSize();
+	GridSize = FIntVector(1);
+	while (2 * GridSize.X * GridSize.Y * GridSize.Z <= NumTargetClusters)
+	{
+		int32 Longest = 0;
+		for (int32 Axis = 1; Axis < 3; ++Axis)
+		{
+			if (Extent[Axis] / GridSize[Axis] >
+			    Extent[Longest] / GridSize[Longest])
+			{
+				Longest = Axis;
+			}
+		}
+		GridSize[Longest] *= 2;
+	}
+
+	// Count splats into cells, gathering statistics of each.
+	const int32 NumCells = GridSize.X * GridSize.Y * GridSize.Z;
+	TArray<FSplatCluster> Cells;
+	Cells.SetNum(NumCells);
+	TArray<double> OpacitySums;
+	OpacitySums.Init(0.0, NumCells);
+	const int32 RecordSize = GetRecordSize();
+	bool bSuccess = ReadSpilled(
+		[&](const uint8* Records, int32 Num)
+		{
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				const uint8* Record = Records + Index * RecordSize;
+				const FVector3f Position =
+					ReadField<FVector3f>(Record, POSITION_OFFSET);
+				const int32 Cell = FindCell(Position);
+				FSplatCluster& Cluster = Cells[Cell];
+				++Cluster.Num;
+				Cluster.Bounds += Position;
+				Cluster.MaxScale = FMath::Max(
+					Cluster.MaxScale,
+					ReadField<FVector3f>(Record, SCALE_OFFSET).GetMax());
+				OpacitySums[Cell] +=
+					ReadField<FColor>(Record, COLOR_OFFSET).A / 255.0;
+			}
+		});
+	if (!bSuccess)
+	{
+		return false;
+	}
+
+	// Empty cells are dropped, and the rest laid out in cell order.
+	CellClusters.Init(INDEX_NONE, NumCells);
+	Clusters.Reset();
+	int32 First = 0;
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		FSplatCluster& Cluster = Cells[Cell];
+		if (Cluster.Num == 0)
+		{
+			continue;
+		}
+		Cluster.First = First;
+		Cluster.MeanOpacity = float(OpacitySums[Cell] / Cluster.Num);
+		First += Cluster.Num;
+		CellClusters[Cell] = Clusters.Add(Cluster);
+	}
+	check(First == NumSplats);
+
+	// Distribute splats to their clusters' ranges of the partition file,
+	// buffering writes to each.
+	TUniquePtr<FArchive> Writer(
+		IFileManager::Get().CreateFileWriter(*PartitionFilename));
+	if (!Writer)
+	{
+		PICO_LOGE("Failed to create %s.", *PartitionFilename);
+		return false;
+	}
+	const int32 BufferSize =
+		FMath::Max(CLUSTER_BUFFER_SIZE / RecordSize, 1) * RecordSize;
+	TArray<TArray<uint8>> Buffers;
+	Buffers.SetNum(Clusters.Num());
+	TArray<int32> NumWritten;
+	NumWritten.Init(0, Clusters.Num());
+	auto Flush = [&](int32 Cluster)
+	{
+		TArray<uint8>& Buffer = Buffers[Cluster];
+		Writer->Seek(
+			int64(Clusters[Cluster].First + NumWritten[Cluster]) * RecordSize);
+		Writer->Serialize(Buffer.GetData(), Buffer.Num());
+		NumWritten[Cluster] += Buffer.Num() / RecordSize;
+		Buffer.Reset();
+	};
+	bSuccess = ReadSpilled(
+		[&](const uint8* Records, int32 Num)
+		{
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				const uint8* Record = Records + Index * RecordSize;
+				const int32 Cluster = CellClusters[FindCell(
+					ReadField<FVector3f>(Record, POSITION_OFFSET))];
+				TArray<uint8>& Buffer = Buffers[Cluster];
+				Buffer.Reserve(BufferSize);
+				Buffer.Append(Record, RecordSize);
+				if (Buffer.Num() == BufferSize)
+				{
+					Flush(Cluster);
+				}
+			}
+		});
+	if (!bSuccess)
+	{
+		return false;
+	}
+	for (int32 Cluster = 0; Cluster < Clusters.Num(); ++Cluster)
+	{
+		if (!Buffers[Cluster].IsEmpty())
+		{
+			Flush(Cluster);
+		}
+		check(NumWritten[Cluster] == Clusters[Cluster].Num);
+	}
+	Writer->Close();
+	if (Writer->IsError())
+	{
+		PICO_LOGE("Failed to write %s.", *PartitionFilename);
+		return false;
+	}
+
+	// Only the partition file is read from now on.
+	IFileManager::Get().Delete(*SpillFilename, false, false, true);
+	return true;
+}
+
+bool FSplatPartitioner::Read(
+	int32 WindowSize,
+	TFunctionRef<void(int32 First, const FImportedSplats& Window)> Visit)
+{
+	check(WindowSize > 0);
+	if (NumSplats == 0)
+	{
+		return true;
+	}
+
+	TUniquePtr<FArchive> Reader(
+		IFileManager::Get().CreateFileReader(*PartitionFilename));
+	if (!Reader)
+	{
+		PICO_LOGE("Failed to open %s.", *PartitionFilename);
+		return false;
+	}
+
+	const int32 RecordSize = GetRecordSize();
+	TArray<uint8> Records;
+	FImportedSplats Window;
+	Window.SHDegree = SHDegree;
+	const int32 NumWindows = FMath::DivideAndRoundUp(NumSplats, WindowSize);
+	FScopedSlowTask SlowTask(NumWindows);
+	for (int32 Index = 0; Index < NumWindows; ++Index)
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			return false;
+		}
+		SlowTask.EnterProgressFrame();
+
+		const int32 First = Index * WindowSize;
+		const int32 Num = FMath::Min(WindowSize, NumSplats - First);
+		Records.SetNumUninitialized(Num * RecordSize);
+		Reader->Serialize(Records.GetData(), Records.Num());
+		if (Reader->IsError())
+		{
+			PICO_LOGE("Failed to read %s.", *PartitionFilename);
+			return false;
+		}
+
+		Window.Positions.SetNumUninitialized(Num);
+		Window.Rotations.SetNumUninitialized(Num);
+		Window.Scales.SetNumUninitialized(Num);
+		Window.Colors.SetNumUninitialized(Num);
+		Window.SHCoefficients.SetNumUninitialized(Num * SHDimension);
+		ParallelFor(
+			Num,
+			[&](int32 Splat)
+			{
+				ReadRecord(
+					&Records[Splat * RecordSize], SHDimension, Window, Splat);
+			});
+		Visit(First, Window);
+	}
+
+	return true;
+}
+
+int32 FSplatPartitioner::GetRecordSize() const
+{
+	return SH_OFFSET + SHDimension * sizeof(float);
+}
+
+int32 FSplatPartitioner::FindCell(const FVector3f& Position) const
+{
+	const FVector3f Extent =
+		Bounds.GetSize().ComponentMax(FVector3f(UE_KINDA_SMALL_NUMBER));
+	int32 Cell = 0;
+	for (int32 Axis = 2; Axis >= 0; --Axis)
+	{
+		const int32 Coordinate = FMath::Clamp(
+			int32(
+				GridSize[Axis] * (Position[Axis] - Bounds.Min[Axis]) /
+				Extent[Axis]),
+			0,
+			GridSize[Axis] - 1);
+		Cell = Cell * GridSize[Axis] + Coordinate;
+	}
+	return Cell;
+}
+
+bool FSplatPartitioner::ReadSpilled(
+	TFunctionRef<void(const uint8* Records, int32 Num)> Visit)
+{
+	TUniquePtr<FArchive> Reader(
+		IFileManager::Get().CreateFileReader(*SpillFilename));
+	if (!Reader)
+	{
+		PICO_LOGE("Failed to open %s.", *SpillFilename);
+		return false;
+	}
+
+	const int32 RecordSize = GetRecordSize();
+	TArray<uint8> Records;
+	const int32 NumWindows =
+		FMath::DivideAndRoundUp(NumSplats, SPILL_WINDOW_SIZE);
+	FScopedSlowTask SlowTask(NumWindows);
+	for (int32 Index = 0; Index < NumWindows; ++Index)
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			return false;
+		}
+		SlowTask.EnterProgressFrame();
+
+		const int32 First = Index * SPILL_WINDOW_SIZE;
+		const int32 Num = FMath::Min(SPILL_WINDOW_SIZE, NumSplats - First);
+		Records.SetNumUninitialized(Num * RecordSize);
+		Reader->Serialize(Records.GetData(), Records.Num());
+		if (Reader->IsError())
+		{
+			PICO_LOGE("Failed to read %s.", *SpillFilename);
+			return false;
+		}
+		Visit(Records.GetData(), Num);
+	}
+
+	return true;
+}
+
+} // namespace PICO::Splat
@@ -0,0 +1,157 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/UnrealString.h"
+#include "Math/Box.h"
+#include "Math/IntVector.h"
+#include "Math/RandomStream.h"
+#include "Serialization/Archive.h"
+#include "SplatPruning.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Statistics of a spatial cluster of splats, which are contiguous once
+ * partitioned.
+ */
+struct FSplatCluster
+{
+	// Index of the first splat.
+	int32 First = 0;
+	int32 Num = 0;
+	// Bounds of the splats' positions, in meters.
+	FBox3f Bounds = FBox3f(ForceInit);
+	// Largest scale of any splat, in meters.
+	float MaxScale = 0.f;
+	// Mean opacity of the splats, in [0, 1].
+	float MeanOpacity = 0.f;
+};
+
+/**
+ * Groups splats into spatial clusters out of core, for imports too large to
+ * hold unpacked.
+ *
+ * Splats are added a window at a time and spilled to a temporary file. Once
+ * all are added, they are counted into a grid over their bounds, distributed
+ * by cluster into a second temporary file, then read back a window at a time,
+ * cluster by cluster. Memory is bounded by a window and a write buffer per
+ * cluster, whatever the number of splats.
+ */
+class FSplatPartitioner
+{
+public:
+	/**
+	 * @param InSHDegree - Degree of the spherical harmonics of every splat
+	 * added, or 0 if there are none.
+	 */
+	explicit FSplatPartitioner(uint32 InSHDegree);
+
+	/**
+	 * Deletes temporary files.
+	 */
+	~FSplatPartitioner();
+
+	/**
+	 * Spills a window of splats. *Must not* be called once partitioned.
+	 *
+	 * @param Window - Splats to add.
+	 * @return False, if they could not be written.
+	 */
+	bool Add(const FImportedSplats& Window);
+
+	/**
+	 * Groups added splats into clusters of about a given size.
+	 *
+	 * @param TargetClusterSize - Number of splats per cluster, were splats
+	 * spread evenly over their bounds.
+	 * @return False, if cancelled, or splats could not be read or written.
+	 */
+	bool Partition(int32 TargetClusterSize);
+
+	/**
+	 * Reads partitioned splats a window at a time, in cluster order.
+	 *
+	 * @param WindowSize - Largest number of splats per window.
+	 * @param Visit - Called with the index of the first splat of each window,
+	 * and its splats.
+	 * @return False, if cancelled, or splats could not be read.
+	 */
+	bool Read(
+		int32 WindowSize,
+		TFunctionRef<void(int32 First, const FImportedSplats& Window)> Visit);
+
+	/**
+	 * @return The number of splats added.
+	 */
+	int32 Num() const { return NumSplats; }
+
+	/**
+	 * @return Bounds of the splats' positions, in meters.
+	 */
+	const FBox3f& GetBounds() const { return Bounds; }
+
+	/**
+	 * @return The clusters, in order, once partitioned.
+	 */
+	TConstArrayView<FSplatCluster> GetClusters() const { return Clusters; }
+
+	/**
+	 * Gets the spherical harmonics of a uniform sample of the splats added, to
+	 * find the range of each coefficient from.
+	 *
+	 * @return The coefficients of each sampled splat, as in `FImportedSplats`.
+	 */
+	TConstArrayView<float> GetSHSample() const { return SHSample; }
+
+private:
+	/**
+	 * @return Size of each splat in the temporary files, in bytes.
+	 */
+	int32 GetRecordSize() const;
+
+	/**
+	 * @param Position - Position of a splat, in meters.
+	 * @return Index of the grid cell holding the position.
+	 */
+	int32 FindCell(const FVector3f& Position) const;
+
+	/**
+	 * Reads every spilled splat a window at a time, with progress.
+	 *
+	 * @param Visit - Called with each window of records, and their number.
+	 * @return False, if cancelled, or splats could not be read.
+	 */
+	bool ReadSpilled(TFunctionRef<void(const uint8* Records, int32 Num)> Visit);
+
+	uint32 SHDegree = 0;
+	// Number of coefficients per splat.
+	int32 SHDimension = 0;
+
+	FString SpillFilename;
+	FString PartitionFilename;
+	TUniquePtr<FArchive> SpillWriter;
+
+	int32 NumSplats = 0;
+	FBox3f Bounds = FBox3f(ForceInit);
+
+	// Number of grid cells along each axis, and the cluster of each cell, or
+	// `INDEX_NONE` if it is empty.
+	FIntVector GridSize = FIntVector(1);
+	TArray<int32> CellClusters;
+	TArray<FSplatCluster> Clusters;
+
+	// Reservoir of sampled spherical harmonics, and the generator deciding
+	// which splats are kept in it.
+	TArray<float> SHSample;
+	FRandomStream SHRandom;
+};
+
+} // namespace PICO::Splat
@@ -0,0 +1,498 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatPruning.h"
+
+#include "Async/ParallelFor.h"
+#include "Containers/BitArray.h"
+#include "Containers/Map.h"
+#include "Math/RotationMatrix.h"
+#include "Misc/AssertionMacros.h"
+#include "SplatConstants.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+constexpr int32 MAX_JACOBI_SWEEPS = 16;
+// Largest difference in any color channel, out of 255, between splats merged.
+constexpr int32 MAX_MERGE_COLOR_DIFFERENCE = 8;
+// Largest ratio between the sizes of splats merged.
+constexpr float MAX_MERGE_SCALE_RATIO = 1.5f;
+// Bits of each cell coordinate in a spatial hash key.
+constexpr int32 CELL_BITS = 21;
+
+/**
+ * Diagonalizes a symmetric 3x3 matrix with Jacobi rotations.
+ *
+ * @param A - Matrix to diagonalize. Returns with eigenvalues on its diagonal.
+ * @param OutVectors - Returns eigenvectors, as columns.
+ */
+void Diagonalize(double A[3][3], double OutVectors[3][3])
+{
+	for (int32 Row = 0; Row < 3; ++Row)
+	{
+		for (int32 Column = 0; Column < 3; ++Column)
+		{
+			OutVectors[Row][Column] = Row == Column ? 1.0 : 0.0;
+		}
+	}
+
+	for (int32 Sweep = 0; Sweep < MAX_JACOBI_SWEEPS; ++Sweep)
+	{
+		const double OffDiagonal =
+			FMath::Abs(A[0][1]) + FMath::Abs(A[0][2]) + FMath::Abs(A[1][2]);
+		if (OffDiagonal < UE_DOUBLE_SMALL_NUMBER)
+		{
+			return;
+		}
+
+		for (int32 P = 0; P < 2; ++P)
+		{
+			for (int32 Q = P + 1; Q < 3; ++Q)
+			{
+				if (FMath::Abs(A[P][Q]) < UE_DOUBLE_SMALL_NUMBER)
+				{
+					continue;
+				}
+
+				// Rotate to zero A[P][Q].
+				const double Theta = (A[Q][Q] - A[P][P]) / (2.0 * A[P][Q]);
+				const double T =
+					(Theta >= 0.0 ? 1.0 : -1.0) /
+					(FMath::Abs(Theta) + FMath::Sqrt(Theta * Theta + 1.0));
+				const double C = 1.0 / FMath::Sqrt(T * T + 1.0);
+				const double S = T * C;
+				for (int32 K = 0; K < 3; ++K)
+				{
+					const double KP = A[K][P];
+					const double KQ = A[K][Q];
+					A[K][P] = C * KP - S * KQ;
+					A[K][Q] = S * KP + C * KQ;
+				}
+				for (int32 K = 0; K < 3; ++K)
+				{
+					const double PK = A[P][K];
+					const double QK = A[Q][K];
+					A[P][K] = C * PK - S * QK;
+					A[Q][K] = S * PK + C * QK;
+				}
+				for (int32 K = 0; K < 3; ++K)
+				{
+					const double KP = OutVectors[K][P];
+					const double KQ = OutVectors[K][Q];
+					OutVectors[K][P] = C * KP - S * KQ;
+					OutVectors[K][Q] = S * KP + C * KQ;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Gets the cell of a spatial hash a position is in.
+ *
+ * @param PositionCM - Position, in centimeters.
+ * @param CellSizeCM - Size of each cell, in centimeters.
+ * @return Coordinates of the cell.
+ */
+FIntVector GetCell(const FVector3f& PositionCM, float CellSizeCM)
+{
+	return FIntVector(
+		FMath::FloorToInt(PositionCM.X / CellSizeCM),
+		FMath::FloorToInt(PositionCM.Y / CellSizeCM),
+		FMath::FloorToInt(PositionCM.Z / CellSizeCM));
+}
+
+/**
+ * Gets the spatial hash key of a cell.
+ *
+ * @param Cell - Coordinates of the cell.
+ * @return Key of the cell. Distant cells may share keys.
+ */
+uint64 GetCellKey(const FIntVector& Cell)
+{
+	constexpr uint64 MASK = (uint64(1) << CELL_BITS) - 1;
+	return ((uint64(Cell.X) & MASK) << (2 * CELL_BITS)) |
+	       ((uint64(Cell.Y) & MASK) << CELL_BITS) | (uint64(Cell.Z) & MASK);
+}
+
+/**
+ * @return Whether two splats are similar enough to be merged.
+ */
+bool CanMerge(
+	const FImportedSplats& Splats, int32 A, int32 B, float MaxDistanceCM)
+{
+	const FColor& ColorA = Splats.Colors[A];
+	const FColor& ColorB = Splats.Colors[B];
+	if (FMath::Abs(ColorA.R - ColorB.R) > MAX_MERGE_COLOR_DIFFERENCE ||
+	    FMath::Abs(ColorA.G - ColorB.G) > MAX_MERGE_COLOR_DIFFERENCE ||
+	    FMath::Abs(ColorA.B - ColorB.B) > MAX_MERGE_COLOR_DIFFERENCE)
+	{
+		return false;
+	}
+
+	const float ScaleA = Splats.Scales[A].GetMax();
+	const float ScaleB = Splats.Scales[B].GetMax();
+	if (FMath::Max(ScaleA, ScaleB) >
+	    MAX_MERGE_SCALE_RATIO * FMath::Min(ScaleA, ScaleB))
+	{
+		return false;
+	}
+
+	const float DistanceCM = MetersToCentimeters *
+	                         FVector3f::Distance(
+								 Splats.Positions[A], Splats.Positions[B]);
+	return DistanceCM <= MaxDistanceCM;
+}
+
+/**
+ * Replaces the first of a group of splats with one preserving the group's
+ * coverage-weighted mean and covariance. Colors and spherical harmonics are
+ * averaged, and opacities composited, as duplicates overlap.
+ *
+ * @param Splats - All splats.
+ * @param Group - Splats to merge. The first is overwritten.
+ * @return Change in coverage, in cm^2.
+ */
+float Merge(FImportedSplats& Splats, TConstArrayView<int32> Group)
+{
+	TArray<double, TInlineAllocator<16>> Weights;
+	double TotalWeight = 0.0;
+	float CoverageBefore = 0.f;
+	double Transmittance = 1.0;
+	for (const int32 Index : Group)
+	{
+		const float Coverage = GetSplatCoverage(
+			Splats.Colors[Index], MetersToCentimeters * Splats.Scales[Index]);
+		CoverageBefore += Coverage;
+		Weights.Add(FMath::Max(Coverage, UE_SMALL_NUMBER));
+		TotalWeight += Weights.Last();
+		Transmittance *= 1.0 - Splats.Colors[Index].A / 255.0;
+	}
+	for (double& Weight : Weights)
+	{
+		Weight /= TotalWeight;
+	}
+
+	const int32 First = Group[0];
+	FitSplat(Splats, Group, Weights, First);
+	Splats.Colors[First].A =
+		uint8(FMath::RoundToInt(255.0 * (1.0 - Transmittance)));
+
+	return FMath::Abs(
+		GetSplatCoverage(
+			Splats.Colors[First], MetersToCentimeters * Splats.Scales[First]) -
+		CoverageBefore);
+}
+
+/**
+ * Reorders per-splat values.
+ *
+ * @param Values - Values to reorder, `Stride` per splat.
+ * @param Order - Index of the splat to move to each position.
+ * @param Stride - Number of values per splat.
+ */
+template <typename T>
+void Reorder(TArray<T>& Values, TConstArrayView<int32> Order, int32 Stride)
+{
+	check(Values.Num() == Order.Num() * Stride);
+
+	TArray<T> Reordered;
+	Reordered.SetNumUninitialized(Values.Num());
+	ParallelFor(
+		TEXT("SplatReorder"),
+		Order.Num(),
+		16 * 1024,
+		[&](int32 Index)
+		{
+			FMemory::Memcpy(
+				&Reordered[Index * Stride],
+				&Values[Order[Index] * Stride],
+				Stride * sizeof(T));
+		});
+	Values = MoveTemp(Reordered);
+}
+} // namespace
+
+float GetSplatCoverage(const FColor& Color, const FVector3f& ScaleCM)
+{
+	const float Largest = ScaleCM.GetMax();
+	const float Smallest = ScaleCM.GetMin();
+	const float Middle = ScaleCM.X + ScaleCM.Y + ScaleCM.Z - Largest - Smallest;
+	return Color.A / 255.f * UE_PI * Largest * Middle;
+}
+
+void FitSplat(
+	FImportedSplats& Splats,
+	TConstArrayView<int32> Group,
+	TConstArrayView<double> Weights,
+	int32 Target)
+{
+	check(Weights.Num() == Group.Num());
+
+	FVector3d Mean = FVector3d::ZeroVector;
+	FVector3d Color = FVector3d::ZeroVector;
+	for (int32 Member = 0; Member < Group.Num(); ++Member)
+	{
+		const int32 Index = Group[Member];
+		const FColor& Splat = Splats.Colors[Index];
+		Mean += Weights[Member] * FVector3d(Splats.Positions[Index]);
+		Color += Weights[Member] * FVector3d(Splat.R, Splat.G, Splat.B);
+	}
+
+	// Covariance of the mixture: each splat's own, plus its offset from the
+	// mean.
+	double Sigma[3][3] = {};
+	for (int32 Member = 0; Member < Group.Num(); ++Member)
+	{
+		const int32 Index = Group[Member];
+		const FVector3f ScaleCM = MetersToCentimeters * Splats.Scales[Index];
+		const FMatrix44f R = FRotationMatrix44f::Make(Splats.Rotations[Index]);
+		const FVector3d Offset =
+			MetersToCentimeters * (FVector3d(Splats.Positions[Index]) - Mean);
+		for (int32 Row = 0; Row < 3; ++Row)
+		{
+			for (int32 Column = 0; Column < 3; ++Column)
+			{
+				// Σ = Rᵀ S² R, with row vectors.
+				double Own = 0.0;
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Own += R.M[Axis][Row] * FMath::Square(ScaleCM[Axis]) *
+					       R.M[Axis][Column];
+				}
+				Sigma[Row][Column] +=
+					Weights[Member] * (Own + Offset[Row] * Offset[Column]);
+			}
+		}
+	}
+
+	// Every member is read before the target, which may be one, is written.
+	if (Splats.SHDegree > 0)
+	{
+		const int32 Dimension = 3 * GetNumSHCoefficients(Splats.SHDegree);
+		TArray<double, TInlineAllocator<45>> Sum;
+		Sum.Init(0.0, Dimension);
+		for (int32 Member = 0; Member < Group.Num(); ++Member)
+		{
+			const float* Coefficients =
+				&Splats.SHCoefficients[Group[Member] * Dimension];
+			for (int32 Offset = 0; Offset < Dimension; ++Offset)
+			{
+				Sum[Offset] += Weights[Member] * Coefficients[Offset];
+			}
+		}
+		for (int32 Offset = 0; Offset < Dimension; ++Offset)
+		{
+			Splats.SHCoefficients[Target * Dimension + Offset] =
+				float(Sum[Offset]);
+		}
+	}
+
+	// Eigenvectors of Σ are the rows of the fitted rotation matrix.
+	double Vectors[3][3];
+	Diagonalize(Sigma, Vectors);
+	FMatrix44f Rotation = FMatrix44f::Identity;
+	for (int32 Row = 0; Row < 3; ++Row)
+	{
+		for (int32 Column = 0; Column < 3; ++Column)
+		{
+			Rotation.M[Row][Column] = float(Vectors[Column][Row]);
+		}
+	}
+	if (Rotation.RotDeterminant() < 0.f)
+	{
+		Rotation.M[2][0] = -Rotation.M[2][0];
+		Rotation.M[2][1] = -Rotation.M[2][1];
+		Rotation.M[2][2] = -Rotation.M[2][2];
+	}
+	const FVector3f ScaleCM(
+		FMath::Sqrt(FMath::Max(Sigma[0][0], 0.0)),
+		FMath::Sqrt(FMath::Max(Sigma[1][1], 0.0)),
+		FMath::Sqrt(FMath::Max(Sigma[2][2], 0.0)));
+
+	Splats.Positions[Target] = FVector3f(Mean);
+	Splats.Rotations[Target] = FQuat4f(Rotation).GetNormalized();
+	Splats.Scales[Target] = ScaleCM / MetersToCentimeters;
+	Splats.Colors[Target].R = uint8(FMath::RoundToInt(Color.X));
+	Splats.Colors[Target].G = uint8(FMath::RoundToInt(Color.Y));
+	Splats.Colors[Target].B = uint8(FMath::RoundToInt(Color.Z));
+}
+
+void ReorderSplats(FImportedSplats& Splats, TConstArrayView<int32> Order)
+{
+	check(Order.Num() == Splats.Num());
+
+	Reorder(Splats.Positions, Order, 1);
+	Reorder(Splats.Rotations, Order, 1);
+	Reorder(Splats.Scales, Order, 1);
+	Reorder(Splats.Colors, Order, 1);
+	if (Splats.SHDegree > 0)
+	{
+		Reorder(
+			Splats.SHCoefficients,
+			Order,
+			3 * GetNumSHCoefficients(Splats.SHDegree));
+	}
+}
+
+FSplatPruningStats
+PruneSplats(FImportedSplats& Splats, const FSplatPruningOptions& Options)
+{
+	const int32 NumSplats = Splats.Num();
+	check(Splats.Rotations.Num() == NumSplats);
+	check(Splats.Scales.Num() == NumSplats);
+	check(Splats.Colors.Num() == NumSplats);
+
+	FSplatPruningStats Stats;
+	TBitArray<> Keep(true, NumSplats);
+	double TotalCoverage = 0.0;
+	double ChangedCoverage = 0.0;
+
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		const FVector3f ScaleCM = MetersToCentimeters * Splats.Scales[Index];
+		if (Splats.Positions[Index].ContainsNaN() || ScaleCM.ContainsNaN() ||
+		    Splats.Rotations[Index].ContainsNaN() ||
+		    ScaleCM.GetMax() < Options.MinScaleCM)
+		{
+			Keep[Index] = false;
+			++Stats.NumDegenerate;
+			continue;
+		}
+
+		const float Coverage = GetSplatCoverage(Splats.Colors[Index], ScaleCM);
+		TotalCoverage += Coverage;
+		if (Splats.Colors[Index].A < Options.MinOpacity * 255.f)
+		{
+			Keep[Index] = false;
+			++Stats.NumTransparent;
+			ChangedCoverage += Coverage;
+		}
+	}
+
+	if (Options.MergeDistanceCM > 0.f)
+	{
+		// Sort splats by cell, so each cell's splats are contiguous. Cells are
+		// as wide as the merge distance, so splats close enough to merge are
+		// in the same or neighboring cells.
+		TArray<TPair<uint64, int32>> Cells;
+		Cells.Reserve(NumSplats);
+		for (int32 Index = 0; Index < NumSplats; ++Index)
+		{
+			if (Keep[Index])
+			{
+				Cells.Emplace(
+					GetCellKey(GetCell(
+						MetersToCentimeters * Splats.Positions[Index],
+						Options.MergeDistanceCM)),
+					Index);
+			}
+		}
+		Cells.Sort();
+
+		// Range of each cell's splats within the sorted splats.
+		TMap<uint64, TPair<int32, int32>> CellRanges;
+		for (int32 Begin = 0; Begin < Cells.Num();)
+		{
+			int32 End = Begin + 1;
+			while (End < Cells.Num() && Cells[End].Key == Cells[Begin].Key)
+			{
+				++End;
+			}
+			CellRanges.Add(Cells[Begin].Key, {Begin, End});
+			Begin = End;
+		}
+
+		// Greedily group each splat with the similar splats after it, in its
+		// own and the 26 neighboring cells.
+		TArray<int32, TInlineAllocator<16>> Group;
+		for (int32 First = 0; First < Cells.Num(); ++First)
+		{
+			const int32 Index = Cells[First].Value;
+			if (!Keep[Index])
+			{
+				continue;
+			}
+
+			Group.Reset();
+			Group.Add(Index);
+			const FIntVector Cell = GetCell(
+				MetersToCentimeters * Splats.Positions[Index],
+				Options.MergeDistanceCM);
+			for (int32 Neighbor = 0; Neighbor < 27; ++Neighbor)
+			{
+				const FIntVector Offset(
+					Neighbor % 3 - 1, Neighbor / 3 % 3 - 1, Neighbor / 9 - 1);
+				const TPair<int32, int32>* Range =
+					CellRanges.Find(GetCellKey(Cell + Offset));
+				if (!Range)
+				{
+					continue;
+				}
+				for (int32 Other = FMath::Max(Range->Key, First + 1);
+				     Other < Range->Value;
+				     ++Other)
+				{
+					const int32 OtherIndex = Cells[Other].Value;
+					if (Keep[OtherIndex] &&
+					    CanMerge(
+							Splats,
+							Index,
+							OtherIndex,
+							Options.MergeDistanceCM))
+					{
+						Group.Add(OtherIndex);
+						Keep[OtherIndex] = false;
+					}
+				}
+			}
+
+			if (Group.Num() > 1)
+			{
+				ChangedCoverage += Merge(Splats, Group);
+				Stats.NumMerged += Group.Num() - 1;
+			}
+		}
+	}
+
+	// Compact the splats kept.
+	const int32 Dimension =
+		Splats.SHDegree > 0 ? 3 * GetNumSHCoefficients(Splats.SHDegree) : 0;
+	int32 NumKept = 0;
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		if (!Keep[Index])
+		{
+			continue;
+		}
+		Splats.Positions[NumKept] = Splats.Positions[Index];
+		Splats.Rotations[NumKept] = Splats.Rotations[Index];
+		Splats.Scales[NumKept] = Splats.Scales[Index];
+		Splats.Colors[NumKept] = Splats.Colors[Index];
+		if (Dimension > 0 && NumKept != Index)
+		{
+			FMemory::Memcpy(
+				&Splats.SHCoefficients[NumKept * Dimension],
+				&Splats.SHCoefficients[Index * Dimension],
+				Dimension * sizeof(float));
+		}
+		++NumKept;
+	}
+	Splats.Positions.SetNum(NumKept);
+	Splats.Rotations.SetNum(NumKept);
+	Splats.Scales.SetNum(NumKept);
+	Splats.Colors.SetNum(NumKept);
+	if (Dimension > 0)
+	{
+		Splats.SHCoefficients.SetNum(NumKept * Dimension);
+	}
+
+	Stats.EstimatedError =
+		TotalCoverage > 0.0 ? float(ChangedCoverage / TotalCoverage) : 0.f;
+	return Stats;
+}
+
+} // namespace PICO::Splat
@@ -0,0 +1,119 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/Color.h"
+#include "Math/Quat.h"
+#include "Math/Vector.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Splats as parsed from a file, before being stored in an asset.
+ */
+struct FImportedSplats
+{
+	// Positions, in meters.
+	TArray<FVector3f> Positions;
+	TArray<FQuat4f> Rotations;
+	// Scales, at one standard deviation, in meters.
+	TArray<FVector3f> Scales;
+	// Linear colors, with opacity in alpha.
+	TArray<FColor> Colors;
+	// Degree of higher-order spherical harmonics, or 0 if there are none.
+	uint32 SHDegree = 0;
+	// `3 * GetNumSHCoefficients(SHDegree)` coefficients per splat, ordered by
+	// coefficient then channel.
+	TArray<float> SHCoefficients;
+
+	/**
+	 * @return The number of splats.
+	 */
+	int32 Num() const { return Positions.Num(); }
+};
+
+/**
+ * Thresholds for removing splats which contribute little or nothing.
+ */
+struct FSplatPruningOptions
+{
+	// Splats less opaque than this are removed, in [0, 1].
+	float MinOpacity = 0.f;
+	// Splats whose largest scale is smaller than this are removed, in
+	// centimeters.
+	float MinScaleCM = 0.f;
+	// Similar splats closer than this are merged, in centimeters. 0 disables
+	// merging.
+	float MergeDistanceCM = 0.f;
+};
+
+/**
+ * What pruning removed, and how much it changed the splats.
+ */
+struct FSplatPruningStats
+{
+	int32 NumTransparent = 0;
+	int32 NumDegenerate = 0;
+	// Splats merged away, i.e. not counting the splats they were merged into.
+	int32 NumMerged = 0;
+	// Opacity-weighted area removed or changed, as a fraction of the total.
+	float EstimatedError = 0.f;
+};
+
+/**
+ * Gets how much a splat covers, as its opacity times the area of its largest
+ * cross-section. Used to weight merges and measure error.
+ *
+ * @param Color - Color of the splat, with opacity in alpha.
+ * @param ScaleCM - Scale of the splat, in centimeters.
+ * @return Opacity-weighted area, in cm^2.
+ */
+float GetSplatCoverage(const FColor& Color, const FVector3f& ScaleCM);
+
+/**
+ * Fits one splat to a weighted group of splats, preserving the group's
+ * weighted mean and covariance. Colors and spherical harmonics are averaged.
+ * Opacity is left to the caller, as it depends on how the group overlaps.
+ *
+ * @param Splats - Splats to fit to, and to write the fitted splat to.
+ * @param Group - Splats to fit to.
+ * @param Weights - Weight of each splat in the group, summing to 1.
+ * @param Target - Splat to overwrite, except for its opacity. May be in the
+ * group.
+ */
+void FitSplat(
+	FImportedSplats& Splats,
+	TConstArrayView<int32> Group,
+	TConstArrayView<double> Weights,
+	int32 Target);
+
+/**
+ * Reorders splats, along with their spherical harmonics.
+ *
+ * @param Splats - Splats to reorder, in place.
+ * @param Order - Index of the splat to move to each position, a permutation
+ * of every splat.
+ */
+void ReorderSplats(FImportedSplats& Splats, TConstArrayView<int32> Order);
+
+/**
+ * Removes nearly transparent splats, degenerate splats (too small, or not
+ * finite), and merges near-duplicates.
+ *
+ * Near-duplicates are found with a spatial hash, and must have similar colors
+ * and sizes. Each group is replaced with one splat preserving the weighted mean
+ * and covariance of the group.
+ *
+ * @param Splats - Splats to prune, in place.
+ * @param Options - Thresholds to prune with.
+ * @return What was removed.
+ */
+FSplatPruningStats
+PruneSplats(FImportedSplats& Splats, const FSplatPruningOptions& Options);
+
+} // namespace PICO::Splat
@@ -0,0 +1,75 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatSpatialOrder.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/AssertionMacros.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+// Bits of each coordinate in a Morton code.
+constexpr int32 MORTON_BITS = 21;
+
+/**
+ * @param Value - Value to spread, in its lowest `MORTON_BITS` bits.
+ * @return The value with two zero bits inserted after each bit.
+ */
+uint64 SpreadBits(uint64 Value)
+{
+	Value &= (uint64(1) << MORTON_BITS) - 1;
+	Value = (Value | (Value << 32)) & 0x001F00000000FFFFull;
+	Value = (Value | (Value << 16)) & 0x001F0000FF0000FFull;
+	Value = (Value | (Value << 8)) & 0x100F00F00F00F00Full;
+	Value = (Value | (Value << 4)) & 0x10C30C30C30C30C3ull;
+	Value = (Value | (Value << 2)) & 0x1249249249249249ull;
+	return Value;
+}
+} // namespace
+
+uint64 GetMortonCode(const FVector3f& Position, const FBox3f& Bounds)
+{
+	constexpr float MAX_CELL = float((1 << MORTON_BITS) - 1);
+	const FVector3f Extent = Bounds.GetSize().ComponentMax(
+		FVector3f(UE_KINDA_SMALL_NUMBER));
+	const FVector3f Cell =
+		((Position - Bounds.Min) / Extent * MAX_CELL).BoundToBox(
+			FVector3f::ZeroVector, FVector3f(MAX_CELL));
+	return (SpreadBits(uint64(Cell.X)) << 2) |
+	       (SpreadBits(uint64(Cell.Y)) << 1) | SpreadBits(uint64(Cell.Z));
+}
+
+void SortSplatsAlongCurve(FImportedSplats& Splats)
+{
+	const int32 NumSplats = Splats.Num();
+	check(NumSplats > 0);
+
+	const FBox3f Bounds(Splats.Positions);
+	TArray<TPair<uint64, int32>> Codes;
+	Codes.SetNumUninitialized(NumSplats);
+	ParallelFor(
+		TEXT("SplatMortonCodes"),
+		NumSplats,
+		16 * 1024,
+		[&](int32 Index)
+		{
+			Codes[Index] = {
+				GetMortonCode(Splats.Positions[Index], Bounds),
+				Index};
+		});
+	// Ties are broken by index, so the order is reproducible.
+	Codes.Sort();
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumSplats);
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		Order[Index] = Codes[Index].Value;
+	}
+	ReorderSplats(Splats, Order);
+}
+
+} // namespace PICO::Splat
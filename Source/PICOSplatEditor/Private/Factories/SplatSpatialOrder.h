@@ -0,0 +1,32 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Math/Box.h"
+#include "SplatPruning.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Gets the Morton code of a position, i.e. its place along a Z-order curve
+ * through its bounds.
+ *
+ * @param Position - Position to get the code of.
+ * @param Bounds - Bounds of every position.
+ * @return The Morton code.
+ */
+uint64 GetMortonCode(const FVector3f& Position, const FBox3f& Bounds);
+
+/**
+ * Sorts splats along a Morton curve, so splats near one another in space are
+ * near one another in every stream. Fetches of neighbouring splats then share
+ * cache lines and pages, and the streams compress better.
+ *
+ * @param Splats - Splats to sort, in place.
+ */
+void SortSplatsAlongCurve(FImportedSplats& Splats);
+
+} // namespace PICO::Splat
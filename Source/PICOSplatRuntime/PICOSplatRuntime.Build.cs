@@ -22,6 +22,17 @@ public class PICOSplatRuntime : ModuleRules
 			}
 		);
 
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"DerivedDataCache",
+					"TargetPlatform",
+				}
+			);
+		}
+
 		PrivateIncludePaths.AddRange(
 			new string[]
 			{
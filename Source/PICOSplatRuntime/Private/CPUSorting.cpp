@@ -6,17 +6,33 @@
 
 #include <algorithm>
 
+#include "HAL/PlatformTime.h"
 #include "Misc/AssertionMacros.h"
+#include "Misc/ScopeExit.h"
 #include "RenderingThread.h"
+#include "SplatStats.h"
 
 namespace PICO::Splat
 {
-void EnqueueCopy(std::shared_ptr<FMultithreadedSortingBuffers>& Buffers)
+namespace
+{
+std::atomic<uint64> CPUSortCycles = 0;
+} // namespace
+
+uint64 ConsumeCPUSortCycles()
+{
+	return CPUSortCycles.exchange(0);
+}
+
+void EnqueueCopy(
+	std::shared_ptr<FMultithreadedSortingBuffers>& Buffers,
+	const FCPUSortJob& Job,
+	bool bComplete)
 {
 	FRHIBuffer* DstBuffer = nullptr;
 	void* Src = nullptr;
-	uint32 Size = 0;
-	Buffers->BeginCopy(DstBuffer, Src, Size);
+	uint32 NumToCopy = 0;
+	Buffers->BeginCopy(DstBuffer, Src, NumToCopy);
 
 	/**
 	 * Buffer is passed in via capture, as it's containing CopyDst may be moved
@@ -27,8 +43,11 @@ void EnqueueCopy(std::shared_ptr<FMultithreadedSortingBuffers>& Buffers)
 	ENQUEUE_RENDER_COMMAND(CopyIndices)(
 		[BuffersWeakRef = std::weak_ptr<FMultithreadedSortingBuffers>(Buffers),
 	     DstBuffer,
-	     Size,
-	     Src](FRHICommandList& RHICmdList)
+	     NumToCopy,
+	     Src,
+	     NumSorted = Job.NumSplats,
+	     Sort = Job.Sort,
+	     bComplete](FRHICommandList& RHICmdList)
 		{
 			// This command may be executed after the proxy and task have been
 			// destroyed. If so, we can skip it.
@@ -39,17 +58,32 @@ void EnqueueCopy(std::shared_ptr<FMultithreadedSortingBuffers>& Buffers)
 				return;
 			}
 
-			void* Dst =
-				RHICmdList.LockBuffer(DstBuffer, 0, Size, RLM_WriteOnly);
-			memcpy(Dst, Src, Size);
-			RHICmdList.UnlockBuffer(DstBuffer);
+			// Nothing may be visible, e.g. when the view is inside the splat.
+			const uint32 Size = NumToCopy * sizeof(FIndexedDistance);
+			if (Size > 0)
+			{
+				void* Dst =
+					RHICmdList.LockBuffer(DstBuffer, 0, Size, RLM_WriteOnly);
+				memcpy(Dst, Src, Size);
+				RHICmdList.UnlockBuffer(DstBuffer);
+			}
 
-			Buffers->EndCopy();
+			Buffers->EndCopy(NumToCopy, NumSorted, Sort, bComplete);
 		});
 }
 
 void FCPUSortingTask::DoWork()
 {
+	SCOPE_CYCLE_COUNTER(STAT_SplatCPUSortSlice);
+	INC_DWORD_STAT(STAT_SplatCPUSortSlices);
+
+	// Measured for hybrid sorting.
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	ON_SCOPE_EXIT
+	{
+		CPUSortCycles += FPlatformTime::Cycles64() - StartCycles;
+	};
+
 	// This command may execute after the associated proxy is destroyed.
 	std::shared_ptr<FMultithreadedSortingBuffers> Buffers =
 		BuffersWeakRef.lock();
@@ -58,30 +92,79 @@ void FCPUSortingTask::DoWork()
 		return;
 	}
 
-	// Acquire buffers.
-	FIndexedDistance* Begin = nullptr;
-	FIndexedDistance* End = nullptr;
-	Buffers->WaitCopy(Begin, End);
+	// Continue the previous sort if it did not finish, else start a new one
+	// from the current view.
+	FCPUSortJob& Job = Buffers->GetJob();
+	if (Job.Phase == ECPUSortPhase::Idle)
+	{
+		Job.Begin(View, View.NumSplats, Sort, /*bInSliced=*/SliceBudget > 0);
+	}
 
-	// Calculate distances from current view.
-	for (uint32 Index = 0; Index < uint32(PositionsM.Num()); ++Index)
+	// Unsliced, distances are written straight to the output, which may still
+	// be being copied to the GPU from a previous sort.
+	if (!Job.bSliced)
 	{
-		FVector3f PositionWorldCM(Transform.TransformPosition(
-			MetersToCentimeters * PositionsM[Index]));
-		Begin[Index] =
-			FIndexedDistance(Index, OriginCM, Forward, PositionWorldCM);
+		ComputeDistances(Job, Buffers->WaitCopy(Job.NumSplats), MAX_uint32);
+		TArrayView<FIndexedDistance> Output =
+			Buffers->SetNumVisible(Job.GetNumVisible());
+		std::sort(Output.GetData(), Output.GetData() + Output.Num());
+		Job.Phase = ECPUSortPhase::Idle;
 	}
 
-	// Partition out some splats not visible.
-	End = std::partition(Begin, End, FIndexedDistance::IsMaybeVisible);
+	uint32 Remaining = SliceBudget ? SliceBudget : MAX_uint32;
+	TArrayView<FIndexedDistance> Output;
+	bool bAcquiredOutput = false;
+	while (Remaining > 0 && Job.Phase != ECPUSortPhase::Idle)
+	{
+		// Later phases write to the output, which may still be being copied to
+		// the GPU from a previous sort.
+		if (Job.Phase != ECPUSortPhase::Distances && !bAcquiredOutput)
+		{
+			Buffers->WaitCopy(Job.GetNumVisible());
+			Output = Buffers->SetNumVisible(Job.GetNumVisible());
+			bAcquiredOutput = true;
+		}
 
-	// Sort.
-	std::sort(Begin, End);
+		uint32 Processed = 0;
+		switch (Job.Phase)
+		{
+		case ECPUSortPhase::Distances:
+			Processed = ComputeDistances(Job, Job.Keys, Remaining);
+			break;
+		case ECPUSortPhase::Scatter:
+			Processed = Scatter(Job, Output, Remaining);
+			break;
+		case ECPUSortPhase::Refine:
+			Processed = Refine(Job, Output, Remaining);
+			break;
+		default:
+			checkNoEntry();
+		}
+		Remaining -= FMath::Min(Processed, Remaining);
+	}
 
-	// Enqueue copy to GPU.
-	// TODO(seth): Copy & draw should be aware of how many splats actually need to
-	// be rendered.
-	EnqueueCopy(Buffers);
+	// Enqueue copy to GPU, once sorted. If the sort will take more frames,
+	// the coarse order is still better than a stale one, so optionally copy it
+	// once at least the nearest bucket has been refined. Only visible splats
+	// are copied and drawn.
+	if (Job.Phase == ECPUSortPhase::Idle)
+	{
+		EnqueueCopy(Buffers, Job, /*bComplete=*/true);
+		INC_DWORD_STAT(STAT_SplatCPUSortsCompleted);
+	}
+	else if (
+		bPublishPartial && Job.Phase == ECPUSortPhase::Refine &&
+		Job.Cursor > 0 && !Job.bPublishedPartial)
+	{
+		EnqueueCopy(Buffers, Job, /*bComplete=*/false);
+		Job.bPublishedPartial = true;
+		INC_DWORD_STAT(STAT_SplatCPUSortsPartial);
+	}
+	if (Job.Phase != ECPUSortPhase::Idle)
+	{
+		INC_DWORD_STAT(STAT_SplatCPUSortsInFlight);
+	}
+	INC_DWORD_STAT_BY(STAT_SplatCPUSortBudget, SliceBudget);
 
 	// Cleanup.
 	bool bNeedsTearDown = Buffers->EndSorting();
@@ -90,4 +173,276 @@ void FCPUSortingTask::DoWork()
 		Buffers->ReleaseResources();
 	}
 }
+
+uint32 FCPUSortingTask::ComputeDistances(
+	FCPUSortJob& Job, TArrayView<FIndexedDistance> Visible, uint32 Budget)
+{
+	const uint32 NumSplats = Job.NumSplats;
+	check(NumSplats <= uint32(PositionsM.Num()));
+	check(uint32(Visible.Num()) >= NumSplats);
+
+	// Splats projecting to less than the minimum radius are culled, and splats
+	// in the outer rings of the view are thinned. Radii and opacities may be
+	// missing if the asset was loaded for GPU sorting only.
+	//
+	// Oversized splats are not handled here, but by `FAdjustSplatsCS`, which
+	// runs after either sort. It measures their projected covariance, which
+	// is only kept on the GPU, and measuring them by radii instead would cull
+	// different splats than GPU sorting near the threshold. Its policy is
+	// mirrored on the CPU by `FOversizedSplats`, for reference.
+	const FCPUSortView& View = Job.View;
+	const bool bHasRadii = RadiiCM.Num() == PositionsM.Num();
+	const bool bCullSmall = View.MinRadiusPixels > 0.f && bHasRadii;
+	const bool bThin = View.Foveation.bEnabled && bHasRadii &&
+	                   Opacities.Num() == PositionsM.Num();
+	const bool bHasLOD = LODNodes.Num() == PositionsM.Num();
+	uint32 NumCulled = 0;
+	uint32 NumThinned = 0;
+	uint32 NumCoarsened = 0;
+
+	// Calculate distances from the view, and count splats per bucket. Splats not
+	// visible are dropped, so they are never sorted, copied or drawn.
+	uint32 Next = Job.Cursor;
+	uint32 NumProcessed = 0;
+	while (Next < NumSplats && NumProcessed < Budget)
+	{
+		const uint32 Index = Next++;
+		++NumProcessed;
+
+		FVector3f PositionWorldCM(View.Transform.TransformPosition(
+			MetersToCentimeters * PositionsM[Index]));
+
+		// Levels of detail are walked in pre-order. A splat detailed enough is
+		// drawn in place of its subtree, which is skipped. Otherwise, its
+		// children, which follow it, are visited instead.
+		if (bHasLOD)
+		{
+			const FSplatLODNode& Node = LODNodes[Index];
+			if (!Node.IsDetailed(
+					FVector3f::Distance(PositionWorldCM, View.OriginCM),
+					View.LODScale,
+					View.MaxLODError))
+			{
+				continue;
+			}
+			NumCoarsened += Node.SubtreeEnd - Next;
+			Next = Node.SubtreeEnd;
+		}
+
+		FIndexedDistance ID(
+			Index, View.OriginCM, View.Forward, PositionWorldCM);
+
+		if (!FIndexedDistance::IsMaybeVisible(ID))
+		{
+			continue;
+		}
+
+		if (bCullSmall || bThin)
+		{
+			const FVector3f ToSplatCM = PositionWorldCM - View.OriginCM;
+			const float DepthCM = ToSplatCM.Dot(View.Forward);
+			const float RadiusPixels =
+				View.RadiusToPixels * RadiiCM[Index].GetFloat() / DepthCM;
+
+			if (bCullSmall && RadiusPixels < View.MinRadiusPixels)
+			{
+				++NumCulled;
+				continue;
+			}
+
+			// Mirrors `FAdjustSplatsCS`, which thins with the same random
+			// numbers, and compensates the opacity of the splats kept.
+			if (bThin)
+			{
+				const float OffAxisCM = FMath::Sqrt(FMath::Max(
+					ToSplatCM.SizeSquared() - FMath::Square(DepthCM), 0.f));
+				const float Eccentricity =
+					View.EccentricityScale * OffAxisCM / DepthCM;
+				const float Importance = Opacities[Index] / 255.f * UE_PI *
+				                         FMath::Square(RadiusPixels);
+				if (FFoveation::GetSplatRandom(Index) >=
+				    View.Foveation.GetKeepProbability(Eccentricity, Importance))
+				{
+					++NumThinned;
+					continue;
+				}
+			}
+		}
+
+		++Job.BucketStarts[FCPUSortJob::GetBucket(ID)];
+		Visible[Job.NumVisible++] = ID;
+	}
+	Job.Cursor = Next;
+	INC_DWORD_STAT_BY(STAT_SplatCPUSortCulledSubPixel, NumCulled);
+	INC_DWORD_STAT_BY(STAT_SplatCPUSortThinned, NumThinned);
+	INC_DWORD_STAT_BY(STAT_SplatCPUSortCoarsened, NumCoarsened);
+
+	if (Job.Cursor == NumSplats)
+	{
+		// Convert bucket sizes into offsets.
+		uint32 Offset = 0;
+		for (uint32 Bucket = 0; Bucket < FCPUSortJob::NUM_BUCKETS; ++Bucket)
+		{
+			const uint32 Size = Job.BucketStarts[Bucket];
+			Job.BucketStarts[Bucket] = Offset;
+			Job.BucketCursors[Bucket] = Offset;
+			Offset += Size;
+		}
+		Job.BucketStarts[FCPUSortJob::NUM_BUCKETS] = Offset;
+		check(Offset == Job.GetNumVisible());
+
+		Job.Phase = ECPUSortPhase::Scatter;
+		Job.Cursor = 0;
+	}
+
+	return NumProcessed;
+}
+
+uint32 FCPUSortingTask::Scatter(
+	FCPUSortJob& Job, TArrayView<FIndexedDistance> Output, uint32 Budget)
+{
+	const uint32 NumVisible = Job.GetNumVisible();
+	check(uint32(Output.Num()) == NumVisible);
+
+	const uint32 Begin = Job.Cursor;
+	const uint32 End = Begin + FMath::Min(Budget, NumVisible - Begin);
+
+	// Each splat goes to its bucket.
+	for (uint32 Index = Begin; Index < End; ++Index)
+	{
+		const FIndexedDistance& ID = Job.Keys[Index];
+		Output[Job.BucketCursors[FCPUSortJob::GetBucket(ID)]++] = ID;
+	}
+	Job.Cursor = End;
+
+	if (Job.Cursor == NumVisible)
+	{
+		Job.Phase = ECPUSortPhase::Refine;
+		Job.Cursor = 0;
+	}
+
+	return End - Begin;
+}
+
+uint32 FCPUSortingTask::Refine(
+	FCPUSortJob& Job, TArrayView<FIndexedDistance> Output, uint32 Budget)
+{
+	// Buckets up to a slice are sorted whole, so this may go over budget by up
+	// to one slice. Larger buckets are split across slices.
+	const uint32 MaxWholeBucket = SliceBudget ? SliceBudget : MAX_uint32;
+	uint32 Processed = 0;
+	while (Job.Cursor < FCPUSortJob::NUM_BUCKETS && Processed < Budget)
+	{
+		const uint32 Bucket = FCPUSortJob::NUM_BUCKETS - 1 - Job.Cursor;
+		const uint32 Begin = Job.BucketStarts[Bucket];
+		const uint32 End = Job.BucketStarts[Bucket + 1];
+
+		if (End - Begin > MaxWholeBucket)
+		{
+			bool bDone = false;
+			Processed +=
+				RefineSplit(Job, Output, Begin, End, Budget - Processed, bDone);
+			if (!bDone)
+			{
+				break;
+			}
+		}
+		else
+		{
+			std::sort(Output.GetData() + Begin, Output.GetData() + End);
+			Processed += End - Begin;
+		}
+		++Job.Cursor;
+	}
+
+	if (Job.Cursor == FCPUSortJob::NUM_BUCKETS)
+	{
+		Job.Phase = ECPUSortPhase::Idle;
+	}
+
+	return Processed;
+}
+uint32 FCPUSortingTask::RefineSplit(
+	FCPUSortJob& Job,
+	TArrayView<FIndexedDistance> Output,
+	uint32 Begin,
+	uint32 End,
+	uint32 Budget,
+	bool& bOutDone)
+{
+	// Splats of a bucket share the high byte of their distances, so a stable
+	// counting sort by the low byte sorts it. Keys are free once scattered,
+	// and hold the bucket while it is reordered.
+	check(Job.bSliced);
+	check(uint32(Job.Keys.Num()) >= End);
+
+	bOutDone = false;
+	uint32 Processed = 0;
+	while (Processed < Budget)
+	{
+		const uint32 From = Begin + Job.SplitCursor;
+		const uint32 To = From + FMath::Min(Budget - Processed, End - From);
+		switch (Job.SplitStep)
+		{
+		case ECPUSortSplitStep::Count:
+			if (Job.SplitCursor == 0)
+			{
+				FMemory::Memzero(Job.BucketCursors);
+			}
+			for (uint32 Index = From; Index < To; ++Index)
+			{
+				++Job.BucketCursors[FCPUSortJob::GetSubBucket(Output[Index])];
+			}
+			break;
+		case ECPUSortSplitStep::Scatter:
+			for (uint32 Index = From; Index < To; ++Index)
+			{
+				const FIndexedDistance& ID = Output[Index];
+				Job.Keys[Job.BucketCursors[FCPUSortJob::GetSubBucket(ID)]++] =
+					ID;
+			}
+			break;
+		case ECPUSortSplitStep::Copy:
+			FMemory::Memcpy(
+				Output.GetData() + From,
+				Job.Keys.GetData() + From,
+				(To - From) * sizeof(FIndexedDistance));
+			break;
+		}
+		Processed += To - From;
+		Job.SplitCursor = To - Begin;
+
+		if (To < End)
+		{
+			continue;
+		}
+		Job.SplitCursor = 0;
+		switch (Job.SplitStep)
+		{
+		case ECPUSortSplitStep::Count:
+		{
+			// Convert counts into offsets within the keys.
+			uint32 Offset = Begin;
+			for (uint32& Cursor : Job.BucketCursors)
+			{
+				const uint32 Size = Cursor;
+				Cursor = Offset;
+				Offset += Size;
+			}
+			Job.SplitStep = ECPUSortSplitStep::Scatter;
+			break;
+		}
+		case ECPUSortSplitStep::Scatter:
+			Job.SplitStep = ECPUSortSplitStep::Copy;
+			break;
+		case ECPUSortSplitStep::Copy:
+			Job.SplitStep = ECPUSortSplitStep::Count;
+			bOutDone = true;
+			return Processed;
+		}
+	}
+
+	return Processed;
+}
+
 } // namespace PICO::Splat
\ No newline at end of file
@@ -9,6 +9,9 @@
 
 #include "Async/AsyncWork.h"
 #include "Containers/ArrayView.h"
+#include "Foveation.h"
+#include "Math/Float16.h"
+#include "Math/Matrix.h"
 #include "Math/Vector.h"
 #include "PackedTypes.h"
 #include "Rendering/SplatBuffers.h"
@@ -24,8 +27,203 @@ enum class ESortingState : std::atomic_signed_lock_free::value_type
 };
 static_assert(std::atomic<ESortingState>::is_always_lock_free);
 
+/**
+ * View-dependent inputs to a CPU sort. These are captured when a sort begins,
+ * and held fixed until it completes, even if that spans multiple frames.
+ */
+struct FCPUSortView
+{
+	// Viewer origin, in centimeters.
+	FVector3f OriginCM;
+	// Viewer forward, normalized.
+	FVector3f Forward;
+	// Transform to apply to each position.
+	FMatrix44f Transform;
+	// Scale from a splat's radius over its depth to its projected radius, in
+	// pixels. Includes the focal length, and the scale of `Transform`.
+	float RadiusToPixels;
+	// Projected radius below which splats are culled, in pixels. 0 disables
+	// culling.
+	float MinRadiusPixels;
+	// Scale from a splat's distance from the view axis over its depth to its
+	// eccentricity, for foveated thinning.
+	float EccentricityScale;
+	// Foveated thinning to apply.
+	FFoveation Foveation;
+	// Scale from level of detail bounds and errors, in meters, to centimeters.
+	// Includes the scale of `Transform`.
+	float LODScale;
+	// Largest level of detail error drawn, over the distance it is seen from.
+	// Includes the focal length.
+	float MaxLODError;
+	// Splats to sort, from the first. Fewer than the asset's while only a
+	// prefix of splats ordered by importance is drawn.
+	uint32 NumSplats;
+};
+
+/**
+ * Steps of a CPU sort, in the order they are performed.
+ */
+enum class ECPUSortPhase : uint8
+{
+	// No sort in progress.
+	Idle,
+	// Measuring the distance to each splat, and bucketing by distance.
+	Distances,
+	// Scattering splats into the output, coarsely ordered by bucket.
+	Scatter,
+	// Sorting within each bucket, nearest first.
+	Refine
+};
+
+/**
+ * Steps of sorting a bucket too large to sort in one slice, by the low byte of
+ * distances, in the order they are performed.
+ */
+enum class ECPUSortSplitStep : uint8
+{
+	// Counting the splats with each low byte.
+	Count,
+	// Scattering splats into the keys, ordered by low byte.
+	Scatter,
+	// Copying the sorted bucket back to the output.
+	Copy
+};
+
+/**
+ * State of a CPU sort, which may be split across several sorting tasks.
+ *
+ * Splats are sorted with one pass of a most-significant-digit radix sort,
+ * followed by a comparison sort within each bucket. This lets a sort be paused
+ * at (almost) any point, and after the first pass the output is already
+ * ordered to within a bucket. Buckets are refined nearest first, as errors in
+ * the order of near splats are the most visible. Buckets larger than a slice,
+ * such as the farthest, which holds every splat beyond about 25 m, are instead
+ * sorted by a second radix pass over the low byte, which can be paused too.
+ *
+ * Without a slice budget, a sort finishes in one task, so distances are
+ * written straight to the output and sorted whole.
+ *
+ * Only accessed by the sorting task currently in progress.
+ */
+struct FCPUSortJob
+{
+	// Number of buckets, one per value of the high byte of a distance.
+	static constexpr uint32 NUM_BUCKETS = 256;
+
+	/**
+	 * Gets the bucket a splat is sorted into.
+	 *
+	 * @param ID - The (Index, Distance) pair to bucket.
+	 * @return The bucket for ID, with nearer splats in larger buckets.
+	 */
+	static uint32 GetBucket(const FIndexedDistance& ID)
+	{
+		return ID.GetDistance() >> 8;
+	}
+
+	/**
+	 * Gets the position of a splat within its bucket, when split.
+	 *
+	 * @param ID - The (Index, Distance) pair to bucket.
+	 * @return The low byte of the distance of ID.
+	 */
+	static uint32 GetSubBucket(const FIndexedDistance& ID)
+	{
+		return ID.GetDistance() & 0xFF;
+	}
+
+	/**
+	 * Starts a new sort, discarding any previous progress.
+	 *
+	 * @param InView - View to sort relative to.
+	 * @param InNumSplats - Number of splats being sorted, from the first.
+	 * @param InSort - Number of the sorting task starting this sort.
+	 * @param bInSliced - Whether the sort may be split across tasks.
+	 */
+	void Begin(
+		const FCPUSortView& InView,
+		uint32 InNumSplats,
+		uint32 InSort,
+		bool bInSliced)
+	{
+		View = InView;
+		Sort = InSort;
+		Phase = ECPUSortPhase::Distances;
+		Cursor = 0;
+		NumSplats = InNumSplats;
+		NumVisible = 0;
+		bSliced = bInSliced;
+		bPublishedPartial = false;
+		SplitStep = ECPUSortSplitStep::Count;
+		SplitCursor = 0;
+		FMemory::Memzero(BucketStarts);
+		if (bSliced)
+		{
+			Keys.SetNumUninitialized(NumSplats, EAllowShrinking::No);
+		}
+		else
+		{
+			Keys.Empty();
+		}
+	}
+
+	/**
+	 * @return Number of splats found to be visible. Only final once the
+	 * `Distances` phase is complete.
+	 */
+	uint32 GetNumVisible() const { return NumVisible; }
+
+	FCPUSortView View;
+	ECPUSortPhase Phase = ECPUSortPhase::Idle;
+
+	// Number of the sorting task which started this sort, and captured its
+	// view (see `FMultithreadedSortingBuffers::BeginSorting`).
+	uint32 Sort = 0;
+
+	// Progress within the current phase. For `Distances` and `Scatter` this is
+	// a number of splats, and for `Refine` this is a number of buckets.
+	uint32 Cursor = 0;
+
+	// Number of splats being sorted, from the first of the asset.
+	uint32 NumSplats = 0;
+
+	// Number of visible splats written so far by the `Distances` phase.
+	uint32 NumVisible = 0;
+
+	// Whether the sort may be split across tasks. If not, it is sorted whole
+	// in the output, without keys or phases past `Distances`.
+	bool bSliced = false;
+
+	// Whether the partially sorted order has been copied to the GPU.
+	bool bPublishedPartial = false;
+
+	// For the bucket being split during `Refine`, the step in progress, and
+	// the number of its splats processed by that step.
+	ECPUSortSplitStep SplitStep = ECPUSortSplitStep::Count;
+	uint32 SplitCursor = 0;
+
+	// Only when sliced, unsorted distances of visible splats, written by the
+	// `Distances` phase, at the front. Sized by every splat, as the visible
+	// count is not yet known. Once scattered, reused to split buckets.
+	TArray<FIndexedDistance> Keys;
+
+	// Before `Scatter`, the size of each bucket. After, the offset of each
+	// bucket within the output, with a final entry for the end of the last.
+	uint32 BucketStarts[NUM_BUCKETS + 1];
+
+	// Write offset of each bucket during `Scatter`, then of each low byte
+	// within the bucket being split.
+	uint32 BucketCursors[NUM_BUCKETS];
+};
+
 /**
  * Owns sorting buffers, and handles synchronization with the GPU.
+ *
+ * Only visible splats are copied to the GPU and drawn, so the GPU buffers are
+ * sized by how many splats are expected to be visible, rather than by asset.
+ * If more are visible, the farthest are dropped, and the required capacity is
+ * reported so the owner can swap these for larger buffers.
  */
 class FMultithreadedSortingBuffers
 {
@@ -33,18 +231,24 @@ public:
 	/**
 	 * Creates CPU resources for sorting splats.
 	 *
-	 * @param NumSplats - Determines how large the sorting buffers will be.
+	 * @param Capacity - Maximum number of splats copied to the GPU per sort.
 	 */
-	FMultithreadedSortingBuffers(uint32 NumSplats)
-		: IdxDistA(NumSplats, EPixelFormat::PF_R32G32_UINT)
-		, IdxDistB(NumSplats, EPixelFormat::PF_R32G32_UINT)
-		, CopyDst(nullptr)
+	FMultithreadedSortingBuffers(uint32 Capacity)
+		: IdxDistA(Capacity, EPixelFormat::PF_R32G32_UINT)
+		, IdxDistB(Capacity, EPixelFormat::PF_R32G32_UINT)
+		, Capacity(Capacity)
+		, CopyDst(&IdxDistA)
 		, DrawSrc(nullptr)
+		, NumSortsLaunched(0)
+		, LastCompleteSort(0)
+		, NumToDraw(0)
+		, NumSortedToDraw(0)
 		, DataCPU()
+		, Job()
+		, RequiredCapacity(0)
 		, CurrentState(ESortingState::Ready)
 		, bCopyInProgress()
 	{
-		DataCPU.SetNumUninitialized(NumSplats);
 	}
 
 	/**
@@ -136,6 +340,77 @@ public:
 	 */
 	bool IsGPUBufferReady() const { return DrawSrc != nullptr; }
 
+	/**
+	 * @return Maximum number of splats copied to the GPU per sort.
+	 */
+	uint32 GetCapacity() const { return Capacity; }
+
+	/**
+	 * Gets the number of visible splats found by the last sort, which may be
+	 * more than were copied to the GPU.
+	 *
+	 * @return Capacity needed to draw every visible splat, or 0 if no sort has
+	 * measured distances yet.
+	 */
+	uint32 GetRequiredCapacity() const { return RequiredCapacity.load(); }
+
+	/**
+	 * Gets the number of splats in the buffer being drawn from. Must be called
+	 * from the render thread.
+	 *
+	 * @return Number of splats to draw.
+	 */
+	uint32 GetNumToDraw() const
+	{
+		check(IsInRenderingThread());
+		return NumToDraw;
+	}
+
+	/**
+	 * Gets the number of leading splats of the asset considered by the sort in
+	 * the buffer being drawn from. With importance order, this is the prefix
+	 * it drew, which may differ from the one now being sorted. Must be called
+	 * from the render thread.
+	 *
+	 * @return Number of splats sorted, or 0 before the first copy.
+	 */
+	uint32 GetNumSortedToDraw() const
+	{
+		check(IsInRenderingThread());
+		return NumSortedToDraw;
+	}
+
+	/**
+	 * Indicates whether no sorting task or copy is using these buffers, so
+	 * they can be reset and handed to another proxy. Must be called from the
+	 * render thread.
+	 *
+	 * @return Whether these buffers are idle.
+	 */
+	bool IsIdle()
+	{
+		check(IsInRenderingThread());
+		return IsReadyForSorting() && !bCopyInProgress.test();
+	}
+
+	/**
+	 * Discards the sorted order and any partial sort, so these buffers can be
+	 * reused for a different proxy. GPU resources and CPU allocations are
+	 * kept. Must be idle (see `IsIdle`).
+	 */
+	void Reset()
+	{
+		check(IsIdle());
+		CopyDst = &IdxDistA;
+		DrawSrc = nullptr;
+		NumSortsLaunched = 0;
+		LastCompleteSort = 0;
+		NumToDraw = 0;
+		NumSortedToDraw = 0;
+		Job.Phase = ECPUSortPhase::Idle;
+		RequiredCapacity.store(0);
+	}
+
 	/**
 	 * Get SRV for sorted indices (as a buffer of (index, distance) pairs).
 	 *
@@ -161,16 +436,22 @@ public:
 	}
 
 	/**
-	 * Marks a sort as in progress.
+	 * Marks a sort as in progress. Must be called from the render thread.
+	 *
+	 * @return Number of the sorting task launched, counting from 1. Sorts
+	 * started by it capture its view, and copies of them are tagged with it.
 	 */
-	void BeginSorting()
+	uint32 BeginSorting()
 	{
+		check(IsInRenderingThread());
+
 		ESortingState ExpectedState = ESortingState::Ready;
 		bool bSuccess = CurrentState.compare_exchange_strong(
 			ExpectedState, ESortingState::InProgress);
 
 		// Assert that we were in the `Ready` state, and transitioned to `InProgress`.
 		check(bSuccess);
+		return ++NumSortsLaunched;
 	}
 
 	/**
@@ -198,11 +479,14 @@ public:
 	 *
 	 * This will be called from a task thread.
 	 *
+	 * Only the nearest `Capacity` splats are copied. As the output is ordered
+	 * back to front, these are at the end.
+	 *
 	 * @param DstBuffer - The RHI buffer which should be copied to.
 	 * @param Src - The source to copy from.
-	 * @param Size - The number of bytes to copy.
+	 * @param NumToCopy - The number of splats to copy.
 	 */
-	void BeginCopy(FRHIBuffer*& DstBuffer, void*& Src, uint32& Size)
+	void BeginCopy(FRHIBuffer*& DstBuffer, void*& Src, uint32& NumToCopy)
 	{
 		// Must not be copying.
 		bool bAlreadyCopying = bCopyInProgress.test_and_set();
@@ -215,37 +499,88 @@ public:
 		check(CopyDst);
 		check(CopyDst->VertexBufferRHI);
 		DstBuffer = CopyDst->VertexBufferRHI;
-		Src = &DataCPU[0];
-		Size = DataCPU.Num() * sizeof(DataCPU[0]);
+		NumToCopy = FMath::Min(uint32(DataCPU.Num()), Capacity);
+		Src = DataCPU.GetData() + (DataCPU.Num() - NumToCopy);
 	}
 
 	/**
 	 * Marks a copy as finished following a call to `BeginCopy`. Resources
 	 * acquired from the former must no longer be accessed after this call.
+	 * The buffer which was copied to will be drawn from, and the next copy
+	 * will go to the other buffer.
 	 *
 	 * This will be called from the render thread, via an enqueued task. It can
 	 * outlive a sort in progress (i.e. after a call to `EndSorting`).
+	 *
+	 * @param NumCopied - The number of splats copied, as given by `BeginCopy`.
+	 * @param NumSorted - The number of leading splats the sort considered.
+	 * @param Sort - Number of the sorting task which started the sort copied.
+	 * @param bComplete - Whether the sort copied had finished, rather than
+	 * being published partially sorted.
 	 */
-	void EndCopy()
+	void
+	EndCopy(uint32 NumCopied, uint32 NumSorted, uint32 Sort, bool bComplete)
 	{
+		check(IsInRenderingThread());
+
 		// Must be copying.
 		bool bCopying = bCopyInProgress.test();
 		check(bCopying);
 
+		// Swap buffers.
+		//
+		// First time through, after swap: CopyDst = B, DrawSrc = A.
+		// Second time through, after swap: CopyDst = A, DrawSrc = B.
+		DrawSrc = CopyDst;
+		CopyDst = (DrawSrc == &IdxDistA) ? &IdxDistB : &IdxDistA;
+
+		NumToDraw = NumCopied;
+		NumSortedToDraw = NumSorted;
+		if (bComplete)
+		{
+			LastCompleteSort = Sort;
+		}
+
 		bCopyInProgress.clear();
 		bCopyInProgress.notify_one();
 	}
 
+	/**
+	 * Gets the number of sorting tasks launched so far, so later sorts can be
+	 * told apart from those already started. Must be called from the render
+	 * thread.
+	 *
+	 * @return Number of calls to `BeginSorting`.
+	 */
+	uint32 GetNumSortsLaunched() const
+	{
+		check(IsInRenderingThread());
+		return NumSortsLaunched;
+	}
+
+	/**
+	 * Gets which sort was last copied to the GPU whole. Partially sorted
+	 * orders are not counted. Must be called from the render thread.
+	 *
+	 * @return Number of the sorting task which started it (see
+	 * `BeginSorting`), or 0 if none has been.
+	 */
+	uint32 GetLastCompleteSort() const
+	{
+		check(IsInRenderingThread());
+		return LastCompleteSort;
+	}
+
 	/**
 	 * Waits for the previous copy to finish (via a call to `EndCopy`), if one is
-	 * in progress. Returns a pointer to the beginning and to one past the end of
-	 * the buffer of `FIndexedDistance`'s which the caller should populate and
-	 * sort.
+	 * in progress. Returns the buffer of `FIndexedDistance`'s which the caller
+	 * should populate and sort.
 	 *
-	 * @param Begin - A pointer to the beginning of the buffer.
-	 * @param End - A pointer to one past the end of the buffer.
+	 * @param Num - Number of splats the sort will write, at least as many as
+	 * are visible.
+	 * @return The buffer which will be copied by the next `BeginCopy`.
 	 */
-	void WaitCopy(FIndexedDistance*& Begin, FIndexedDistance*& End)
+	TArrayView<FIndexedDistance> WaitCopy(uint32 Num)
 	{
 		// `while` needed in case of spurious unblock.
 		while (bCopyInProgress.test())
@@ -253,26 +588,52 @@ public:
 			bCopyInProgress.wait(true);
 		}
 
-		// Swap buffers.
-		//
-		// First time through, after swap: CopyDst = A, DrawSrc = null.
-		// Second time through, after swap: CopyDst = B, DrawSrc = A.
-		if (!DrawSrc)
-		{
-			DrawSrc = CopyDst ? &IdxDistB : &IdxDistA;
-		}
-		std::swap(CopyDst, DrawSrc);
+		DataCPU.SetNumUninitialized(Num, EAllowShrinking::No);
+		return DataCPU;
+	}
 
-		Begin = &DataCPU[0];
-		End = Begin + DataCPU.Num();
+	/**
+	 * Drops splats written past the visible ones, and reports how many are
+	 * visible. Must follow `WaitCopy`, once distances are measured.
+	 *
+	 * @param NumVisible - Number of visible splats, at the front.
+	 * @return The buffer which will be copied by the next `BeginCopy`.
+	 */
+	TArrayView<FIndexedDistance> SetNumVisible(uint32 NumVisible)
+	{
+		check(uint32(DataCPU.Num()) >= NumVisible);
+		DataCPU.SetNum(NumVisible, EAllowShrinking::No);
+		RequiredCapacity.store(NumVisible);
+		return DataCPU;
+	}
+
+	/**
+	 * Gets the state of the sort in progress, if any. Must only be accessed
+	 * between calls to `BeginSorting` and `EndSorting`.
+	 *
+	 * @return The current sort.
+	 */
+	FCPUSortJob& GetJob()
+	{
+		check(CurrentState.load() != ESortingState::Ready);
+		return Job;
 	}
 
 private:
 	FSplatCPUToGPUBuffer IdxDistA;
 	FSplatCPUToGPUBuffer IdxDistB;
+	uint32 Capacity;
 	FSplatCPUToGPUBuffer* CopyDst;
 	FSplatCPUToGPUBuffer* DrawSrc;
+	uint32 NumSortsLaunched;
+	uint32 LastCompleteSort;
+	uint32 NumToDraw;
+	uint32 NumSortedToDraw;
 	TArray<FIndexedDistance> DataCPU;
+	FCPUSortJob Job;
+
+	// Task -> Render Thread: Visible splats found by the last sort.
+	std::atomic<uint32> RequiredCapacity;
 
 	// Task -> Render Thread: Sort finished and copy command enqueued.
 	// Render Thread -> Task: Task must release GPU resources itself.
@@ -282,8 +643,21 @@ private:
 	std::atomic_flag bCopyInProgress;
 };
 
+/**
+ * Takes the worker thread time spent in CPU sorting tasks since the last call,
+ * summed across all threads.
+ *
+ * @return Time, in cycles (see `FPlatformTime::Cycles64`).
+ */
+uint64 ConsumeCPUSortCycles();
+
 /**
  * CPU splat sorting task, for use as template parameter to FAsyncTask.
+ *
+ * Each task performs one slice of a sort. If the sort is larger than the
+ * slice budget, it continues in the next task launched for the same buffers,
+ * with the view it began with, and its result is only copied to the GPU once
+ * complete (or, optionally, once the nearest splats are in order).
  */
 class FCPUSortingTask final : public FNonAbandonableTask
 {
@@ -292,24 +666,36 @@ public:
 	 * Creates a new task for sorting splats on CPU.
 	 *
 	 * @param PositionsM - Splat positions to sort, in meters.
+	 * @param RadiiCM - Splat radii, at one standard deviation, in centimeters.
+	 * @param Opacities - Splat opacities.
+	 * @param LODNodes - Level of detail node of each splat, or empty to sort
+	 * every splat.
 	 * @param Buffers - CPU sorting buffers.
-	 * @param OriginCM - Viewer origin, in centimeters.
-	 * @param Forward - Viewer forward, normalized.
-	 * @param Transform - Transform to apply to each position.
+	 * @param View - View to sort relative to, if a new sort is started.
+	 * @param SliceBudget - Maximum number of splats to process in this task, or
+	 * 0 for no limit.
+	 * @param bPublishPartial - Whether to copy a partially sorted order to the
+	 * GPU, if the sort does not finish in this task.
 	 */
 	FCPUSortingTask(
 		TConstArrayView<FVector3f> PositionsM,
+		TConstArrayView<FFloat16> RadiiCM,
+		TConstArrayView<uint8> Opacities,
+		TConstArrayView<FSplatLODNode> LODNodes,
 		std::shared_ptr<FMultithreadedSortingBuffers>& Buffers,
-		const FVector3f& OriginCM,
-		const FVector3f& Forward,
-		const FMatrix44f& Transform)
+		const FCPUSortView& View,
+		uint32 SliceBudget,
+		bool bPublishPartial)
 		: PositionsM(PositionsM)
+		, RadiiCM(RadiiCM)
+		, Opacities(Opacities)
+		, LODNodes(LODNodes)
 		, BuffersWeakRef(Buffers)
-		, OriginCM(OriginCM)
-		, Forward(Forward)
-		, Transform(Transform)
+		, View(View)
+		, SliceBudget(SliceBudget)
+		, bPublishPartial(bPublishPartial)
 	{
-		Buffers->BeginSorting();
+		Sort = Buffers->BeginSorting();
 	}
 
 	// Member functions needed for FAsyncTask.
@@ -323,10 +709,51 @@ public:
 private:
 	friend class FAutoDeleteAsyncTask<FCPUSortingTask>;
 
+	/**
+	 * Sorting phases. Each processes up to `Budget` splats, and returns the
+	 * number processed. Splats skipped by level of detail are not processed.
+	 * Distances of visible splats are written to the front of `Visible`.
+	 */
+	uint32 ComputeDistances(
+		FCPUSortJob& Job,
+		TArrayView<FIndexedDistance> Visible,
+		uint32 Budget);
+	uint32 Scatter(
+		FCPUSortJob& Job,
+		TArrayView<FIndexedDistance> Output,
+		uint32 Budget);
+	uint32 Refine(
+		FCPUSortJob& Job,
+		TArrayView<FIndexedDistance> Output,
+		uint32 Budget);
+
+	/**
+	 * Sorts part of a bucket of `Refine` too large to sort in one slice.
+	 *
+	 * @param Job - Sort in progress, whose `Cursor` is at the bucket.
+	 * @param Output - Output, holding the bucket's splats.
+	 * @param Begin - Offset of the bucket within the output.
+	 * @param End - Offset one past the end of the bucket.
+	 * @param Budget - Maximum number of splats to process.
+	 * @param bOutDone - Set to whether the bucket is now sorted.
+	 * @return Number of splats processed.
+	 */
+	uint32 RefineSplit(
+		FCPUSortJob& Job,
+		TArrayView<FIndexedDistance> Output,
+		uint32 Begin,
+		uint32 End,
+		uint32 Budget,
+		bool& bOutDone);
+
 	TConstArrayView<FVector3f> PositionsM;
+	TConstArrayView<FFloat16> RadiiCM;
+	TConstArrayView<uint8> Opacities;
+	TConstArrayView<FSplatLODNode> LODNodes;
 	std::weak_ptr<FMultithreadedSortingBuffers> BuffersWeakRef;
-	FVector3f OriginCM;
-	FVector3f Forward;
-	FMatrix44f Transform;
+	FCPUSortView View;
+	uint32 SliceBudget;
+	bool bPublishPartial;
+	uint32 Sort = 0;
 };
 } // namespace PICO::Splat
\ No newline at end of file
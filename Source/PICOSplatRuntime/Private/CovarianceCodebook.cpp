@@ -0,0 +1,146 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "CovarianceCodebook.h"
+
+#if WITH_EDITOR
+#include "Async/ParallelFor.h"
+#include "KMeans.h"
+#include "Math/RotationMatrix.h"
+#include "Math/ScaleMatrix.h"
+#include "Misc/AssertionMacros.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+// Log-scales, then rotation.
+constexpr int32 NUM_FEATURES = 7;
+// Smallest scale clustered, so flat splats have a finite log-scale.
+constexpr float MIN_SCALE_CM = 1e-4f;
+
+/**
+ * Gets the point a splat is clustered at. Log-scales make distances relative
+ * to splat size, so small splats are clustered as finely as large ones.
+ *
+ * @param Rotation - Rotation of the splat.
+ * @param ScaleCM - Scale of the splat, in centimeters.
+ * @param OutFeatures - Returns the point, as `NUM_FEATURES` floats.
+ */
+void MakeFeatures(
+	const FQuat4f& Rotation, const FVector3f& ScaleCM, float* OutFeatures)
+{
+	// q and -q are the same rotation, so only one hemisphere is used.
+	FQuat4f Q = Rotation.GetNormalized();
+	if (Q.W < 0.f)
+	{
+		Q = FQuat4f(-Q.X, -Q.Y, -Q.Z, -Q.W);
+	}
+
+	OutFeatures[0] = FMath::Loge(FMath::Max(ScaleCM.X, MIN_SCALE_CM));
+	OutFeatures[1] = FMath::Loge(FMath::Max(ScaleCM.Y, MIN_SCALE_CM));
+	OutFeatures[2] = FMath::Loge(FMath::Max(ScaleCM.Z, MIN_SCALE_CM));
+	OutFeatures[3] = Q.X;
+	OutFeatures[4] = Q.Y;
+	OutFeatures[5] = Q.Z;
+	OutFeatures[6] = Q.W;
+}
+
+FMatrix44f MakeSigma(const FQuat4f& Rotation, const FVector3f& ScaleCM)
+{
+	const FMatrix44f R = FRotationMatrix44f::Make(Rotation);
+	const FMatrix44f S = FScaleMatrix44f::Make(ScaleCM);
+	return R.GetTransposed() * S * S * R;
+}
+} // namespace
+
+FCovarianceCodebook FCovarianceCodebook::Build(
+	TConstArrayView<FQuat4f> Rotations,
+	TConstArrayView<FVector3f> ScalesCM,
+	int32 MaxEntries)
+{
+	const int32 NumSplats = Rotations.Num();
+	check(ScalesCM.Num() == NumSplats);
+	check(MaxEntries >= 1 && MaxEntries <= 1 << 16);
+
+	TArray<float> Features;
+	Features.SetNumUninitialized(NumSplats * NUM_FEATURES);
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		MakeFeatures(
+			Rotations[Index], ScalesCM[Index], &Features[Index * NUM_FEATURES]);
+	}
+
+	TArray<float> Centroids;
+	TArray<int32> Assignments;
+	ClusterKMeans(Features, NUM_FEATURES, MaxEntries, Centroids, Assignments);
+
+	// Rebuild a covariance from each centroid.
+	FCovarianceCodebook Codebook;
+	const int32 NumEntries = Centroids.Num() / NUM_FEATURES;
+	TArray<FMatrix44f> Sigmas;
+	Sigmas.SetNumUninitialized(NumEntries);
+	TArray<float> EntryRadiiCM;
+	EntryRadiiCM.SetNumUninitialized(NumEntries);
+	for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+	{
+		const float* V = &Centroids[Entry * NUM_FEATURES];
+		const FVector3f ScaleCM(
+			FMath::Exp(V[0]), FMath::Exp(V[1]), FMath::Exp(V[2]));
+		const FQuat4f Rotation =
+			FQuat4f(V[3], V[4], V[5], V[6]).GetNormalized();
+		Sigmas[Entry] = MakeSigma(Rotation, ScaleCM);
+		EntryRadiiCM[Entry] = ScaleCM.GetMax();
+	}
+	Codebook.Entries.SetNumUninitialized(NumEntries);
+	FPackedCovMat::PackArray(Sigmas, Codebook.Entries);
+
+	Codebook.Indices.SetNumUninitialized(NumSplats);
+	Codebook.RadiiCM.SetNumUninitialized(NumSplats);
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		Codebook.Indices[Index] = uint16(Assignments[Index]);
+		Codebook.RadiiCM[Index] = EntryRadiiCM[Assignments[Index]];
+	}
+
+	// Measure error against each splat's own covariance.
+	TArray<float> Errors;
+	Errors.SetNumUninitialized(NumSplats);
+	ParallelFor(
+		NumSplats,
+		[&](int32 Index)
+		{
+			const FMatrix44f Sigma =
+				MakeSigma(Rotations[Index], ScalesCM[Index]);
+			const FMatrix44f& Quantized = Sigmas[Assignments[Index]];
+
+			float ErrorSquared = 0.f;
+			float NormSquared = 0.f;
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				for (int32 Column = 0; Column < 3; ++Column)
+				{
+					ErrorSquared += FMath::Square(
+						Quantized.M[Row][Column] - Sigma.M[Row][Column]);
+					NormSquared += FMath::Square(Sigma.M[Row][Column]);
+				}
+			}
+			Errors[Index] = NormSquared > 0.f
+			                    ? FMath::Sqrt(ErrorSquared / NormSquared)
+			                    : 0.f;
+		});
+
+	double ErrorSum = 0.0;
+	for (const float Error : Errors)
+	{
+		ErrorSum += Error;
+		Codebook.MaxError = FMath::Max(Codebook.MaxError, Error);
+	}
+	Codebook.MeanError = NumSplats > 0 ? float(ErrorSum / NumSplats) : 0.f;
+
+	return Codebook;
+}
+
+} // namespace PICO::Splat
+#endif
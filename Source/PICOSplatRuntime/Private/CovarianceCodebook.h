@@ -0,0 +1,55 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/Float16.h"
+#include "Math/Quat.h"
+#include "Math/Vector.h"
+#include "PackedTypes.h"
+
+#if WITH_EDITOR
+namespace PICO::Splat
+{
+
+/**
+ * Covariances vector-quantized into a shared codebook, with a 16-bit index
+ * per splat.
+ *
+ * Built at import by k-means over each splat's log-scales and rotation, so
+ * splats of similar relative size and orientation share an entry.
+ */
+struct FCovarianceCodebook
+{
+	// Packed covariance matrices, in cm^2.
+	TArray<FPackedCovMat> Entries;
+	// Index of each splat's entry.
+	TArray<uint16> Indices;
+	// Radius of each splat's entry along its largest axis, at one standard
+	// deviation, in centimeters.
+	TArray<FFloat16> RadiiCM;
+	// Mean and largest error of each splat's quantized covariance, before
+	// packing, relative to its own. Measured by Frobenius norm.
+	float MeanError = 0.f;
+	float MaxError = 0.f;
+
+	/**
+	 * Clusters covariances into a codebook.
+	 *
+	 * @param Rotations - Rotation of each splat.
+	 * @param ScalesCM - Scale of each splat, in centimeters.
+	 * @param MaxEntries - Largest number of entries, in [1, 65536]. Assets
+	 * with fewer splats get an entry per splat.
+	 * @return The codebook.
+	 */
+	static FCovarianceCodebook Build(
+		TConstArrayView<FQuat4f> Rotations,
+		TConstArrayView<FVector3f> ScalesCM,
+		int32 MaxEntries);
+};
+
+} // namespace PICO::Splat
+#endif
@@ -0,0 +1,114 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Math/UnrealMathUtility.h"
+#include "Math/Vector4.h"
+#include "SplatSettings.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Foveated thinning, shared by CPU sorting and `FAdjustSplatsCS`, which *must*
+ * agree on which splats are kept.
+ *
+ * Each splat is kept with a probability rising from its ring's density, for
+ * splats of no importance, to 1, for splats at the importance area. Importance
+ * is opacity times projected area. A fixed random number per splat decides,
+ * so the same splats are kept each frame.
+ *
+ * Both measure splats by their radius along their largest axis, from the
+ * asset's radii, projected by `FSplatSceneProxy::GetRadiusToPixels`, and both
+ * cull splats below the minimum projected radius before thinning.
+ */
+struct FFoveation
+{
+	static constexpr int32 MAX_RINGS = 4;
+
+	// Inner radius of each ring, ascending, as a fraction of the distance from
+	// the center of the view to its left or right edge. Unused rings are
+	// beyond any splat.
+	FVector4f RingRadii = FVector4f(UE_BIG_NUMBER);
+	// Fraction of splats of no importance kept in each ring.
+	FVector4f RingDensities = FVector4f(1.f);
+	// Opacity times projected area at which splats are always kept, in pixels
+	// squared.
+	float ImportanceArea = 0.f;
+	// Whether thinning is enabled.
+	bool bEnabled = false;
+
+	/**
+	 * @return Foveation, from the current settings.
+	 */
+	static FFoveation FromSettings()
+	{
+		FFoveation Foveation;
+		if (!USplatSettings::IsFoveatedThinningEnabled())
+		{
+			return Foveation;
+		}
+
+		TArray<FSplatFoveationRing> Rings =
+			USplatSettings::GetFoveationRings();
+		Rings.Sort(
+			[](const FSplatFoveationRing& A, const FSplatFoveationRing& B)
+			{ return A.InnerRadius < B.InnerRadius; });
+
+		const int32 NumRings = FMath::Min(Rings.Num(), MAX_RINGS);
+		for (int32 Ring = 0; Ring < NumRings; ++Ring)
+		{
+			Foveation.RingRadii[Ring] =
+				FMath::Max(Rings[Ring].InnerRadius, 0.f);
+			Foveation.RingDensities[Ring] =
+				FMath::Clamp(Rings[Ring].Density, 0.05f, 1.f);
+		}
+		Foveation.ImportanceArea = USplatSettings::GetFoveationImportanceArea();
+		Foveation.bEnabled = NumRings > 0;
+
+		return Foveation;
+	}
+
+	/**
+	 * @param Eccentricity - Distance of a splat from the center of the view, as
+	 * a fraction of the distance to its left or right edge.
+	 * @param Importance - Opacity times projected area, in pixels squared.
+	 * @return Probability of the splat being kept.
+	 */
+	float GetKeepProbability(float Eccentricity, float Importance) const
+	{
+		float Density = 1.f;
+		for (int32 Ring = 0; Ring < MAX_RINGS; ++Ring)
+		{
+			if (Eccentricity >= RingRadii[Ring])
+			{
+				Density = RingDensities[Ring];
+			}
+		}
+
+		const float Weight = ImportanceArea > 0.f
+		                         ? FMath::Min(Importance / ImportanceArea, 1.f)
+		                         : 1.f;
+		return FMath::Lerp(Density, 1.f, Weight);
+	}
+
+	/**
+	 * Gets a fixed random number for a splat, from a PCG hash of its index.
+	 * Matches `get_splat_random` in `AdjustSplatsCS.usf`.
+	 *
+	 * @param Index - Index of the splat.
+	 * @return Random number, in [0, 1).
+	 */
+	static float GetSplatRandom(uint32 Index)
+	{
+		const uint32 State = Index * 747796405u + 2891336453u;
+		const uint32 Word =
+			((State >> ((State >> 28u) + 4u)) ^ State) * 277803737u;
+		const uint32 Hash = (Word >> 22u) ^ Word;
+		return float(Hash >> 8u) * (1.f / float(1u << 24u));
+	}
+};
+
+} // namespace PICO::Splat
@@ -0,0 +1,238 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "KMeans.h"
+
+#if WITH_EDITOR
+#include <atomic>
+
+#include "Async/ParallelFor.h"
+#include "Misc/AssertionMacros.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+constexpr int32 NUM_ITERATIONS = 8;
+
+float GetDistanceSquared(const float* A, const float* B, int32 Dimension)
+{
+	float Sum = 0.f;
+	for (int32 Index = 0; Index < Dimension; ++Index)
+	{
+		Sum += FMath::Square(A[Index] - B[Index]);
+	}
+	return Sum;
+}
+
+/**
+ * Clusters some points with Lloyd's algorithm. Seeded from evenly spaced
+ * members, so results are deterministic.
+ *
+ * @param Points - All points, `Dimension` floats each.
+ * @param Dimension - Number of floats per point.
+ * @param Members - Indices of the points to cluster.
+ * @param NumClusters - Number of clusters, in [1, Members.Num()].
+ * @param Flags - How assignment is parallelized.
+ * @param OutCentroids - Returns the center of each cluster.
+ * @param OutAssignments - Returns the cluster of each member.
+ */
+void KMeans(
+	TConstArrayView<float> Points,
+	int32 Dimension,
+	TConstArrayView<int32> Members,
+	int32 NumClusters,
+	EParallelForFlags Flags,
+	TArray<float>& OutCentroids,
+	TArray<int32>& OutAssignments)
+{
+	const int32 NumMembers = Members.Num();
+	check(NumClusters >= 1 && NumClusters <= NumMembers);
+
+	OutCentroids.SetNumUninitialized(NumClusters * Dimension);
+	for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+	{
+		const int32 Seed = Members[int64(Cluster) * NumMembers / NumClusters];
+		FMemory::Memcpy(
+			&OutCentroids[Cluster * Dimension],
+			&Points[Seed * Dimension],
+			Dimension * sizeof(float));
+	}
+	OutAssignments.Init(INDEX_NONE, NumMembers);
+
+	TArray<double> Sums;
+	TArray<int32> Counts;
+	for (int32 Iteration = 0; Iteration < NUM_ITERATIONS; ++Iteration)
+	{
+		std::atomic<int32> NumChanged = 0;
+		ParallelFor(
+			NumMembers,
+			[&](int32 Member)
+			{
+				const float* Point = &Points[Members[Member] * Dimension];
+				int32 Nearest = 0;
+				float NearestDistance = TNumericLimits<float>::Max();
+				for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+				{
+					const float Distance = GetDistanceSquared(
+						Point, &OutCentroids[Cluster * Dimension], Dimension);
+					if (Distance < NearestDistance)
+					{
+						Nearest = Cluster;
+						NearestDistance = Distance;
+					}
+				}
+
+				if (OutAssignments[Member] != Nearest)
+				{
+					OutAssignments[Member] = Nearest;
+					++NumChanged;
+				}
+			},
+			Flags);
+
+		if (NumChanged == 0)
+		{
+			break;
+		}
+
+		// Move each centroid to the mean of its members. Empty clusters stay.
+		Sums.Init(0.0, NumClusters * Dimension);
+		Counts.Init(0, NumClusters);
+		for (int32 Member = 0; Member < NumMembers; ++Member)
+		{
+			const int32 Cluster = OutAssignments[Member];
+			const float* Point = &Points[Members[Member] * Dimension];
+			for (int32 Index = 0; Index < Dimension; ++Index)
+			{
+				Sums[Cluster * Dimension + Index] += Point[Index];
+			}
+			++Counts[Cluster];
+		}
+		for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+		{
+			if (Counts[Cluster] == 0)
+			{
+				continue;
+			}
+			for (int32 Index = 0; Index < Dimension; ++Index)
+			{
+				const double Sum = Sums[Cluster * Dimension + Index];
+				OutCentroids[Cluster * Dimension + Index] =
+					float(Sum / Counts[Cluster]);
+			}
+		}
+	}
+}
+} // namespace
+
+void ClusterKMeans(
+	TConstArrayView<float> Points,
+	int32 Dimension,
+	int32 MaxClusters,
+	TArray<float>& OutCentroids,
+	TArray<int32>& OutAssignments)
+{
+	check(Dimension > 0);
+	check(MaxClusters > 0);
+	check(Points.Num() % Dimension == 0);
+	const int32 NumPoints = Points.Num() / Dimension;
+
+	if (NumPoints <= MaxClusters)
+	{
+		OutCentroids = TArray<float>(Points.GetData(), Points.Num());
+		OutAssignments.SetNumUninitialized(NumPoints);
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			OutAssignments[Index] = Index;
+		}
+		return;
+	}
+
+	TArray<int32> AllPoints;
+	AllPoints.SetNumUninitialized(NumPoints);
+	for (int32 Index = 0; Index < NumPoints; ++Index)
+	{
+		AllPoints[Index] = Index;
+	}
+
+	const int32 NumGroups = FMath::CeilToInt(FMath::Sqrt(float(MaxClusters)));
+	TArray<float> GroupCentroids;
+	TArray<int32> GroupAssignments;
+	KMeans(
+		Points,
+		Dimension,
+		AllPoints,
+		NumGroups,
+		EParallelForFlags::None,
+		GroupCentroids,
+		GroupAssignments);
+
+	TArray<TArray<int32>> Groups;
+	Groups.SetNum(NumGroups);
+	for (int32 Index = 0; Index < NumPoints; ++Index)
+	{
+		Groups[GroupAssignments[Index]].Add(Index);
+	}
+
+	// Share clusters between groups by size, with at least one each.
+	int32 NumNonEmpty = 0;
+	for (const TArray<int32>& Group : Groups)
+	{
+		NumNonEmpty += Group.Num() > 0 ? 1 : 0;
+	}
+	TArray<int32> Offsets;
+	Offsets.SetNumUninitialized(NumGroups + 1);
+	Offsets[0] = 0;
+	for (int32 Group = 0; Group < NumGroups; ++Group)
+	{
+		const int32 Size = Groups[Group].Num();
+		int32 NumClusters = 0;
+		if (Size > 0)
+		{
+			const int64 Share =
+				int64(MaxClusters - NumNonEmpty) * Size / NumPoints;
+			NumClusters = FMath::Min(int32(Share) + 1, Size);
+		}
+		Offsets[Group + 1] = Offsets[Group] + NumClusters;
+	}
+	check(Offsets[NumGroups] <= MaxClusters);
+
+	OutCentroids.SetNumUninitialized(Offsets[NumGroups] * Dimension);
+	OutAssignments.SetNumUninitialized(NumPoints);
+	ParallelFor(
+		NumGroups,
+		[&](int32 Group)
+		{
+			const int32 NumClusters = Offsets[Group + 1] - Offsets[Group];
+			if (NumClusters == 0)
+			{
+				return;
+			}
+
+			TArray<float> Centroids;
+			TArray<int32> Assignments;
+			KMeans(
+				Points,
+				Dimension,
+				Groups[Group],
+				NumClusters,
+				EParallelForFlags::ForceSingleThread,
+				Centroids,
+				Assignments);
+
+			FMemory::Memcpy(
+				&OutCentroids[Offsets[Group] * Dimension],
+				Centroids.GetData(),
+				Centroids.Num() * sizeof(float));
+			for (int32 Member = 0; Member < Groups[Group].Num(); ++Member)
+			{
+				OutAssignments[Groups[Group][Member]] =
+					Offsets[Group] + Assignments[Member];
+			}
+		});
+}
+
+} // namespace PICO::Splat
+#endif
@@ -0,0 +1,38 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+
+#if WITH_EDITOR
+namespace PICO::Splat
+{
+
+/**
+ * Clusters points with k-means, for building codebooks at import.
+ *
+ * Clustering is hierarchical: points are first split into about the square
+ * root of the maximum number of clusters, each of which is then clustered
+ * into a share of the clusters proportional to its size. This keeps time close
+ * to linear in the number of points. Results are deterministic.
+ *
+ * @param Points - Points to cluster, `Dimension` floats each.
+ * @param Dimension - Number of floats per point.
+ * @param MaxClusters - Largest number of clusters. If there are no more points
+ * than this, each point gets its own cluster.
+ * @param OutCentroids - Returns the center of each cluster, `Dimension` floats
+ * each.
+ * @param OutAssignments - Returns the cluster of each point.
+ */
+void ClusterKMeans(
+	TConstArrayView<float> Points,
+	int32 Dimension,
+	int32 MaxClusters,
+	TArray<float>& OutCentroids,
+	TArray<int32>& OutAssignments);
+
+} // namespace PICO::Splat
+#endif
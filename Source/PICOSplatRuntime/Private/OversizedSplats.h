@@ -0,0 +1,159 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Math/Matrix.h"
+#include "Math/UnrealMathUtility.h"
+#include "PackedTypes.h"
+#include "SplatConstants.h"
+#include "SplatSettings.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * CPU reference for the oversized splat policy of `FAdjustSplatsCS`, which
+ * *must* agree with it on which splats are oversized, and how each is
+ * adjusted.
+ *
+ * Splats are measured by their projected footprint, from the packed
+ * covariance, projected with the Jacobian of the perspective divide, as in EWA
+ * splatting. Splats whose radius along their major axis exceeds the maximum
+ * are culled, have their footprint clamped to it, or are faded by the area
+ * they exceed it by. Splats nearer than the near plane are never drawn, so are
+ * left as they are.
+ */
+struct FOversizedSplats
+{
+	/**
+	 * Adjustment of a splat, relative to the asset's.
+	 */
+	struct FAdjustment
+	{
+		float FootprintScale = 1.f;
+		float OpacityScale = 1.f;
+		bool bOversized = false;
+	};
+
+	// Matches `FIndexedDistance`, and `NEAR_CLIP_CM` in `AdjustSplatsCS.usf`.
+	static constexpr float NEAR_CLIP_CM = 10.f;
+
+	EOversizedSplatPolicy Policy = EOversizedSplatPolicy::None;
+	// Projected radius above which splats are oversized, in pixels.
+	float MaxRadiusPx = UE_MAX_FLT;
+
+	/**
+	 * Projects a splat, and gets its radius along its major axis. Matches
+	 * `get_radius_px`.
+	 *
+	 * @param LocalToView - Transform from the asset to view space, as row
+	 * vectors.
+	 * @param FocalLength - Focal length of the view, in pixels.
+	 * @param PosView - Position of the splat in view space, in front of the
+	 * near plane.
+	 * @param Covariance - Covariance of the splat.
+	 * @return Projected radius, in pixels.
+	 */
+	static float GetRadiusPixels(
+		const FMatrix44f& LocalToView,
+		float FocalLength,
+		const FVector3f& PosView,
+		const FPackedCovMat& Covariance)
+	{
+		// Row vectors, so Σ_view = Wᵀ Σ W, with W the upper-left 3x3.
+		const FMatrix44f Cov = Covariance.Unpack();
+		float CovView[3][3] = {};
+		for (int32 Row = 0; Row < 3; ++Row)
+		{
+			for (int32 Column = 0; Column < 3; ++Column)
+			{
+				for (int32 K = 0; K < 3; ++K)
+				{
+					for (int32 L = 0; L < 3; ++L)
+					{
+						CovView[Row][Column] += LocalToView.M[K][Row] *
+						                        Cov.M[K][L] *
+						                        LocalToView.M[L][Column];
+					}
+				}
+			}
+		}
+
+		// Jacobian of the perspective projection, in pixels.
+		const float InvZ = 1.f / PosView.Z;
+		const float Scale = FocalLength * InvZ;
+		const FVector3f J0(Scale, 0.f, -Scale * PosView.X * InvZ);
+		const FVector3f J1(0.f, Scale, -Scale * PosView.Y * InvZ);
+		auto Project = [&CovView](const FVector3f& A, const FVector3f& B)
+		{
+			float Sum = 0.f;
+			for (int32 Row = 0; Row < 3; ++Row)
+			{
+				for (int32 Column = 0; Column < 3; ++Column)
+				{
+					Sum += A[Row] * CovView[Row][Column] * B[Column];
+				}
+			}
+			return Sum;
+		};
+		const float A = Project(J0, J0);
+		const float B = Project(J0, J1);
+		const float C = Project(J1, J1);
+
+		// Largest eigenvalue of the projected covariance.
+		const float Mid = 0.5f * (A + C);
+		const float Det = A * C - B * B;
+		const float Lambda =
+			Mid + FMath::Sqrt(FMath::Max(Mid * Mid - Det, 0.f));
+
+		return SplatRadiusStdDevs * FMath::Sqrt(Lambda);
+	}
+
+	/**
+	 * Adjusts a splat, as `FAdjustSplatsCS` does before thinning.
+	 *
+	 * @param LocalToView - Transform from the asset to view space, as row
+	 * vectors.
+	 * @param FocalLength - Focal length of the view, in pixels.
+	 * @param PosView - Position of the splat in view space.
+	 * @param Covariance - Covariance of the splat.
+	 * @return The adjustment of the splat.
+	 */
+	FAdjustment Adjust(
+		const FMatrix44f& LocalToView,
+		float FocalLength,
+		const FVector3f& PosView,
+		const FPackedCovMat& Covariance) const
+	{
+		FAdjustment Adjustment;
+		if (Policy == EOversizedSplatPolicy::None ||
+		    PosView.Z < NEAR_CLIP_CM)
+		{
+			return Adjustment;
+		}
+
+		const float RadiusPx =
+			GetRadiusPixels(LocalToView, FocalLength, PosView, Covariance);
+		if (RadiusPx <= MaxRadiusPx)
+		{
+			return Adjustment;
+		}
+
+		Adjustment.bOversized = true;
+		const float Scale = MaxRadiusPx / RadiusPx;
+		if (Policy == EOversizedSplatPolicy::Fade)
+		{
+			Adjustment.OpacityScale = Scale * Scale;
+		}
+		else
+		{
+			Adjustment.FootprintScale =
+				Policy == EOversizedSplatPolicy::Cull ? 0.f : Scale;
+		}
+		return Adjustment;
+	}
+};
+
+} // namespace PICO::Splat
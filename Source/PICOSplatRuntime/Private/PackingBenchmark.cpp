@@ -0,0 +1,151 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Logging.h"
+#include "Math/RandomStream.h"
+#include "PackedTypes.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+constexpr int32 DEFAULT_NUM_SPLATS = 1 << 20;
+
+/**
+ * Times a function, taking the best of a few runs to reduce noise.
+ *
+ * @param Function - Function to time.
+ * @return Fastest time taken, in milliseconds.
+ */
+template <typename FunctionType> double TimeBestOf(FunctionType&& Function)
+{
+	constexpr int32 NUM_RUNS = 5;
+
+	double BestMs = TNumericLimits<double>::Max();
+	for (int32 Run = 0; Run < NUM_RUNS; ++Run)
+	{
+		const double Start = FPlatformTime::Seconds();
+		Function();
+		BestMs =
+			FMath::Min(BestMs, (FPlatformTime::Seconds() - Start) * 1000.0);
+	}
+	return BestMs;
+}
+
+/**
+ * Compares the scalar and batch packers, for speed and equality, on random
+ * splats.
+ *
+ * @param Args - Optionally, the number of splats to pack.
+ */
+void BenchmarkPacking(const TArray<FString>& Args)
+{
+	const int32 NumSplats = Args.Num() > 0
+	                            ? FMath::Max(FCString::Atoi(*Args[0]), 1)
+	                            : DEFAULT_NUM_SPLATS;
+
+	// Fixed seed, so runs are comparable.
+	FRandomStream Random(0x5E1A7);
+
+	TArray<FVector3f> Positions;
+	Positions.SetNumUninitialized(NumSplats);
+	TArray<FMatrix44f> Sigmas;
+	Sigmas.SetNumUninitialized(NumSplats);
+	for (int32 Index = 0; Index < NumSplats; ++Index)
+	{
+		Positions[Index] = FVector3f(Random.GetUnitVector()) *
+		                   Random.FRandRange(0.f, 100.f);
+
+		const FQuat4f Rotation(
+			FVector3f(Random.GetUnitVector()), Random.FRandRange(0.f, UE_PI));
+		const FMatrix44f R = FRotationMatrix44f::Make(Rotation);
+		const FMatrix44f S = FScaleMatrix44f::Make(FVector3f(
+			Random.FRandRange(0.01f, 10.f),
+			Random.FRandRange(0.01f, 10.f),
+			Random.FRandRange(0.01f, 10.f)));
+		Sigmas[Index] = R.GetTransposed() * S * S * R;
+	}
+
+	FVector3f Min(TNumericLimits<float>::Max());
+	FVector3f Max(TNumericLimits<float>::Lowest());
+	for (const FVector3f& Position : Positions)
+	{
+		Min = Min.ComponentMin(Position);
+		Max = Max.ComponentMax(Position);
+	}
+
+	TArray<FPackedPos> ScalarPositions;
+	ScalarPositions.SetNumUninitialized(NumSplats);
+	TArray<FPackedPos> BatchPositions;
+	BatchPositions.SetNumUninitialized(NumSplats);
+	TArray<FPackedCovMat> ScalarCovariances;
+	ScalarCovariances.SetNumUninitialized(NumSplats);
+	TArray<FPackedCovMat> BatchCovariances;
+	BatchCovariances.SetNumUninitialized(NumSplats);
+
+	const double ScalarPositionsMs = TimeBestOf(
+		[&]()
+		{
+			for (int32 Index = 0; Index < NumSplats; ++Index)
+			{
+				ScalarPositions[Index] =
+					(Positions[Index] - Min) / (Max - Min);
+			}
+		});
+	const double BatchPositionsMs = TimeBestOf(
+		[&]() { FPackedPos::PackArray(Positions, Min, Max, BatchPositions); });
+	const double ScalarCovariancesMs = TimeBestOf(
+		[&]()
+		{
+			for (int32 Index = 0; Index < NumSplats; ++Index)
+			{
+				ScalarCovariances[Index] = FPackedCovMat(Sigmas[Index]);
+			}
+		});
+	const double BatchCovariancesMs = TimeBestOf(
+		[&]() { FPackedCovMat::PackArray(Sigmas, BatchCovariances); });
+
+	const bool bPositionsMatch =
+		FMemory::Memcmp(
+			ScalarPositions.GetData(),
+			BatchPositions.GetData(),
+			NumSplats * sizeof(FPackedPos)) == 0;
+	const bool bCovariancesMatch =
+		FMemory::Memcmp(
+			ScalarCovariances.GetData(),
+			BatchCovariances.GetData(),
+			NumSplats * sizeof(FPackedCovMat)) == 0;
+
+	PICO_LOGD("Packing %d splats:", NumSplats);
+	PICO_LOGD(
+		"  Positions: %.2f ms scalar, %.2f ms batch (%.1fx), %s.",
+		ScalarPositionsMs,
+		BatchPositionsMs,
+		ScalarPositionsMs / BatchPositionsMs,
+		bPositionsMatch ? TEXT("bit-exact") : TEXT("MISMATCHED"));
+	PICO_LOGD(
+		"  Covariances: %.2f ms scalar, %.2f ms batch (%.1fx), %s.",
+		ScalarCovariancesMs,
+		BatchCovariancesMs,
+		ScalarCovariancesMs / BatchCovariancesMs,
+		bCovariancesMatch ? TEXT("bit-exact") : TEXT("MISMATCHED"));
+	if (!bPositionsMatch || !bCovariancesMatch)
+	{
+		PICO_LOGE("Batch packing does not match scalar packing.");
+	}
+}
+
+FAutoConsoleCommand BenchmarkPackingCommand(
+	TEXT("PICOSplat.BenchmarkPacking"),
+	TEXT("Times scalar and batch packing of splat positions and covariances, ")
+		TEXT("and checks they match. Optionally takes the number of splats."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkPacking));
+} // namespace
+} // namespace PICO::Splat
+
+#endif // !UE_BUILD_SHIPPING
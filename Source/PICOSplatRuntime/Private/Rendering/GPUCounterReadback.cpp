@@ -0,0 +1,67 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "GPUCounterReadback.h"
+
+#include "RenderGraphUtils.h"
+
+namespace PICO::Splat
+{
+
+FGPUCounterReadback::FGPUCounterReadback(const TCHAR* InName) : Name(InName)
+{
+	for (int32 Index = 0; Index < MAX_IN_FLIGHT; ++Index)
+	{
+		Readbacks.Add(MakeUnique<FRHIGPUBufferReadback>(Name));
+	}
+}
+
+FRDGBufferUAVRef FGPUCounterReadback::Begin(FRDGBuilder& GraphBuilder)
+{
+	check(IsInRenderingThread());
+
+	// Readbacks complete in the order they were enqueued.
+	while (NumInFlight > 0)
+	{
+		const int32 Oldest =
+			(NextReadback + MAX_IN_FLIGHT - NumInFlight) % MAX_IN_FLIGHT;
+		FRHIGPUBufferReadback& Readback = *Readbacks[Oldest];
+		if (!Readback.IsReady())
+		{
+			break;
+		}
+
+		Latest = *static_cast<const uint32*>(Readback.Lock(sizeof(uint32)));
+		Readback.Unlock();
+		--NumInFlight;
+	}
+
+	Counter = GraphBuilder.CreateBuffer(
+		FRDGBufferDesc::CreateBufferDesc(sizeof(uint32), 1), Name);
+	FRDGBufferUAVRef CounterUAV = GraphBuilder.CreateUAV(Counter, PF_R32_UINT);
+	AddClearUAVPass(GraphBuilder, CounterUAV, 0u);
+
+	return CounterUAV;
+}
+
+void FGPUCounterReadback::End(FRDGBuilder& GraphBuilder)
+{
+	check(IsInRenderingThread());
+	check(Counter);
+
+	if (NumInFlight < MAX_IN_FLIGHT)
+	{
+		AddEnqueueCopyPass(
+			GraphBuilder,
+			Readbacks[NextReadback].Get(),
+			Counter,
+			sizeof(uint32));
+		NextReadback = (NextReadback + 1) % MAX_IN_FLIGHT;
+		++NumInFlight;
+	}
+
+	Counter = nullptr;
+}
+
+} // namespace PICO::Splat
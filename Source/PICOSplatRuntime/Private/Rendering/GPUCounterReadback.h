@@ -0,0 +1,63 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "RHIGPUReadback.h"
+#include "RenderGraphBuilder.h"
+#include "Templates/UniquePtr.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Reads a counter written by GPU passes back to the CPU, for stats. Results
+ * arrive a few frames late, so the render thread never waits on the GPU.
+ *
+ * Render thread only.
+ */
+class FGPUCounterReadback
+{
+public:
+	/**
+	 * @param InName - Name of the counter buffer, for debugging.
+	 */
+	explicit FGPUCounterReadback(const TCHAR* InName);
+
+	/**
+	 * Collects any finished readbacks, and creates this frame's counter,
+	 * cleared to zero.
+	 *
+	 * @param GraphBuilder - Graph to add the clear to.
+	 * @return UAV for passes to add to the counter.
+	 */
+	FRDGBufferUAVRef Begin(FRDGBuilder& GraphBuilder);
+
+	/**
+	 * Enqueues a readback of this frame's counter, after all passes writing to
+	 * it. Skipped if too many readbacks are already in flight.
+	 *
+	 * @param GraphBuilder - Graph to add the copy to.
+	 */
+	void End(FRDGBuilder& GraphBuilder);
+
+	/**
+	 * @return The most recent value read back, or 0 if none yet.
+	 */
+	uint32 GetLatest() const { return Latest; }
+
+private:
+	static constexpr int32 MAX_IN_FLIGHT = 4;
+
+	const TCHAR* Name;
+	TArray<TUniquePtr<FRHIGPUBufferReadback>, TFixedAllocator<MAX_IN_FLIGHT>>
+		Readbacks;
+	int32 NextReadback = 0;
+	int32 NumInFlight = 0;
+	uint32 Latest = 0;
+	FRDGBufferRef Counter = nullptr;
+};
+
+} // namespace PICO::Splat
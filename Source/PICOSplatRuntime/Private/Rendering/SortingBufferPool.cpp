@@ -0,0 +1,152 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SortingBufferPool.h"
+
+#include "HAL/PlatformTime.h"
+#include "RenderingThread.h"
+#include "SplatSettings.h"
+#include "SplatStats.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+/**
+ * @return GPU memory used by sorting buffers of the given capacity, in bytes.
+ */
+int64 GetGPUSize(uint32 Capacity)
+{
+	return 2 * int64(Capacity) * sizeof(FIndexedDistance);
+}
+} // namespace
+
+FSortingBufferPool::~FSortingBufferPool()
+{
+	if (Free.IsEmpty())
+	{
+		return;
+	}
+
+	// This may be destroyed with the view extension, off the render thread.
+	ENQUEUE_RENDER_COMMAND(ReleaseSortingBufferPool)(
+		[Free = MoveTemp(Free)](FRHICommandList& RHICmdList)
+		{
+			for (const FEntry& Entry : Free)
+			{
+				DEC_MEMORY_STAT_BY(
+					STAT_SplatSortingBufferMemory,
+					GetGPUSize(Entry.Buffers->GetCapacity()));
+				Entry.Buffers->ReleaseResources();
+			}
+		});
+}
+
+uint32 FSortingBufferPool::GetCapacityFor(uint32 NumVisible, uint32 NumSplats)
+{
+	const uint32 Wanted = FMath::Max(NumVisible, MIN_CAPACITY);
+
+	// Round up to a multiple of an eighth of the largest power of two below.
+	const uint32 Step = (1u << FMath::FloorLog2(Wanted)) / 8;
+	const uint32 Capacity = FMath::DivideAndRoundUp(Wanted, Step) * Step;
+
+	return FMath::Min(Capacity, NumSplats);
+}
+
+std::shared_ptr<FMultithreadedSortingBuffers> FSortingBufferPool::Acquire(
+	FRHICommandListBase& RHICmdList, uint32 NumVisible, uint32 NumSplats)
+{
+	check(IsInRenderingThread());
+
+	const uint32 Capacity = GetCapacityFor(NumVisible, NumSplats);
+
+	// Take the smallest pooled buffers that fit, unless they would waste more
+	// than they use.
+	int32 BestIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Free.Num(); ++Index)
+	{
+		const uint32 FreeCapacity = Free[Index].Buffers->GetCapacity();
+		if (FreeCapacity < Capacity || FreeCapacity > 2 * Capacity)
+		{
+			continue;
+		}
+		if (BestIndex == INDEX_NONE ||
+		    FreeCapacity < Free[BestIndex].Buffers->GetCapacity())
+		{
+			BestIndex = Index;
+		}
+	}
+
+	++NumInUse;
+	SET_DWORD_STAT(STAT_SplatSortingBuffersInUse, NumInUse);
+
+	if (BestIndex != INDEX_NONE)
+	{
+		std::shared_ptr<FMultithreadedSortingBuffers> Buffers =
+			MoveTemp(Free[BestIndex].Buffers);
+		Free.RemoveAtSwap(BestIndex);
+		SET_DWORD_STAT(STAT_SplatSortingBuffersPooled, Free.Num());
+		return Buffers;
+	}
+
+	std::shared_ptr<FMultithreadedSortingBuffers> Buffers =
+		std::make_shared<FMultithreadedSortingBuffers>(Capacity);
+	Buffers->InitResources_RenderThread(RHICmdList);
+	INC_MEMORY_STAT_BY(STAT_SplatSortingBufferMemory, GetGPUSize(Capacity));
+	return Buffers;
+}
+
+void FSortingBufferPool::Release(
+	std::shared_ptr<FMultithreadedSortingBuffers>&& Buffers)
+{
+	check(IsInRenderingThread());
+	check(Buffers);
+	check(NumInUse > 0);
+
+	Buffers->Reset();
+	Free.Add({MoveTemp(Buffers), FPlatformTime::Seconds()});
+
+	--NumInUse;
+	SET_DWORD_STAT(STAT_SplatSortingBuffersInUse, NumInUse);
+	SET_DWORD_STAT(STAT_SplatSortingBuffersPooled, Free.Num());
+}
+
+void FSortingBufferPool::Discard(
+	std::shared_ptr<FMultithreadedSortingBuffers>&& Buffers)
+{
+	check(IsInRenderingThread());
+	check(Buffers);
+	check(NumInUse > 0);
+
+	DEC_MEMORY_STAT_BY(
+		STAT_SplatSortingBufferMemory, GetGPUSize(Buffers->GetCapacity()));
+	Buffers->ReleaseResources();
+	Buffers.reset();
+
+	--NumInUse;
+	SET_DWORD_STAT(STAT_SplatSortingBuffersInUse, NumInUse);
+}
+
+void FSortingBufferPool::Tick(double Now)
+{
+	check(IsInRenderingThread());
+
+	const double Timeout = USplatSettings::GetSortingBufferIdleTimeout();
+	for (int32 Index = Free.Num() - 1; Index >= 0; --Index)
+	{
+		if (Now - Free[Index].ReleaseTime < Timeout)
+		{
+			continue;
+		}
+
+		DEC_MEMORY_STAT_BY(
+			STAT_SplatSortingBufferMemory,
+			GetGPUSize(Free[Index].Buffers->GetCapacity()));
+		Free[Index].Buffers->ReleaseResources();
+		Free.RemoveAtSwap(Index);
+	}
+	SET_DWORD_STAT(STAT_SplatSortingBuffersPooled, Free.Num());
+}
+
+} // namespace PICO::Splat
@@ -0,0 +1,100 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <memory>
+
+#include "CPUSorting.h"
+#include "Containers/Array.h"
+#include "RHICommandList.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Pool of CPU sorting buffers, shared by all proxies.
+ *
+ * Proxies only hold buffers while they are being sorted on CPU, and return
+ * them once idle (e.g. hidden, or sorted on GPU) for a timeout. Returned
+ * buffers are handed to the next proxy needing buffers of a similar size, and
+ * released once unused for the same timeout.
+ *
+ * Render thread only.
+ */
+class FSortingBufferPool
+{
+public:
+	FSortingBufferPool() = default;
+	FSortingBufferPool(const FSortingBufferPool&) = delete;
+	FSortingBufferPool& operator=(const FSortingBufferPool&) = delete;
+
+	/**
+	 * Releases all pooled buffers. Buffers still held by proxies are released
+	 * by them.
+	 */
+	~FSortingBufferPool();
+
+	/**
+	 * Takes buffers from the pool, or allocates new ones if none fit.
+	 *
+	 * @param RHICmdList - The RHI command list to create resources with.
+	 * @param NumVisible - Number of splats expected to be visible.
+	 * @param NumSplats - Number of splats in the asset, which bounds capacity.
+	 * @return Buffers, with capacity for at least `NumVisible` splats.
+	 */
+	std::shared_ptr<FMultithreadedSortingBuffers> Acquire(
+		FRHICommandListBase& RHICmdList, uint32 NumVisible, uint32 NumSplats);
+
+	/**
+	 * Returns buffers to the pool. They must be idle, and no longer referenced
+	 * by the caller.
+	 *
+	 * @param Buffers - Buffers previously given by `Acquire`.
+	 */
+	void Release(std::shared_ptr<FMultithreadedSortingBuffers>&& Buffers);
+
+	/**
+	 * Releases buffers which can not be returned to the pool, as a sorting
+	 * task or copy may still be using them.
+	 *
+	 * @param Buffers - Buffers previously given by `Acquire`.
+	 */
+	void Discard(std::shared_ptr<FMultithreadedSortingBuffers>&& Buffers);
+
+	/**
+	 * Releases buffers which have been in the pool for longer than the idle
+	 * timeout. Call once per frame.
+	 *
+	 * @param Now - Current time, in seconds.
+	 */
+	void Tick(double Now);
+
+	/**
+	 * Rounds a number of splats up to a buffer capacity. Capacities are
+	 * coarse, so buffers can be shared between proxies, but wasted space is
+	 * at most an eighth.
+	 *
+	 * @param NumVisible - Number of splats expected to be visible.
+	 * @param NumSplats - Number of splats in the asset, which bounds capacity.
+	 * @return Capacity, in splats.
+	 */
+	static uint32 GetCapacityFor(uint32 NumVisible, uint32 NumSplats);
+
+private:
+	struct FEntry
+	{
+		std::shared_ptr<FMultithreadedSortingBuffers> Buffers;
+		// Time returned to the pool, in seconds.
+		double ReleaseTime;
+	};
+
+	// Smallest capacity allocated, so small proxies share buffers.
+	static constexpr uint32 MIN_CAPACITY = 4096;
+
+	TArray<FEntry> Free;
+	uint32 NumInUse = 0;
+};
+
+} // namespace PICO::Splat
@@ -0,0 +1,109 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SortingController.h"
+
+#include "SplatSettings.h"
+#include "SplatStats.h"
+
+namespace PICO::Splat
+{
+
+void FSortingController::Update(
+	const FSceneView& View,
+	TConstArrayView<FSplatSceneProxy*> Proxies,
+	const FSplatFrameTimes& Times)
+{
+	check(IsInRenderingThread());
+	check(View.Family);
+
+	if (View.Family->FrameNumber == LastFrameNumber)
+	{
+		return;
+	}
+	LastFrameNumber = View.Family->FrameNumber;
+
+	// Rank by approximate screen coverage, largest first.
+	const FVector Origin = View.ViewMatrices.GetViewOrigin();
+	TArray<TPair<float, FSplatSceneProxy*>, TInlineAllocator<32>> Ranked;
+	uint64 NumHybridSplats = 0;
+	for (FSplatSceneProxy* Proxy : Proxies)
+	{
+		check(Proxy);
+		if (!Proxy->IsHybridSorting())
+		{
+			continue;
+		}
+
+		const FBoxSphereBounds& Bounds = Proxy->GetBounds();
+		const double Distance = FVector::Dist(Origin, Bounds.Origin);
+		float Coverage = float(
+			Bounds.SphereRadius / FMath::Max(Distance, Bounds.SphereRadius));
+		if (Proxy->IsSortingOnGPU())
+		{
+			Coverage *= GPU_HYSTERESIS;
+		}
+
+		Ranked.Emplace(Coverage, Proxy);
+		NumHybridSplats += Proxy->GetNumSplatsToSort();
+	}
+	Ranked.Sort([](const TPair<float, FSplatSceneProxy*>& A,
+	               const TPair<float, FSplatSceneProxy*>& B)
+	            { return A.Key > B.Key; });
+
+	if (++FramesSinceAdjust >= FRAMES_PER_ADJUST)
+	{
+		FramesSinceAdjust = 0;
+		AdjustQuota(NumHybridSplats, Times);
+	}
+	SET_DWORD_STAT(
+		STAT_SplatHybridGPUQuota,
+		uint32(FMath::Min<uint64>(GPUQuota, MAX_uint32)));
+
+	// Fill the quota, skipping proxies which do not fit.
+	uint64 NumGPUSplats = 0;
+	for (const TPair<float, FSplatSceneProxy*>& Pair : Ranked)
+	{
+		FSplatSceneProxy* Proxy = Pair.Value;
+		const bool bFits =
+			NumGPUSplats + Proxy->GetNumSplatsToSort() <= GPUQuota;
+		if (bFits)
+		{
+			NumGPUSplats += Proxy->GetNumSplatsToSort();
+		}
+		Proxy->RequestSortingDevice(
+			bFits ? Shaders::ESortingDevice::GPU : Shaders::ESortingDevice::CPU);
+	}
+}
+
+void FSortingController::AdjustQuota(
+	uint64 NumHybridSplats, const FSplatFrameTimes& Times)
+{
+	const float FrameBudgetMs =
+		1000.f / USplatSettings::GetHybridTargetFrameRate();
+	const float CPUSortBudgetMs = USplatSettings::GetHybridCPUSortBudgetMs();
+
+	const float GPUPressure = Times.GPUFrameMs / FrameBudgetMs;
+	const float CPUPressure = CPUSortBudgetMs > 0.f
+	                              ? Times.CPUSortMs / CPUSortBudgetMs
+	                              : std::numeric_limits<float>::max();
+
+	// Changes are relative to what can actually be sorted on GPU, so a quota
+	// left over from more splats being visible takes effect immediately.
+	GPUQuota = FMath::Min(GPUQuota, NumHybridSplats);
+
+	if (GPUPressure > 1.f && GPUPressure >= CPUPressure)
+	{
+		// GPU-bound. Move splats to CPU.
+		GPUQuota -= FMath::Min(
+			GPUQuota, FMath::Max(GPUQuota / 4, MIN_QUOTA_STEP));
+	}
+	else if (CPUPressure > 1.f && CPUPressure > GPUPressure)
+	{
+		// Worker-bound. Move splats to GPU.
+		GPUQuota += FMath::Max(GPUQuota / 4, MIN_QUOTA_STEP);
+	}
+}
+
+} // namespace PICO::Splat
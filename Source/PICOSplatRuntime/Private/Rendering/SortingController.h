@@ -0,0 +1,71 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "SceneView.h"
+#include "SplatFrameTimes.h"
+#include "SplatSceneProxy.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Chooses whether each proxy is sorted on CPU or GPU, when using hybrid
+ * sorting.
+ *
+ * Each frame, a quota of splats is sorted on GPU. It is given to the proxies
+ * covering the most of the screen first, as the latency of asynchronous CPU
+ * sorting is most visible on near, large splats. All other proxies are sorted
+ * on CPU.
+ *
+ * The quota shrinks while the GPU is over its frame budget, and grows while
+ * CPU sorting is over its worker thread budget, whichever is further over.
+ */
+class FSortingController
+{
+public:
+	/**
+	 * Requests a sorting device for each proxy. Only the first call each
+	 * frame has any effect.
+	 *
+	 * @param View - View being rendered.
+	 * @param Proxies - Proxies visible in the view.
+	 * @param Times - Times of recent frames.
+	 */
+	void Update(
+		const FSceneView& View,
+		TConstArrayView<FSplatSceneProxy*> Proxies,
+		const FSplatFrameTimes& Times);
+
+private:
+	/**
+	 * Grows or shrinks the GPU quota, based on measured times.
+	 *
+	 * @param NumHybridSplats - Number of splats which can be sorted on either
+	 * device.
+	 * @param Times - Times of recent frames.
+	 */
+	void AdjustQuota(uint64 NumHybridSplats, const FSplatFrameTimes& Times);
+
+	// Frames between adjustments of the quota. Switching to CPU takes at least
+	// a frame, so this avoids measuring before a switch has taken effect.
+	static constexpr uint32 FRAMES_PER_ADJUST = 30;
+
+	// Bonus to the screen coverage of proxies already sorting on GPU, to avoid
+	// proxies of similar size trading places every frame.
+	static constexpr float GPU_HYSTERESIS = 1.25f;
+
+	// Smallest change in the quota, in splats.
+	static constexpr uint64 MIN_QUOTA_STEP = 100'000;
+
+	uint32 LastFrameNumber = MAX_uint32;
+	uint32 FramesSinceAdjust = 0;
+
+	// Hybrid sorting starts on GPU, as it can draw in the first frame.
+	uint64 GPUQuota = MAX_uint64;
+};
+
+} // namespace PICO::Splat
@@ -0,0 +1,118 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatBudgetController.h"
+
+#include "HAL/IConsoleManager.h"
+#include "SplatSettings.h"
+#include "SplatStats.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+TAutoConsoleVariable<int32> CVarSplatBudget(
+	TEXT("PICOSplat.Budget"),
+	-1,
+	TEXT("Most splats drawn per view, across every visible asset. 0 for no ")
+		TEXT("limit, or -1 to use the project settings."),
+	ECVF_RenderThreadSafe);
+
+TAutoConsoleVariable<int32> CVarGovernSplatBudget(
+	TEXT("PICOSplat.Budget.Govern"),
+	-1,
+	TEXT("1 to adjust the splat budget to hold the budget target frame ")
+		TEXT("rate, 0 not to, or -1 to use the project settings."),
+	ECVF_RenderThreadSafe);
+
+/**
+ * @return The splat budget, or 0 for no limit.
+ */
+uint64 GetSplatBudget()
+{
+	const int32 Override = CVarSplatBudget.GetValueOnRenderThread();
+	return Override >= 0 ? uint64(Override) : USplatSettings::GetSplatBudget();
+}
+
+/**
+ * @return Whether the splat budget is governed.
+ */
+bool ShouldGovernSplatBudget()
+{
+	const int32 Override = CVarGovernSplatBudget.GetValueOnRenderThread();
+	return Override >= 0 ? Override > 0
+	                     : USplatSettings::ShouldGovernSplatBudget();
+}
+} // namespace
+
+bool FSplatBudgetController::Update(
+	const FSceneView& View, const FSplatFrameTimes& Times, uint64 NumWanted)
+{
+	check(IsInRenderingThread());
+	check(View.Family);
+
+	if (View.Family->FrameNumber == LastFrameNumber)
+	{
+		return false;
+	}
+	LastFrameNumber = View.Family->FrameNumber;
+
+	const uint64 Limit = GetSplatBudget();
+	const uint64 MaxBudget = Limit > 0 ? Limit : MAX_uint64;
+	if (ShouldGovernSplatBudget())
+	{
+		if (++FramesSinceAdjust >= FRAMES_PER_ADJUST)
+		{
+			FramesSinceAdjust = 0;
+			AdjustGovernedBudget(Times, NumWanted);
+		}
+		GovernedBudget = FMath::Min(GovernedBudget, MaxBudget);
+		Budget = GovernedBudget;
+	}
+	else
+	{
+		// Governing starts again from what is visible, once re-enabled.
+		GovernedBudget = MAX_uint64;
+		FramesSinceAdjust = 0;
+		Budget = MaxBudget;
+	}
+	SET_DWORD_STAT(
+		STAT_SplatBudget, uint32(FMath::Min<uint64>(Budget, MAX_uint32)));
+	return true;
+}
+
+void FSplatBudgetController::AdjustGovernedBudget(
+	const FSplatFrameTimes& Times, uint64 NumWanted)
+{
+	const float FrameBudgetMs =
+		1000.f / USplatSettings::GetBudgetTargetFrameRate();
+	const float CPUSortBudgetMs = USplatSettings::GetBudgetCPUSortMs();
+
+	float Pressure = FMath::Max(Times.RenderThreadMs, Times.GPUFrameMs) /
+	                 FrameBudgetMs;
+	if (CPUSortBudgetMs > 0.f)
+	{
+		Pressure = FMath::Max(Pressure, Times.CPUSortMs / CPUSortBudgetMs);
+	}
+
+	// Changes are relative to what is actually visible, so a budget left over
+	// from more splats being visible takes effect immediately.
+	GovernedBudget =
+		FMath::Max(FMath::Min(GovernedBudget, NumWanted), MIN_BUDGET_STEP);
+
+	if (Pressure > 1.f)
+	{
+		// Over a limit. Shrink quickly, as every frame over is visible.
+		GovernedBudget -= FMath::Min(
+			GovernedBudget - MIN_BUDGET_STEP,
+			FMath::Max(GovernedBudget / 4, MIN_BUDGET_STEP));
+	}
+	else if (Pressure < HEADROOM)
+	{
+		// Within every limit. Grow slowly, to approach the limit from below.
+		GovernedBudget += FMath::Max(GovernedBudget / 8, MIN_BUDGET_STEP);
+	}
+}
+
+} // namespace PICO::Splat
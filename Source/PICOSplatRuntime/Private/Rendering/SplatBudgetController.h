@@ -0,0 +1,76 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "SceneView.h"
+#include "SplatFrameTimes.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Chooses the most splats drawn each frame, across every visible proxy.
+ *
+ * The budget is the splat budget setting, unless governed. A governed budget
+ * shrinks while the render thread or GPU is over its frame budget, or CPU
+ * sorting is over its worker thread budget, and grows again once all are
+ * comfortably within them. It never exceeds the splat budget setting, if set.
+ *
+ * Both can be overridden with console variables (`PICOSplat.Budget` and
+ * `PICOSplat.Budget.Govern`).
+ */
+class FSplatBudgetController
+{
+public:
+	/**
+	 * Adjusts the budget, based on measured times. Only the first call each
+	 * frame has any effect.
+	 *
+	 * @param View - View being rendered.
+	 * @param Times - Times of recent frames.
+	 * @param NumWanted - Number of splats visible proxies would draw without
+	 * a budget.
+	 * @return Whether this is the first call this frame.
+	 */
+	bool Update(
+		const FSceneView& View,
+		const FSplatFrameTimes& Times,
+		uint64 NumWanted);
+
+	/**
+	 * @return Most splats to draw this frame, or `MAX_uint64` for no limit.
+	 */
+	uint64 GetBudget() const { return Budget; }
+
+private:
+	/**
+	 * Grows or shrinks the governed budget, based on measured times.
+	 *
+	 * @param Times - Times of recent frames.
+	 * @param NumWanted - Number of splats visible proxies would draw without
+	 * a budget.
+	 */
+	void AdjustGovernedBudget(const FSplatFrameTimes& Times, uint64 NumWanted);
+
+	// Frames between adjustments of the budget. CPU sorts take at least a
+	// frame to reflect a change, so this avoids measuring before one has.
+	static constexpr uint32 FRAMES_PER_ADJUST = 30;
+
+	// Below this fraction of every limit, the budget grows. Leaves a margin
+	// between growing and shrinking, so the budget settles.
+	static constexpr float HEADROOM = 0.85f;
+
+	// Smallest change in the budget, and smallest budget, in splats.
+	static constexpr uint64 MIN_BUDGET_STEP = 100'000;
+
+	uint32 LastFrameNumber = MAX_uint32;
+	uint32 FramesSinceAdjust = 0;
+
+	// Starts unlimited, and shrinks from what is visible once governed.
+	uint64 GovernedBudget = MAX_uint64;
+	uint64 Budget = MAX_uint64;
+};
+
+} // namespace PICO::Splat
@@ -4,10 +4,19 @@
 
 #include "Rendering/SplatBuffers.h"
 
+#include <atomic>
+
+#include "HAL/PlatformMemory.h"
 #include "Misc/AssertionMacros.h"
 
 namespace PICO::Splat
 {
+namespace
+{
+// Sums bytes read by PrefetchData(), only so the reads are not optimized away.
+std::atomic<uint32> PrefetchSink = 0;
+} // namespace
+
 void FSplatBufferBase::InitRHI(FRHICommandListBase& RHICmdList)
 {
 	FRHIResourceCreateInfo CreateInfo(*GetFriendlyName(), ResourceArray);
@@ -33,4 +42,53 @@ void FSplatBufferBase::InitRHI(FRHICommandListBase& RHICmdList)
 		check(UnorderedAccessViewRHI);
 	}
 }
+
+void FSplatBufferBase::PrefetchData() const
+{
+	if (!ResourceArray || !ResourceArray->GetResourceData())
+	{
+		return;
+	}
+	const uint8* Data =
+		static_cast<const uint8*>(ResourceArray->GetResourceData());
+
+	// Touching a byte of each page faults in the whole page.
+	const uint32 DataSize = ResourceArray->GetResourceDataSize();
+	const uint32 PageSize = FPlatformMemory::GetConstants().PageSize;
+	uint32 Sum = 0;
+	for (uint32 Offset = 0; Offset < DataSize; Offset += PageSize)
+	{
+		Sum += Data[Offset];
+	}
+	PrefetchSink.fetch_add(Sum, std::memory_order_relaxed);
+}
+
+FSplatMappedResourceArray::FSplatMappedResourceArray(
+	FByteBulkData& BulkData, bool bInKeepPayload)
+	: Size(uint32(BulkData.GetBulkDataSize()))
+	, bKeepPayload(bInKeepPayload)
+	, Payload(BulkData.StealFileMapping())
+{
+	check(Payload);
+}
+
+const void* FSplatMappedResourceArray::GetResourceData() const
+{
+	return Payload ? Payload->GetPointer() : nullptr;
+}
+
+uint32 FSplatMappedResourceArray::GetResourceDataSize() const
+{
+	return Payload ? Size : 0;
+}
+
+void FSplatMappedResourceArray::Discard()
+{
+	// Unmaps, or frees the copy. Mapped pages kept are backed by the file, so
+	// can be reclaimed by the OS while unused.
+	if (!bKeepPayload)
+	{
+		Payload.reset();
+	}
+}
 } // namespace PICO::Splat
\ No newline at end of file
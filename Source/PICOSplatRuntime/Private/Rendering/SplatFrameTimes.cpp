@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatFrameTimes.h"
+
+#include "CPUSorting.h"
+#include "DynamicRHI.h"
+#include "HAL/PlatformTime.h"
+#include "RenderCore.h"
+#include "SplatStats.h"
+
+namespace PICO::Splat
+{
+
+void FSplatFrameTimes::Measure()
+{
+	check(IsInRenderingThread());
+
+	RenderThreadMs = FMath::Lerp(
+		RenderThreadMs,
+		float(FPlatformTime::ToMilliseconds(GRenderThreadTime)),
+		SMOOTHING);
+	GPUFrameMs = FMath::Lerp(
+		GPUFrameMs,
+		float(FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles())),
+		SMOOTHING);
+	CPUSortMs = FMath::Lerp(
+		CPUSortMs,
+		float(FPlatformTime::ToMilliseconds64(ConsumeCPUSortCycles())),
+		SMOOTHING);
+	SET_FLOAT_STAT(STAT_SplatRenderThreadMs, RenderThreadMs);
+	SET_FLOAT_STAT(STAT_SplatGPUFrameMs, GPUFrameMs);
+	SET_FLOAT_STAT(STAT_SplatCPUSortMs, CPUSortMs);
+}
+
+} // namespace PICO::Splat
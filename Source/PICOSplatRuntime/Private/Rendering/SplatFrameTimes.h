@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "HAL/Platform.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Averaged times of recent frames, measured once per frame and shared by the
+ * controllers which balance splat work against them.
+ *
+ * Render thread only.
+ */
+struct FSplatFrameTimes
+{
+	/**
+	 * Measures the previous frame, blending it into the averages.
+	 */
+	void Measure();
+
+	// Render thread time of the last frame, excluding time spent waiting.
+	float RenderThreadMs = 0.f;
+	// GPU time of the last completed frame.
+	float GPUFrameMs = 0.f;
+	// Worker thread time spent in CPU sorting, summed across all threads.
+	float CPUSortMs = 0.f;
+
+private:
+	// Weight of the latest frame in the averages.
+	static constexpr float SMOOTHING = 0.1f;
+};
+
+} // namespace PICO::Splat
@@ -67,7 +67,7 @@ FRDGPassRef CalculateDistances(
 			.AllocParameters<Shaders::FComputeDistanceCS::FParameters>();
 	DistanceParams->local_to_clip =
 		FMatrix44f(Proxy->GetLocalToWorld() * GetViewProj(View));
-	DistanceParams->num_splats = Proxy->GetNumSplats();
+	DistanceParams->num_splats = Proxy->GetNumSplatsToSort();
 	DistanceParams->Positions = MakePositionParams(Proxy);
 	DistanceParams->indices = Proxy->GetIndicesUAV();
 	DistanceParams->distances = DistancesUAV;
@@ -79,7 +79,55 @@ FRDGPassRef CalculateDistances(
 		ERDGPassFlags::AsyncCompute,
 		DistanceShader,
 		DistanceParams,
-		FIntVector(NumThreadGroups(Proxy->GetNumSplats()), 1, 1));
+		FIntVector(NumThreadGroups(Proxy->GetNumSplatsToSort()), 1, 1));
+}
+
+FRDGPassRef DecodeCovariances(
+	FRDGBuilder& GraphBuilder,
+	FSplatSceneProxy* Proxy,
+	FSplatGPUToGPUBuffer& Decoded)
+{
+	check(Proxy);
+	check(Proxy->HasCovarianceCodebook());
+
+	const FGlobalShaderMap* GlobalShaderMap =
+		GetGlobalShaderMap(GMaxRHIFeatureLevel);
+	TShaderRef<Shaders::FDecodeCovariancesCS> DecodeShader =
+		GlobalShaderMap->GetShader<Shaders::FDecodeCovariancesCS>();
+
+	Shaders::FDecodeCovariancesCS::FParameters* DecodeParams =
+		GraphBuilder
+			.AllocParameters<Shaders::FDecodeCovariancesCS::FParameters>();
+	DecodeParams->num_splats = Proxy->GetNumSplatsToTransform();
+	DecodeParams->codebook = Proxy->GetCovarianceCodebookSRV();
+	DecodeParams->indices = Proxy->GetCovarianceIndicesSRV();
+	DecodeParams->covariances = Decoded.UnorderedAccessViewRHI;
+
+	Proxy->SetDecodedCovariancesSRV(Decoded.ShaderResourceViewRHI);
+
+	const FIntVector GroupCount(
+		NumThreadGroups(Proxy->GetNumSplatsToTransform()), 1, 1);
+	FRHIUnorderedAccessView* DecodedUAV = Decoded.UnorderedAccessViewRHI;
+
+	return GraphBuilder.AddPass(
+		RDG_EVENT_NAME(
+			"Splat: Decode Covariances %s",
+			*Proxy->GetResourceName().ToString()),
+		DecodeParams,
+		ERDGPassFlags::AsyncCompute | ERDGPassFlags::NeverCull,
+		[DecodeShader, DecodeParams, GroupCount, DecodedUAV](
+			FRHIComputeCommandList& RHICmdList)
+		{
+			// The decoded buffer is not tracked by the RDG, so wait for any
+			// previous proxy's passes to finish reading it, and make it
+			// readable once written.
+			RHICmdList.Transition(FRHITransitionInfo(
+				DecodedUAV, ERHIAccess::Unknown, ERHIAccess::UAVCompute));
+			FComputeShaderUtils::Dispatch(
+				RHICmdList, DecodeShader, *DecodeParams, GroupCount);
+			RHICmdList.Transition(FRHITransitionInfo(
+				DecodedUAV, ERHIAccess::UAVCompute, ERHIAccess::SRVCompute));
+		});
 }
 
 FRDGPassRef ComputeTransforms(
@@ -98,7 +146,7 @@ FRDGPassRef ComputeTransforms(
 	SplatParams->local_to_view =
 		FMatrix44f(Proxy->GetLocalToWorld() * GetView(View));
 	SplatParams->two_focal_length = 2 * GetFocalLength(View);
-	SplatParams->num_splats = Proxy->GetNumSplats();
+	SplatParams->num_splats = Proxy->GetNumSplatsToTransform();
 	SplatParams->Positions = MakePositionParams(Proxy);
 	SplatParams->covariances = Proxy->GetCovariancesSRV();
 	SplatParams->transforms = Proxy->GetTransformsUAV();
@@ -110,7 +158,99 @@ FRDGPassRef ComputeTransforms(
 		ERDGPassFlags::AsyncCompute,
 		ComputeSplatTransforms,
 		SplatParams,
-		FIntVector(NumThreadGroups(Proxy->GetNumSplats()), 1, 1));
+		FIntVector(NumThreadGroups(Proxy->GetNumSplatsToTransform()), 1, 1));
+}
+
+FRDGPassRef AdjustSplats(
+	FRDGBuilder& GraphBuilder,
+	const FSceneView& View,
+	FSplatSceneProxy* Proxy,
+	EOversizedSplatPolicy Policy,
+	const FFoveation& Foveation,
+	uint32 SHDegree,
+	FRDGBufferUAVRef NumOversized)
+{
+	check(Proxy);
+	check(SHDegree <= Proxy->GetSHDegree());
+
+	const bool bFade = Policy == EOversizedSplatPolicy::Fade;
+	// CPU sorting drops splats outside the cut before they are drawn.
+	const bool bLOD = Proxy->HasLOD() && Proxy->IsSortingOnGPU();
+	const bool bPrefix = Proxy->IsOrderedByImportance();
+	// Without radii, neither device can thin, as both measure splats by them.
+	const bool bFoveate = Foveation.bEnabled && Proxy->HasRadiiBuffer();
+	Shaders::FAdjustSplatsCS::FPermutationDomain Permutation;
+	Permutation.Set<Shaders::FAdjustSplatsCS::FFadeDim>(bFade);
+	Permutation.Set<Shaders::FAdjustSplatsCS::FFoveateDim>(bFoveate);
+	Permutation.Set<Shaders::FAdjustSplatsCS::FSHDegreeDim>(int32(SHDegree));
+	Permutation.Set<Shaders::FAdjustSplatsCS::FLODDim>(bLOD);
+	Permutation.Set<Shaders::FAdjustSplatsCS::FPrefixDim>(bPrefix);
+
+	const FGlobalShaderMap* GlobalShaderMap =
+		GetGlobalShaderMap(GMaxRHIFeatureLevel);
+	TShaderRef<Shaders::FAdjustSplatsCS> AdjustShader =
+		GlobalShaderMap->GetShader<Shaders::FAdjustSplatsCS>(Permutation);
+
+	Shaders::FAdjustSplatsCS::FParameters* AdjustParams =
+		GraphBuilder.AllocParameters<Shaders::FAdjustSplatsCS::FParameters>();
+	AdjustParams->local_to_view =
+		FMatrix44f(Proxy->GetLocalToWorld() * GetView(View));
+	AdjustParams->focal_length = GetFocalLength(View);
+	// With no policy, no splat is oversized.
+	AdjustParams->max_radius_px = Policy == EOversizedSplatPolicy::None
+	                                  ? UE_MAX_FLT
+	                                  : GetMaxSplatRadiusPixels(View);
+	AdjustParams->cull = Policy == EOversizedSplatPolicy::Cull;
+	AdjustParams->num_splats = Proxy->GetNumSplatsToTransform();
+	AdjustParams->eccentricity_scale = GetEccentricityScale(View);
+	AdjustParams->ring_radii = Foveation.RingRadii;
+	AdjustParams->ring_densities = Foveation.RingDensities;
+	AdjustParams->importance_area = Foveation.ImportanceArea;
+	if (bFoveate)
+	{
+		AdjustParams->radius_to_px =
+			Proxy->GetRadiusToPixels(GetFocalLength(View));
+		AdjustParams->min_radius_px = Proxy->GetMinSplatRadiusPixels();
+		AdjustParams->radii = Proxy->GetRadiiSRV();
+	}
+	AdjustParams->prefix_coverage = Proxy->GetPrefixCoverage();
+	AdjustParams->Positions = MakePositionParams(Proxy);
+	AdjustParams->covariances = Proxy->GetCovariancesSRV();
+	AdjustParams->transforms = Proxy->GetTransformsUAV();
+	if (bFade || bFoveate || SHDegree > 0 || bPrefix)
+	{
+		AdjustParams->colors = Proxy->GetAssetColorsSRV();
+		AdjustParams->adjusted_colors = Proxy->GetAdjustedColorsUAV();
+	}
+	if (SHDegree > 0)
+	{
+		AdjustParams->SH = MakeSHParams(View, Proxy);
+	}
+	if (bLOD)
+	{
+		AdjustParams->LOD = MakeLODParams(View, Proxy);
+	}
+	AdjustParams->num_oversized = NumOversized;
+
+	const FIntVector GroupCount(
+		NumThreadGroups(Proxy->GetNumSplatsToTransform()), 1, 1);
+	FRHIUnorderedAccessView* TransformsUAV = Proxy->GetTransformsUAV();
+
+	return GraphBuilder.AddPass(
+		RDG_EVENT_NAME(
+			"Splat: Adjust %s", *Proxy->GetResourceName().ToString()),
+		AdjustParams,
+		ERDGPassFlags::AsyncCompute,
+		[AdjustShader, AdjustParams, GroupCount, TransformsUAV](
+			FRHIComputeCommandList& RHICmdList)
+		{
+			// Transforms are not tracked by the RDG, so wait for the transform
+			// pass to finish writing them.
+			RHICmdList.Transition(FRHITransitionInfo(
+				TransformsUAV, ERHIAccess::UAVCompute, ERHIAccess::UAVCompute));
+			FComputeShaderUtils::Dispatch(
+				RHICmdList, AdjustShader, *AdjustParams, GroupCount);
+		});
 }
 
 void RenderSplatCPUSort(
@@ -254,7 +394,7 @@ FRDGPassRef SortSplats(
 	check(Indices);
 	check(Distances);
 
-	uint32 NumSplats = Proxy->GetNumSplats();
+	uint32 NumSplats = Proxy->GetNumSplatsToSort();
 
 	FRDGBufferDesc IndexDesc =
 		FRDGBufferDesc::CreateBufferDesc(sizeof(uint32), NumSplats);
@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include "Foveation.h"
 #include "RHICommandList.h"
 #include "RenderGraphBuilder.h"
 #include "SceneView.h"
 #include "SplatSceneProxy.h"
+#include "SplatSettings.h"
 #include "SplatShaders.h"
 
 namespace PICO::Splat
@@ -52,6 +54,22 @@ FRDGPassRef CalculateDistances(
 	FRDGBufferRef Indices,
 	FRDGBufferRef Distances);
 
+/**
+ * Adds a compute shader pass expanding covariances in the codebook format into
+ * one per splat. Must precede `ComputeTransforms` and `AdjustSplats`, which
+ * read them.
+ *
+ * @param GraphBuilder - Graph to add pass to.
+ * @param Proxy - Splat proxy to decode. *Must* use the codebook format.
+ * @param Decoded - Output buffer, with room for every splat. May be shared
+ * between proxies, as passes using it run in order.
+ * @return A reference to the added pass.
+ */
+FRDGPassRef DecodeCovariances(
+	FRDGBuilder& GraphBuilder,
+	FSplatSceneProxy* Proxy,
+	FSplatGPUToGPUBuffer& Decoded);
+
 /**
  * Adds transform calculation compute shader pass.
  *
@@ -63,6 +81,34 @@ FRDGPassRef CalculateDistances(
 FRDGPassRef ComputeTransforms(
 	FRDGBuilder& GraphBuilder, const FSceneView& View, FSplatSceneProxy* Proxy);
 
+/**
+ * Adds a compute shader pass handling splats with oversized footprints,
+ * thinning splats in the outer rings of the view, adding view-dependent color
+ * from spherical harmonics, compensating the opacity of a prefix of splats
+ * ordered by importance, and, when sorting on GPU, culling splats outside the
+ * level of detail cut. Must follow `ComputeTransforms`.
+ *
+ * @param GraphBuilder - Graph to add pass to.
+ * @param View - View the footprint is measured in.
+ * @param Proxy - Splat proxy to adjust. With the fade policy, thinning,
+ * spherical harmonics or importance order, its adjusted colors *must* be
+ * enabled.
+ * @param Policy - How oversized splats are handled.
+ * @param Foveation - Foveated thinning to apply.
+ * @param SHDegree - Degree of spherical harmonics to evaluate, at most the
+ * asset's, or 0 for none.
+ * @param NumOversized - Output counter, incremented per oversized splat.
+ * @return A reference to the added pass.
+ */
+FRDGPassRef AdjustSplats(
+	FRDGBuilder& GraphBuilder,
+	const FSceneView& View,
+	FSplatSceneProxy* Proxy,
+	EOversizedSplatPolicy Policy,
+	const FFoveation& Foveation,
+	uint32 SHDegree,
+	FRDGBufferUAVRef NumOversized);
+
 /**
  * Draws a splat, sorted by CPU.
  *
@@ -6,6 +6,7 @@
 
 #include "Misc/AssertionMacros.h"
 #include "SplatSceneProxy.h"
+#include "SplatSettings.h"
 #include "SplatShaders.h"
 
 namespace PICO::Splat
@@ -30,6 +31,31 @@ inline float GetFocalLength(const FSceneView& View)
 	       (2.f * tanf(View.ViewMatrices.ComputeHalfFieldOfViewPerAxis().X));
 }
 
+/**
+ * Get the projected radius above which splats are oversized, from the max
+ * splat screen fraction.
+ *
+ * @param View - View to use.
+ * @return Maximum radius, in pixels.
+ */
+inline float GetMaxSplatRadiusPixels(const FSceneView& View)
+{
+	return 0.5f * USplatSettings::GetMaxSplatScreenFraction() *
+	       View.UnconstrainedViewRect.Width();
+}
+
+/**
+ * Get the scale from the tangent of the angle off the view axis to the
+ * fraction of the distance to the left or right edge of the view.
+ *
+ * @param View - View to use.
+ * @return Focal length over half the view width.
+ */
+inline float GetEccentricityScale(const FSceneView& View)
+{
+	return 1.f / tanf(View.ViewMatrices.ComputeHalfFieldOfViewPerAxis().X);
+}
+
 /**
  * Get forward vector from view.
  *
@@ -94,4 +120,72 @@ MakePositionParams(FSplatSceneProxy* Proxy)
 
 	return Params;
 }
+
+/**
+ * Helper to make spherical harmonics parameters from a proxy. The proxy's
+ * asset *must* have spherical harmonics.
+ *
+ * @param View - View colors are evaluated from.
+ * @param Proxy - Proxy to get spherical harmonics from.
+ * @return Spherical harmonics parameters: Coefficients, their ranges, and the
+ * view origin in the proxy's local space.
+ */
+inline Shaders::FSHParameters
+MakeSHParams(const FSceneView& View, FSplatSceneProxy* Proxy)
+{
+	check(Proxy);
+	check(Proxy->GetSHDegree() > 0);
+
+	Shaders::FSHParameters Params;
+	TConstArrayView<float> Min;
+	TConstArrayView<float> Scale;
+	Params.sh_coefficients = Proxy->GetSHCoefficientsSRV(Min, Scale);
+	check(Min.Num() <= int32(4 * Shaders::MAX_SH_VECTORS));
+	for (int32 Index = 0; Index < Min.Num(); Index += 4)
+	{
+		Params.sh_min[Index / 4] = FVector4f(
+			Min[Index], Min[Index + 1], Min[Index + 2], Min[Index + 3]);
+		Params.sh_scale[Index / 4] = FVector4f(
+			Scale[Index], Scale[Index + 1], Scale[Index + 2], Scale[Index + 3]);
+	}
+	Params.sh_stride = GetSHStride(Proxy->GetSHDegree());
+
+	// Without a codebook, indices are unread, so coefficients stand in.
+	Params.sh_indexed = Proxy->HasSHCodebook();
+	Params.sh_indices = Params.sh_indexed ? Proxy->GetSHIndicesSRV()
+	                                      : Params.sh_coefficients;
+
+	Params.local_to_sh = Proxy->GetLocalToSH();
+	Params.view_origin_local_cm =
+		FVector3f(Proxy->GetLocalToWorld().InverseTransformPosition(
+			View.ViewMatrices.GetViewOrigin()));
+
+	return Params;
+}
+
+/**
+ * Helper to make level of detail parameters from a proxy. The proxy's asset
+ * *must* have a level of detail hierarchy.
+ *
+ * @param View - View the cut is chosen for.
+ * @param Proxy - Proxy to get level of detail nodes from.
+ * @return Level of detail parameters: Nodes, the scale of their bounds and
+ * errors, and the largest error drawn.
+ */
+inline Shaders::FLODParameters
+MakeLODParams(const FSceneView& View, FSplatSceneProxy* Proxy)
+{
+	check(Proxy);
+	check(Proxy->HasLOD());
+
+	Shaders::FLODParameters Params;
+	Params.lod_scale =
+		MetersToCentimeters *
+		float(Proxy->GetLocalToWorld().GetMaximumAxisScale());
+	Params.max_lod_error =
+		Proxy->GetMaxLODErrorPixels() / GetFocalLength(View);
+	Params.lod_nodes = Proxy->GetLODNodesSRV();
+
+	return Params;
+}
 } // namespace PICO::Splat
\ No newline at end of file
@@ -0,0 +1,207 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatResidencyManager.h"
+
+#include "HAL/PlatformTime.h"
+#include "SplatSettings.h"
+#include "SplatStats.h"
+
+namespace PICO::Splat
+{
+
+void FSplatResidencyManager::Update(
+	FRHICommandListBase& RHICmdList,
+	const FSceneView& View,
+	const TSet<FSplatSceneProxy*>& Proxies)
+{
+	check(IsInRenderingThread());
+	check(View.Family);
+
+	// Without a budget, nothing stays evicted.
+	if (USplatSettings::GetResidencyBudget() == 0)
+	{
+		for (FSplatSceneProxy* Proxy : Proxies)
+		{
+			check(Proxy);
+			Proxy->GetAsset()->RestoreGPUBuffers_RenderThread(RHICmdList);
+		}
+		Assets.Reset();
+		Views.Reset();
+		return;
+	}
+
+	const uint32 Frame = View.Family->FrameNumber;
+	const double Now = FPlatformTime::Seconds();
+
+	// Extrapolate the motion of the view from last frame.
+	const FVector Origin = View.ViewMatrices.GetViewOrigin();
+	FViewMotion& Motion = Views.FindOrAdd(View.GetViewKey());
+	if (Motion.LastFrame != Frame)
+	{
+		const double Elapsed = Now - Motion.LastTime;
+		Motion.Velocity = Motion.LastFrame == Frame - 1 && Elapsed > 0.0
+		                      ? (Origin - Motion.LastOrigin) / Elapsed
+		                      : FVector::ZeroVector;
+		Motion.LastFrame = Frame;
+		Motion.LastOrigin = Origin;
+		Motion.LastTime = Now;
+	}
+	const FVector PredictedOrigin =
+		Origin + Motion.Velocity * USplatSettings::GetResidencyLookahead();
+	const double PrefetchDistanceSquared =
+		FMath::Square(double(USplatSettings::GetResidencyPrefetchDistance()));
+
+	for (FSplatSceneProxy* Proxy : Proxies)
+	{
+		check(Proxy);
+
+		USplatAsset* Asset = Proxy->GetAsset();
+		FAssetResidency* Residency = Assets.Find(Asset);
+		if (!Residency)
+		{
+			// New assets are given the grace period, before being evicted.
+			Residency = &Assets.Add(Asset, {Frame, Frame, -1.0});
+		}
+
+		if (!Proxy->IsShown(&View) || &Proxy->GetScene() != View.Family->Scene)
+		{
+			continue;
+		}
+
+		const FBoxSphereBounds& Bounds = Proxy->GetBounds();
+		const FBox Box = Bounds.GetBox();
+		const bool bInView =
+			View.ViewFrustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent);
+		const bool bWanted =
+			bInView ||
+			Box.ComputeSquaredDistanceToPoint(Origin) <=
+				PrefetchDistanceSquared ||
+			Box.ComputeSquaredDistanceToPoint(PredictedOrigin) <=
+				PrefetchDistanceSquared;
+		if (bInView)
+		{
+			Residency->LastVisibleFrame = Frame;
+		}
+		if (!bWanted)
+		{
+			continue;
+		}
+		Residency->LastWantedFrame = Frame;
+
+		if (Asset->IsGPUResident())
+		{
+			continue;
+		}
+		if (Residency->RestoreStartTime < 0.0)
+		{
+			Asset->BeginPrefetchGPUBuffers_RenderThread();
+			Residency->RestoreStartTime = Now;
+		}
+		// Assets in view are uploaded at once, even if still being read, as
+		// they would otherwise pop in late.
+		if (bInView || Asset->IsPrefetchComplete())
+		{
+			Asset->RestoreGPUBuffers_RenderThread(RHICmdList);
+			INC_DWORD_STAT(STAT_SplatReloads);
+			SET_FLOAT_STAT(
+				STAT_SplatReloadLatencyMs,
+				(FPlatformTime::Seconds() - Residency->RestoreStartTime) *
+					1000.0);
+			Residency->RestoreStartTime = -1.0;
+		}
+	}
+
+	// Evicted after marking, so what this view wants is kept.
+	if (Frame != LastFrameNumber)
+	{
+		LastFrameNumber = Frame;
+		EvictOverBudget(Proxies);
+	}
+}
+
+void FSplatResidencyManager::EvictOverBudget(
+	const TSet<FSplatSceneProxy*>& Proxies)
+{
+	// Forget assets no longer drawn, and views no longer rendered.
+	TSet<USplatAsset*, DefaultKeyFuncs<USplatAsset*>, TInlineSetAllocator<32>>
+		Drawn;
+	for (const FSplatSceneProxy* Proxy : Proxies)
+	{
+		Drawn.Add(Proxy->GetAsset());
+	}
+	for (auto It = Assets.CreateIterator(); It; ++It)
+	{
+		if (!Drawn.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = Views.CreateIterator(); It; ++It)
+	{
+		if (LastFrameNumber - It.Value().LastFrame > GRACE_FRAMES)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Assets being read back in are counted, as they are about to upload.
+	struct FCandidate
+	{
+		USplatAsset* Asset;
+		uint32 LastVisibleFrame;
+		uint64 Size;
+	};
+	TArray<FCandidate> Candidates;
+	uint64 Size = 0;
+	for (auto& [Asset, Residency] : Assets)
+	{
+		const bool bWanted =
+			LastFrameNumber - Residency.LastWantedFrame <= GRACE_FRAMES;
+		if (!bWanted)
+		{
+			Residency.RestoreStartTime = -1.0;
+		}
+
+		if (!Asset->IsGPUResident() && Residency.RestoreStartTime < 0.0)
+		{
+			continue;
+		}
+		const uint64 AssetSize = Asset->GetGPUMemorySize();
+		Size += AssetSize;
+		if (!bWanted && Asset->IsGPUResident() && Asset->CanEvictGPUBuffers())
+		{
+			Candidates.Add({Asset, Residency.LastVisibleFrame, AssetSize});
+		}
+	}
+
+	const uint64 Budget = uint64(USplatSettings::GetResidencyBudget());
+	if (Size > Budget)
+	{
+		Candidates.Sort(
+			[](const FCandidate& A, const FCandidate& B)
+			{ return A.LastVisibleFrame < B.LastVisibleFrame; });
+		for (const FCandidate& Candidate : Candidates)
+		{
+			if (Size <= Budget)
+			{
+				break;
+			}
+			Candidate.Asset->EvictGPUBuffers_RenderThread();
+			Size -= Candidate.Size;
+			INC_DWORD_STAT(STAT_SplatEvictions);
+		}
+	}
+
+	uint32 NumResident = 0;
+	for (const auto& [Asset, Residency] : Assets)
+	{
+		NumResident += Asset->IsGPUResident() ? 1 : 0;
+	}
+	SET_DWORD_STAT(STAT_SplatAssetsResident, NumResident);
+	SET_DWORD_STAT(STAT_SplatAssetsEvicted, Assets.Num() - NumResident);
+	SET_MEMORY_STAT(STAT_SplatResidentMemory, Size);
+}
+
+} // namespace PICO::Splat
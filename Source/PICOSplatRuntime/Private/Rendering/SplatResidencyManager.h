@@ -0,0 +1,86 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "RHICommandList.h"
+#include "SceneView.h"
+#include "SplatSceneProxy.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Keeps the GPU buffers of splat assets within the GPU residency budget.
+ *
+ * Assets are wanted while in view, or within the prefetch distance of a view,
+ * either where it is or where it will be after the lookahead, moving as it did
+ * last frame. Once over the budget, the buffers of evictable assets no longer
+ * wanted are released, least recently visible first. Wanted assets which were
+ * evicted are read back into memory on a worker thread, then uploaded again,
+ * or at once if already in view.
+ *
+ * Render thread only.
+ */
+class FSplatResidencyManager
+{
+public:
+	/**
+	 * Marks the assets wanted by a view, and uploads those it needs again.
+	 * Evicts assets over the budget on the first call each frame.
+	 *
+	 * @param RHICmdList - The RHI command list to create resources with.
+	 * @param View - View being rendered.
+	 * @param Proxies - Every registered proxy.
+	 */
+	void Update(
+		FRHICommandListBase& RHICmdList,
+		const FSceneView& View,
+		const TSet<FSplatSceneProxy*>& Proxies);
+
+private:
+	/**
+	 * Evicts assets no longer wanted, least recently visible first, until
+	 * within the budget, and forgets those no proxy draws.
+	 *
+	 * @param Proxies - Every registered proxy.
+	 */
+	void EvictOverBudget(const TSet<FSplatSceneProxy*>& Proxies);
+
+	/**
+	 * Residency of an asset drawn by at least one proxy.
+	 */
+	struct FAssetResidency
+	{
+		uint32 LastVisibleFrame = 0;
+		uint32 LastWantedFrame = 0;
+		// When reading back into memory began, or negative if not evicted.
+		double RestoreStartTime = -1.0;
+	};
+
+	/**
+	 * Where a view was last frame, to extrapolate its motion.
+	 */
+	struct FViewMotion
+	{
+		uint32 LastFrame = 0;
+		FVector LastOrigin = FVector::ZeroVector;
+		double LastTime = 0.0;
+		FVector Velocity = FVector::ZeroVector;
+	};
+
+	// Frames an asset stays wanted after it no longer is, so a view moving
+	// back and forth across the prefetch distance does not thrash it, and so
+	// views later in a frame keep what they wanted last frame.
+	static constexpr uint32 GRACE_FRAMES = 2;
+
+	TMap<USplatAsset*, FAssetResidency> Assets;
+	// Keyed by view state, or 0 for views without one.
+	TMap<uint32, FViewMotion> Views;
+	uint32 LastFrameNumber = MAX_uint32;
+};
+
+} // namespace PICO::Splat
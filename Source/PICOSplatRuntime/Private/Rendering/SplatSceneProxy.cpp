@@ -4,6 +4,7 @@
 
 #include "SplatSceneProxy.h"
 
+#include "HAL/PlatformTime.h"
 #include "MaterialDomain.h"
 #include "Materials/MaterialRenderProxy.h"
 #include "PackedTypes.h"
@@ -23,22 +24,31 @@ FSplatSceneProxy::FSplatSceneProxy(USplatComponent& Component)
 	: FPrimitiveSceneProxy(&Component)
 	, Asset(Component.GetAsset())
 	, Transforms(Asset->GetNumSplats(), EPixelFormat::PF_FloatRGBA)
-	, bIsSortingOnGPU(USplatSettings::IsSortingOnGPU())
+	, bIsHybridSorting(
+		  USplatSettings::GetSortingMethod() == ESortingMethod::Hybrid)
+	, ActiveDevice(
+		  USplatSettings::IsSortingOnGPU() || bIsHybridSorting
+			  ? Shaders::ESortingDevice::GPU
+			  : Shaders::ESortingDevice::CPU)
+	, RequestedDevice(ActiveDevice)
+	, CPUSortsAtRequest(0)
+	, LastCPUSortTime(0.0)
+	, LastRequiredCapacity(0)
+	, NumSplatsToSort(Asset->GetNumSplats())
+	, PrefixCoverage(1.f)
+	, BudgetScale(1.f)
 #if WITH_EDITOR
 	, VertexFactory(GetScene().GetFeatureLevel(), "FSplatSceneProxy")
 	, BodySetup(Component.GetBodySetup())
 #endif
 {
-	if (bIsSortingOnGPU)
+	// Hybrid sorting starts on GPU, as it can draw in the first frame. CPU
+	// sorting buffers are acquired from the pool once first sorted.
+	if (IsSortingOnGPU())
 	{
 		Indices = FSplatGPUToGPUBuffer(
 			Asset->GetNumSplats(), EPixelFormat::PF_R32_UINT);
 	}
-	else
-	{
-		CPUSorting = std::make_shared<FMultithreadedSortingBuffers>(
-			Asset->GetNumSplats());
-	}
 
 #if WITH_EDITOR
 	TConstArrayView<uint32> ConvexHullIndices = Asset->GetConvexHullIndices();
@@ -92,14 +102,10 @@ FSplatSceneProxy::GetViewRelevance(const FSceneView* View) const
 void FSplatSceneProxy::CreateRenderThreadResources(
 	FRHICommandListBase& RHICmdList)
 {
-	if (bIsSortingOnGPU)
+	if (Indices)
 	{
 		Indices->InitRHI(RHICmdList);
 	}
-	else
-	{
-		CPUSorting->InitResources_RenderThread(RHICmdList);
-	}
 	Transforms.InitRHI(RHICmdList);
 
 	check(GEngine);
@@ -113,19 +119,22 @@ void FSplatSceneProxy::DestroyRenderThreadResources()
 	check(GEngine);
 	USplatSubsystem* Subsystem = GEngine->GetEngineSubsystem<USplatSubsystem>();
 	check(Subsystem);
+	// Also returns CPU sorting buffers to the pool.
 	Subsystem->UnregisterSplat_RenderThread(this);
+	check(!CPUSorting && !ResizedCPUSorting);
 
-	if (bIsSortingOnGPU)
+	if (Indices)
 	{
 		Indices->ReleaseResource();
 	}
-	else
-	{
-		CPUSorting->ReleaseResources();
-	}
 
 	Transforms.ReleaseResource();
 
+	if (AdjustedColors)
+	{
+		AdjustedColors->ReleaseResource();
+	}
+
 #if WITH_EDITOR
 	VertexFactory.ReleaseResource();
 
@@ -284,7 +293,8 @@ bool FSplatSceneProxy::IsVisible(const FSceneView& View) const
 
 	bool bIsShown = IsShown(&View);
 	bool bIsInScene = &GetScene() == View.Family->Scene;
-	bool bIsVisible = bIsShown && bIsInScene;
+	bool bIsResident = Asset->IsGPUResident();
+	bool bIsVisible = bIsShown && bIsInScene && bIsResident;
 
 #if WITH_EDITOR
 	const FEngineShowFlags& Flags = View.Family->EngineShowFlags;
@@ -298,28 +308,276 @@ bool FSplatSceneProxy::IsVisible(const FSceneView& View) const
 #endif
 }
 
+void FSplatSceneProxy::SetAdjustedColorsEnabled(
+	FRHICommandListBase& RHICmdList, bool bEnabled)
+{
+	check(IsInRenderingThread());
+
+	if (bEnabled && !AdjustedColors)
+	{
+		// RGBA, as typed UAVs of BGRA are not supported everywhere. Colors are
+		// read as float4, so the swizzle is transparent.
+		AdjustedColors =
+			FSplatGPUToGPUBuffer(GetNumSplats(), EPixelFormat::PF_R8G8B8A8);
+		AdjustedColors->InitRHI(RHICmdList);
+	}
+	else if (!bEnabled && AdjustedColors)
+	{
+		AdjustedColors->ReleaseResource();
+		AdjustedColors.reset();
+	}
+}
+
+void FSplatSceneProxy::SetNumSplatsToSort(uint32 NumSplats)
+{
+	check(IsInRenderingThread());
+	check(Asset);
+
+	NumSplatsToSort = Asset->IsOrderedByImportance()
+	                      ? FMath::Clamp(NumSplats, 1u, GetNumSplats())
+	                      : GetNumSplats();
+	PrefixCoverage = Asset->GetPrefixCoverage(NumSplatsToSort);
+}
+
+float FSplatSceneProxy::GetPrefixCoverage() const
+{
+	check(IsInRenderingThread());
+
+	// Sorts spanning frames draw the prefix they began with.
+	if (!IsSortingOnGPU() && CPUSorting && CPUSorting->IsGPUBufferReady())
+	{
+		return Asset->GetPrefixCoverage(CPUSorting->GetNumSortedToDraw());
+	}
+	return PrefixCoverage;
+}
+
+float FSplatSceneProxy::GetMaxLODErrorPixels() const
+{
+	return BudgetScale * USplatSettings::GetMaxLODErrorPixels();
+}
+
+float FSplatSceneProxy::GetMinSplatRadiusPixels() const
+{
+	return BudgetScale * USplatSettings::GetMinSplatRadiusPixels();
+}
+
+uint32 FSplatSceneProxy::GetNumSplatsWanted() const
+{
+	check(IsInRenderingThread());
+
+	// Coarsening by the budget's scale draws about as many fewer splats as
+	// its square (see `SetBudgetScale`).
+	const uint32 NumVisible =
+		!IsSortingOnGPU() && CPUSorting ? CPUSorting->GetRequiredCapacity() : 0;
+	if (NumVisible > 0)
+	{
+		const double Unscaled =
+			double(NumVisible) * FMath::Square(double(BudgetScale));
+		return uint32(
+			FMath::Min(FMath::CeilToDouble(Unscaled), double(NumSplatsToSort)));
+	}
+	return FMath::Min(NumSplatsToSort, Asset->GetNumLODLeaves());
+}
+
+void FSplatSceneProxy::RequestSortingDevice(Shaders::ESortingDevice Device)
+{
+	check(IsInRenderingThread());
+	check(bIsHybridSorting);
+
+	if (Device == RequestedDevice)
+	{
+		return;
+	}
+
+	RequestedDevice = Device;
+	if (Device == Shaders::ESortingDevice::GPU)
+	{
+		ActiveDevice = Device;
+	}
+	else
+	{
+		// Buffers acquired later start counting from zero. A sort launched
+		// before this call may still be running, and is not waited on.
+		CPUSortsAtRequest = CPUSorting ? CPUSorting->GetNumSortsLaunched() : 0;
+	}
+}
+
+void FSplatSceneProxy::UpdateSortingDevice()
+{
+	check(IsInRenderingThread());
+
+	if (RequestedDevice == Shaders::ESortingDevice::CPU &&
+	    ActiveDevice == Shaders::ESortingDevice::GPU && CPUSorting &&
+	    CPUSorting->GetLastCompleteSort() > CPUSortsAtRequest)
+	{
+		ActiveDevice = Shaders::ESortingDevice::CPU;
+	}
+}
+
+void FSplatSceneProxy::UpdateSortingBuffers(
+	FRHICommandListBase& RHICmdList, FSortingBufferPool& Pool)
+{
+	check(IsInRenderingThread());
+	check(ShouldSortOnCPU());
+
+	LastCPUSortTime = FPlatformTime::Seconds();
+	const uint32 NumSplats = GetNumSplats();
+
+	// Until a sort has measured how many splats are visible, assume all are.
+	if (!CPUSorting)
+	{
+		CPUSorting = Pool.Acquire(
+			RHICmdList,
+			LastRequiredCapacity ? LastRequiredCapacity : NumSplats,
+			NumSplats);
+		return;
+	}
+
+	// Keep drawing from the current buffers until the resized ones are ready.
+	if (ResizedCPUSorting)
+	{
+		if (ResizedCPUSorting->IsGPUBufferReady() && CPUSorting->IsIdle())
+		{
+			Pool.Release(MoveTemp(CPUSorting));
+			CPUSorting = MoveTemp(ResizedCPUSorting);
+
+			// If switching from GPU sorting, the resized buffers may hold an
+			// order from before the switch was requested, so wait for the next.
+			if (IsSortingOnGPU())
+			{
+				CPUSortsAtRequest = CPUSorting->GetNumSortsLaunched();
+			}
+		}
+		return;
+	}
+
+	// Don't resize while switching from GPU sorting, as the switch waits on a
+	// copy to the current buffers.
+	if (IsSortingOnGPU())
+	{
+		return;
+	}
+
+	// Grow as soon as splats are dropped, but only shrink once less than half
+	// is used, so small changes in view don't reallocate.
+	const uint32 Required = CPUSorting->GetRequiredCapacity();
+	const uint32 Capacity = CPUSorting->GetCapacity();
+	const bool bTooSmall = Required > Capacity;
+	const bool bTooLarge =
+		Required < Capacity / 2 &&
+		FSortingBufferPool::GetCapacityFor(Required, NumSplats) < Capacity;
+	if (Required > 0 && (bTooSmall || bTooLarge))
+	{
+		ResizedCPUSorting = Pool.Acquire(RHICmdList, Required, NumSplats);
+	}
+}
+
+void FSplatSceneProxy::ReleaseIdleSortingBuffers(
+	FSortingBufferPool& Pool, double Now)
+{
+	check(IsInRenderingThread());
+
+	if (!CPUSorting && !ResizedCPUSorting)
+	{
+		return;
+	}
+	if (Now - LastCPUSortTime < USplatSettings::GetSortingBufferIdleTimeout())
+	{
+		return;
+	}
+
+	// Wait for any sort in progress, so it is not needlessly discarded.
+	if ((CPUSorting && !CPUSorting->IsIdle()) ||
+	    (ResizedCPUSorting && !ResizedCPUSorting->IsIdle()))
+	{
+		return;
+	}
+
+	ReleaseSortingBuffers(Pool);
+
+	// Hybrid sorting can draw immediately on GPU, when next visible.
+	if (bIsHybridSorting)
+	{
+		ActiveDevice = Shaders::ESortingDevice::GPU;
+		RequestedDevice = Shaders::ESortingDevice::GPU;
+	}
+}
+
+void FSplatSceneProxy::ReleaseSortingBuffers(FSortingBufferPool& Pool)
+{
+	check(IsInRenderingThread());
+
+	for (std::shared_ptr<FMultithreadedSortingBuffers>* Buffers :
+	     {&CPUSorting, &ResizedCPUSorting})
+	{
+		if (!*Buffers)
+		{
+			continue;
+		}
+
+		if (const uint32 Required = (*Buffers)->GetRequiredCapacity())
+		{
+			LastRequiredCapacity = Required;
+		}
+		if ((*Buffers)->IsIdle())
+		{
+			Pool.Release(MoveTemp(*Buffers));
+		}
+		else
+		{
+			Pool.Discard(MoveTemp(*Buffers));
+		}
+	}
+}
+
 void FSplatSceneProxy::TryEnqueueSort(
-	const FVector3f& OriginCM, const FVector3f& Forward)
+	const FVector3f& OriginCM,
+	const FVector3f& Forward,
+	float FocalLength,
+	float EccentricityScale)
 {
-	check(!bIsSortingOnGPU);
+	check(ShouldSortOnCPU());
 	check(Asset);
 	check(CPUSorting);
 
-	if (!CPUSorting->IsReadyForSorting())
+	// While resizing, sort into the new buffers.
+	std::shared_ptr<FMultithreadedSortingBuffers>& Buffers =
+		ResizedCPUSorting ? ResizedCPUSorting : CPUSorting;
+	if (!Buffers->IsReadyForSorting())
 	{
 		return;
 	}
 
+	const FMatrix& LocalToWorld = GetLocalToWorld();
+	const float MaxAxisScale = float(LocalToWorld.GetMaximumAxisScale());
+	const FCPUSortView View{
+		OriginCM,
+		Forward,
+		FMatrix44f(LocalToWorld),
+		GetRadiusToPixels(FocalLength),
+		GetMinSplatRadiusPixels(),
+		EccentricityScale,
+		FFoveation::FromSettings(),
+		MetersToCentimeters * MaxAxisScale,
+		GetMaxLODErrorPixels() / FocalLength,
+		NumSplatsToSort};
+
 	// This launches a new sorting task which will `delete` itself once finished.
 	// This is necessary as we otherwise must wait on the task to be completed in
 	// our destructor before it can be deleted.
 	// See AsyncWork.h.
+	//
+	// If a sort is spread over multiple frames, the view given here is only used
+	// once the previous sort finishes.
 	(new FAutoDeleteAsyncTask<FCPUSortingTask>(
 		 Asset->GetPositions(),
-		 CPUSorting,
-		 OriginCM,
-		 Forward,
-		 FMatrix44f(GetLocalToWorld())))
+		 Asset->GetRadiiCM(),
+		 Asset->GetOpacities(),
+		 Asset->GetLODNodes(),
+		 Buffers,
+		 View,
+		 USplatSettings::GetCPUSortSliceBudget(),
+		 USplatSettings::ShouldPublishPartialSort()))
 		->StartBackgroundTask();
 }
 
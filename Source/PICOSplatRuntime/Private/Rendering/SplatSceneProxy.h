@@ -9,7 +9,9 @@
 #include "Misc/AssertionMacros.h"
 #include "PrimitiveSceneProxy.h"
 #include "Rendering/SplatBuffers.h"
+#include "SortingBufferPool.h"
 #include "SplatComponent.h"
+#include "SplatShaders.h"
 
 #if WITH_EDITOR
 #include "StaticMeshResources.h"
@@ -72,39 +74,342 @@ public:
 	}
 
 	/**
-	 * Tells whether this splat should be drawn in the current view.
+	 * Gets the number of splats sorted this frame, from the first. While only a
+	 * prefix of splats ordered by importance is drawn, this is fewer than the
+	 * asset's.
+	 *
+	 * @return The number of splats to sort.
+	 */
+	uint32 GetNumSplatsToSort() const { return NumSplatsToSort; }
+
+	/**
+	 * Gets the number of splats, from the first, transformed and adjusted on
+	 * the GPU this frame. A CPU sort being drawn may have begun with a longer
+	 * prefix, so with CPU sorting, this is every splat.
+	 *
+	 * @return The number of splats to transform.
+	 */
+	uint32 GetNumSplatsToTransform() const
+	{
+		return IsSortingOnGPU() ? NumSplatsToSort : GetNumSplats();
+	}
+
+	/**
+	 * Sets the number of splats sorted, and so drawn, from now on. Only assets
+	 * ordered by importance draw fewer than all of their splats.
+	 *
+	 * @param NumSplats - Number of splats, from the first.
+	 */
+	void SetNumSplatsToSort(uint32 NumSplats);
+
+	/**
+	 * Gets the fraction of the asset's coverage kept by the splats drawn. With
+	 * CPU sorting, this follows the prefix of the sort being drawn, rather
+	 * than the one being sorted.
+	 *
+	 * @return Fraction of coverage, in (0, 1]. The opacity of the splats drawn
+	 * is raised to compensate.
+	 */
+	float GetPrefixCoverage() const;
+
+	/**
+	 * @return Whether the asset's splats are ordered by importance, so only a
+	 * prefix of them may be drawn.
+	 */
+	bool IsOrderedByImportance() const
+	{
+		check(Asset);
+		return Asset->IsOrderedByImportance();
+	}
+
+	/**
+	 * Sets how much coarser than the settings detail is chosen, so this
+	 * proxy's splats stay within its share of the splat budget.
+	 *
+	 * @param Scale - Scale of the largest level of detail error drawn, and of
+	 * the smallest splat radius sorted on CPU. At least 1.
+	 */
+	void SetBudgetScale(float Scale) { BudgetScale = FMath::Max(Scale, 1.f); }
+
+	/**
+	 * @return Projected error up to which coarser levels of detail are drawn,
+	 * in pixels, or 0 to draw only the finest.
+	 */
+	float GetMaxLODErrorPixels() const;
+
+	/**
+	 * @return Projected radius below which splats are culled when sorting on
+	 * CPU, or thinning, in pixels, or 0 to disable culling.
+	 */
+	float GetMinSplatRadiusPixels() const;
+
+	/**
+	 * Gets the number of splats to draw. With GPU sorting, every splat sorted
+	 * is drawn. With CPU sorting, only splats visible to the last sort are.
+	 *
+	 * @return The number of splats to draw.
+	 */
+	uint32 GetNumSplatsToDraw() const
+	{
+		if (IsSortingOnGPU())
+		{
+			return NumSplatsToSort;
+		}
+		check(CPUSorting);
+		return CPUSorting->GetNumToDraw();
+	}
+
+	/**
+	 * Estimates the number of splats drawn at the detail of the settings,
+	 * were this proxy given its whole share of the splat budget. With CPU
+	 * sorting, this is the number visible to the last sort, scaled back from
+	 * the budget it was sorted with. Otherwise, as cuts are only known on the
+	 * GPU, it is the number of leaves of the level of detail hierarchy.
+	 *
+	 * @return The number of splats wanted, at most the number sorted.
+	 */
+	uint32 GetNumSplatsWanted() const;
+
+	/**
+	 * Tells whether this splat should be drawn in the current view. Splats
+	 * whose asset's GPU buffers are evicted are not, until uploaded again.
 	 *
 	 * @param View - View to test against.
 	 * @return True, if this splat should be drawn.
 	 */
 	bool IsVisible(const FSceneView& View) const;
 
+	/**
+	 * @return The asset this splat draws.
+	 */
+	USplatAsset* GetAsset() const { return Asset; }
+
 	/**
 	 * Enqueues a CPU sort of the splats, if not already active.
 	 *
 	 * @param OriginCM - Origin to sort relative to, in centimeters.
 	 * @param Forward - Forward direction of view, normalized.
+	 * @param FocalLength - Focal length of view, in pixels. Used to cull splats
+	 * smaller than a pixel.
+	 * @param EccentricityScale - Focal length of view over half its width. Used
+	 * for foveated thinning.
 	 */
-	void TryEnqueueSort(const FVector3f& OriginCM, const FVector3f& Forward);
+	void TryEnqueueSort(
+		const FVector3f& OriginCM,
+		const FVector3f& Forward,
+		float FocalLength,
+		float EccentricityScale);
 
 	/**
+	 * Gets the color buffer to draw with. While adjusted colors are enabled,
+	 * this is the copy written by `AdjustSplats`.
+	 *
 	 * @return SRV for the color buffer.
 	 */
 	FShaderResourceViewRHIRef GetColorsSRV() const
 	{
+		if (AdjustedColors)
+		{
+			check(AdjustedColors->ShaderResourceViewRHI);
+			return AdjustedColors->ShaderResourceViewRHI;
+		}
 		check(Asset);
 		return Asset->GetColorsSRV();
 	}
 
 	/**
+	 * @return SRV for the asset's color buffer, ignoring any adjusted colors.
+	 */
+	FShaderResourceViewRHIRef GetAssetColorsSRV() const
+	{
+		check(Asset);
+		return Asset->GetColorsSRV();
+	}
+
+	/**
+	 * Gets the UAV for the adjusted color buffer. Adjusted colors *must* be
+	 * enabled.
+	 *
+	 * @return UAV for the adjusted color buffer.
+	 */
+	FUnorderedAccessViewRHIRef GetAdjustedColorsUAV() const
+	{
+		check(AdjustedColors);
+		check(AdjustedColors->UnorderedAccessViewRHI);
+		return AdjustedColors->UnorderedAccessViewRHI;
+	}
+
+	/**
+	 * Allocates or releases a copy of the colors, for fading oversized splats,
+	 * compensating for thinning or adding view-dependent color. Once enabled, it *must* be written every
+	 * frame before drawing.
+	 *
+	 * @param RHICmdList - The RHI command list to create resources with.
+	 * @param bEnabled - Whether adjusted colors should be drawn.
+	 */
+	void
+	SetAdjustedColorsEnabled(FRHICommandListBase& RHICmdList, bool bEnabled);
+
+	/**
+	 * Gets the covariance matrix buffer. With the codebook format, this is the
+	 * buffer most recently decoded into by `DecodeCovariances`.
+	 *
 	 * @return SRV for the covariance matrix buffer.
 	 */
 	FShaderResourceViewRHIRef GetCovariancesSRV() const
 	{
+		if (HasCovarianceCodebook())
+		{
+			check(DecodedCovariancesSRV);
+			return DecodedCovariancesSRV;
+		}
 		check(Asset);
 		return Asset->GetCovariancesSRV();
 	}
 
+	/**
+	 * @return Whether the asset's covariances use the codebook format, so
+	 * *must* be decoded each frame before use.
+	 */
+	bool HasCovarianceCodebook() const
+	{
+		check(Asset);
+		return Asset->GetCovarianceFormat() == ECovarianceFormat::Codebook16;
+	}
+
+	/**
+	 * @return SRV for the asset's covariance codebook.
+	 */
+	FShaderResourceViewRHIRef GetCovarianceCodebookSRV() const
+	{
+		check(Asset);
+		return Asset->GetCovarianceCodebookSRV();
+	}
+
+	/**
+	 * @return SRV for the asset's covariance codebook indices.
+	 */
+	FShaderResourceViewRHIRef GetCovarianceIndicesSRV() const
+	{
+		check(Asset);
+		return Asset->GetCovarianceIndicesSRV();
+	}
+
+	/**
+	 * Sets the buffer covariances were decoded into this frame. With the
+	 * codebook format, this is read in place of the asset's.
+	 *
+	 * @param SRV - SRV for the decoded covariance matrix buffer.
+	 */
+	void SetDecodedCovariancesSRV(FShaderResourceViewRHIRef SRV)
+	{
+		DecodedCovariancesSRV = MoveTemp(SRV);
+	}
+
+	/**
+	 * @return Degree of the asset's spherical harmonics, or 0 if none.
+	 */
+	uint32 GetSHDegree() const
+	{
+		check(Asset);
+		return Asset->GetSHDegree();
+	}
+
+	/**
+	 * @return Whether the asset's spherical harmonics use the codebook format.
+	 */
+	bool HasSHCodebook() const
+	{
+		check(Asset);
+		return Asset->GetSHFormat() == ESHFormat::Codebook;
+	}
+
+	/**
+	 * Gets the asset's spherical harmonics, and the range each coefficient is
+	 * quantized to.
+	 *
+	 * @param OutMin - Returns the minimum of each coefficient.
+	 * @param OutScale - Returns the step of each coefficient.
+	 * @return SRV for the packed coefficients.
+	 */
+	FShaderResourceViewRHIRef GetSHCoefficientsSRV(
+		TConstArrayView<float>& OutMin, TConstArrayView<float>& OutScale) const
+	{
+		check(Asset);
+		return Asset->GetSHCoefficientsSRV(OutMin, OutScale);
+	}
+
+	/**
+	 * @return SRV for the asset's spherical harmonics codebook indices.
+	 */
+	FShaderResourceViewRHIRef GetSHIndicesSRV() const
+	{
+		check(Asset);
+		return Asset->GetSHIndicesSRV();
+	}
+
+	/**
+	 * @return Matrix from local directions to the asset's spherical harmonics
+	 * directions.
+	 */
+	const FMatrix44f& GetLocalToSH() const
+	{
+		check(Asset);
+		return Asset->GetLocalToSH();
+	}
+
+	/**
+	 * @return Whether the asset has a level of detail hierarchy, so only a cut
+	 * of it may be drawn.
+	 */
+	bool HasLOD() const
+	{
+		check(Asset);
+		return Asset->HasLOD();
+	}
+
+	/**
+	 * @return SRV for the asset's packed level of detail nodes.
+	 */
+	FShaderResourceViewRHIRef GetLODNodesSRV() const
+	{
+		check(Asset);
+		return Asset->GetLODNodesSRV();
+	}
+
+	/**
+	 * @return Whether the asset's radii are uploaded, so splats can be thinned
+	 * on the GPU as on the CPU.
+	 */
+	bool HasRadiiBuffer() const
+	{
+		check(Asset);
+		return Asset->HasRadiiBuffer();
+	}
+
+	/**
+	 * @return SRV for the asset's radii, at one standard deviation.
+	 */
+	FShaderResourceViewRHIRef GetRadiiSRV() const
+	{
+		check(Asset);
+		return Asset->GetRadiiSRV();
+	}
+
+	/**
+	 * Gets the scale from a splat's radius over its depth to its projected
+	 * radius. Shared by CPU sorting and `FAdjustSplatsCS`, so both measure
+	 * splats alike.
+	 *
+	 * @param FocalLength - Focal length of the view, in pixels.
+	 * @return Scale, in pixels, including the scale of the proxy.
+	 */
+	float GetRadiusToPixels(float FocalLength) const
+	{
+		return FocalLength * SplatRadiusStdDevs *
+		       float(GetLocalToWorld().GetMaximumAxisScale());
+	}
+
 	/**
 	 * Gets the active index buffer SRV. This works for both CPU and GPU
 	 * sorting.
@@ -113,7 +418,7 @@ public:
 	 */
 	FShaderResourceViewRHIRef GetIndicesSRV() const
 	{
-		if (bIsSortingOnGPU)
+		if (IsSortingOnGPU())
 		{
 			check(Indices);
 			check(Indices->ShaderResourceViewRHI);
@@ -157,7 +462,7 @@ public:
 	 */
 	FUnorderedAccessViewRHIRef GetIndicesUAV() const
 	{
-		check(bIsSortingOnGPU);
+		check(IsSortingOnGPU());
 		check(Indices);
 		check(Indices->UnorderedAccessViewRHI);
 		return Indices->UnorderedAccessViewRHI;
@@ -195,17 +500,103 @@ public:
 	 */
 	bool NeedsSort()
 	{
-		check(bIsSortingOnGPU || CPUSorting);
-		return !bIsSortingOnGPU && !CPUSorting->IsGPUBufferReady();
+		return !IsSortingOnGPU() &&
+		       (!CPUSorting || !CPUSorting->IsGPUBufferReady());
+	}
+
+	/**
+	 * @return Whether this frame's indices come from a GPU sort, rather than a
+	 * CPU sort.
+	 */
+	bool IsSortingOnGPU() const
+	{
+		return ActiveDevice == Shaders::ESortingDevice::GPU;
 	}
 
+	/**
+	 * @return Whether CPU sorting tasks should be launched for this proxy. This
+	 * may be true while still drawing with GPU sorting, until the first CPU
+	 * sort is ready.
+	 */
+	bool ShouldSortOnCPU() const
+	{
+		return RequestedDevice == Shaders::ESortingDevice::CPU;
+	}
+
+	/**
+	 * @return Whether this proxy can switch between CPU and GPU sorting.
+	 */
+	bool IsHybridSorting() const { return bIsHybridSorting; }
+
+	/**
+	 * Requests this proxy be sorted on the given device. Switching to GPU
+	 * happens immediately. Switching to CPU happens once a CPU sort started
+	 * after this call has been copied to the GPU whole, so neither a stale
+	 * nor a partially sorted order is drawn.
+	 *
+	 * Must be using hybrid sorting.
+	 *
+	 * @param Device - Device to sort on.
+	 */
+	void RequestSortingDevice(Shaders::ESortingDevice Device);
+
+	/**
+	 * Completes a pending switch to CPU sorting, if a CPU sort is ready. Call
+	 * once per frame, before sorting.
+	 */
+	void UpdateSortingDevice();
+
+	/**
+	 * Acquires CPU sorting buffers from the pool, if this proxy has none. Once
+	 * sorting shows the visible splats no longer fit, or use less than half,
+	 * swaps them for buffers of the right size. Call once per frame, while
+	 * sorting on CPU.
+	 *
+	 * @param RHICmdList - The RHI command list to create resources with.
+	 * @param Pool - Pool to acquire buffers from, and return them to.
+	 */
+	void UpdateSortingBuffers(
+		FRHICommandListBase& RHICmdList, FSortingBufferPool& Pool);
+
+	/**
+	 * Returns CPU sorting buffers to the pool, if this proxy has not been
+	 * sorted on CPU for longer than the idle timeout. Call once per frame.
+	 *
+	 * @param Pool - Pool to return buffers to.
+	 * @param Now - Current time, in seconds.
+	 */
+	void ReleaseIdleSortingBuffers(FSortingBufferPool& Pool, double Now);
+
+	/**
+	 * Returns CPU sorting buffers to the pool, if any, regardless of when they
+	 * were last used. Buffers still in use by a sorting task are discarded.
+	 *
+	 * @param Pool - Pool to return buffers to.
+	 */
+	void ReleaseSortingBuffers(FSortingBufferPool& Pool);
+
 private:
 	TObjectPtr<USplatAsset> Asset;
 	FSplatGPUToGPUBuffer Transforms;
 
-	bool bIsSortingOnGPU;
+	// With hybrid sorting, `Indices` is allocated and `CPUSorting` is acquired
+	// as needed, and the active device may change each frame.
+	bool bIsHybridSorting;
+	Shaders::ESortingDevice ActiveDevice;
+	Shaders::ESortingDevice RequestedDevice;
+	// Sorting tasks launched before switching to CPU sorting was requested.
+	// The switch waits for a complete sort started by a later one.
+	uint32 CPUSortsAtRequest;
+
 	std::optional<FSplatGPUToGPUBuffer> Indices;
 
+	// Colors with opacities adjusted, allocated only while needed.
+	std::optional<FSplatGPUToGPUBuffer> AdjustedColors;
+
+	// With the codebook format, covariances decoded this frame, into a buffer
+	// shared between proxies.
+	FShaderResourceViewRHIRef DecodedCovariancesSRV;
+
 	// This is a shared_ptr, as while this proxy "owns" the CPU sorting data, it
 	// may be outlived by the sorting task and/or GPU copy command. In either
 	// case, we need to keep this data around past the lifetime of the proxy in.
@@ -213,8 +604,30 @@ private:
 	//   - Render thread resources will be cleaned up by the sorting task.
 	//   - All other resources will be destroyed automatically by whichever of the
 	//     sorting task or the copy command completes later.
+	//
+	// Buffers are taken from `FSortingBufferPool` only while sorting on CPU.
 	std::shared_ptr<FMultithreadedSortingBuffers> CPUSorting;
 
+	// Buffers of a new size, which are sorted into while `CPUSorting` is still
+	// drawn from, until their first sort is ready.
+	std::shared_ptr<FMultithreadedSortingBuffers> ResizedCPUSorting;
+
+	// Time of the last frame sorted on CPU, in seconds.
+	double LastCPUSortTime;
+
+	// Visible splats found when buffers were last returned to the pool, to size
+	// the next buffers acquired. Zero if unknown.
+	uint32 LastRequiredCapacity;
+
+	// Leading splats sorted from now on, and the fraction of coverage they
+	// keep.
+	uint32 NumSplatsToSort;
+	float PrefixCoverage;
+
+	// Scale of detail thresholds, to stay within this proxy's share of the
+	// splat budget.
+	float BudgetScale;
+
 	FRDGBufferRef IndicesFake;
 	FRDGBufferRef DistancesFake;
 
@@ -4,17 +4,22 @@
 
 #include "SplatSceneViewExtension.h"
 
+#include "HAL/PlatformTime.h"
 #include "Logging.h"
 #include "PostProcess/PostProcessing.h"
 #include "SplatRendering.h"
 #include "SplatRenderingUtilities.h"
-#include "SplatSettings.h"
+#include "SplatStats.h"
 #include "StereoRendering.h"
 
 namespace PICO::Splat
 {
 namespace
 {
+// Smallest fraction of the splats they want proxies not ordered by importance
+// are assumed to draw, so their detail is never more than 4x coarser.
+constexpr double MIN_BUDGET_FRACTION = 1.0 / 16.0;
+
 /**
  * See comment in SplatRendering.cpp.
  */
@@ -37,13 +42,53 @@ SetSharedParameters(const FSceneView& View, FSplatSceneProxy* Proxy)
 
 	return Params;
 }
+
+/**
+ * Gathers the proxies visible in a view, ordered back to front, so the splats
+ * of overlapping proxies (e.g. neighbouring chunks) blend in order.
+ *
+ * @param Proxies - Every registered proxy.
+ * @param View - View splats are drawn in.
+ * @param OutProxies - Returns the visible proxies, furthest first.
+ */
+void GatherVisibleProxiesBackToFront(
+	const TSet<FSplatSceneProxy*>& Proxies,
+	const FSceneView& View,
+	TArray<FSplatSceneProxy*, TInlineAllocator<32>>& OutProxies)
+{
+	const FVector Origin = View.ViewMatrices.GetViewOrigin();
+	TArray<TPair<double, FSplatSceneProxy*>, TInlineAllocator<32>> Sorted;
+	for (FSplatSceneProxy* Proxy : Proxies)
+	{
+		check(Proxy);
+		if (Proxy->IsVisible(View))
+		{
+			Sorted.Emplace(
+				-FVector::DistSquared(Origin, Proxy->GetBounds().Origin),
+				Proxy);
+		}
+	}
+	Sorted.Sort(
+		[](const TPair<double, FSplatSceneProxy*>& A,
+	       const TPair<double, FSplatSceneProxy*>& B)
+		{ return A.Key < B.Key; });
+
+	OutProxies.Reset();
+	for (const TPair<double, FSplatSceneProxy*>& Entry : Sorted)
+	{
+		OutProxies.Add(Entry.Value);
+	}
+}
 } // namespace
 
 FSplatSceneViewExtension::FSplatSceneViewExtension(
 	const FAutoRegister& AutoRegister)
 	: FSceneViewExtensionBase(AutoRegister)
-	, bIsSortingOnGPU(USplatSettings::IsSortingOnGPU())
 	, Proxies()
+	, SortingController()
+	, BudgetController()
+	, SortingBufferPool()
+	, OversizedCounter(TEXT("NumOversizedSplats"))
 {
 	FSceneViewExtensionIsActiveFunctor IsActiveFunctor;
 	IsActiveFunctor.IsActiveFunction =
@@ -60,6 +105,162 @@ FSplatSceneViewExtension::FSplatSceneViewExtension(
 	IsActiveThisFrameFunctions.Add(IsActiveFunctor);
 }
 
+FSplatSceneViewExtension::~FSplatSceneViewExtension()
+{
+	if (!DecodedCovariances)
+	{
+		return;
+	}
+
+	// This may be destroyed off the render thread.
+	ENQUEUE_RENDER_COMMAND(ReleaseDecodedCovariances)(
+		[Buffer = MoveTemp(*DecodedCovariances)](
+			FRHICommandList& RHICmdList) mutable { Buffer.ReleaseResource(); });
+}
+
+void FSplatSceneViewExtension::UpdateDecodedCovariances(
+	FRHICommandListBase& RHICmdList)
+{
+	uint32 Capacity = 0;
+	for (const FSplatSceneProxy* Proxy : Proxies)
+	{
+		if (Proxy->HasCovarianceCodebook())
+		{
+			Capacity = FMath::Max(Capacity, Proxy->GetNumSplats());
+		}
+	}
+
+	if (Capacity == DecodedCovariancesCapacity)
+	{
+		return;
+	}
+
+	// Passes already enqueued keep the old buffer alive until they finish.
+	if (DecodedCovariances)
+	{
+		DecodedCovariances->ReleaseResource();
+		DecodedCovariances.reset();
+	}
+	if (Capacity > 0)
+	{
+		DecodedCovariances = FSplatGPUToGPUBuffer(
+			Capacity, GetFormat<FPackedCovMat>());
+		DecodedCovariances->InitRHI(RHICmdList);
+	}
+	DecodedCovariancesCapacity = Capacity;
+}
+
+void FSplatSceneViewExtension::ApplySplatBudget(
+	const FSceneView& View, TConstArrayView<FSplatSceneProxy*> VisibleProxies)
+{
+	// Proxies want what they draw at the detail of the settings, except those
+	// ordered by importance, which want a fraction of their splats falling
+	// with the square of their distance, as does the area they cover on
+	// screen.
+	const FVector Origin = View.ViewMatrices.GetViewOrigin();
+	const double FullDetailDistance =
+		USplatSettings::GetImportanceFullDetailDistance();
+	const float MinFraction = USplatSettings::GetMinImportanceFraction();
+
+	struct FShare
+	{
+		FSplatSceneProxy* Proxy;
+		// Approximate fraction of the screen covered.
+		double Coverage;
+		uint64 NumWanted;
+		uint64 NumGiven;
+	};
+	TArray<FShare, TInlineAllocator<32>> Shares;
+	uint64 NumWanted = 0;
+	double TotalCoverage = 0.0;
+	for (FSplatSceneProxy* Proxy : VisibleProxies)
+	{
+		const FBoxSphereBounds& Bounds = Proxy->GetBounds();
+		const double Radius =
+			FMath::Max(Bounds.SphereRadius, UE_KINDA_SMALL_NUMBER);
+		const double CenterDistance = FVector::Dist(Origin, Bounds.Origin);
+		const double Distance = CenterDistance - Radius;
+		const uint32 NumSplats = Proxy->GetNumSplats();
+
+		uint64 Wanted = NumSplats;
+		if (!Proxy->IsOrderedByImportance())
+		{
+			Wanted = Proxy->GetNumSplatsWanted();
+		}
+		else if (Distance > FullDetailDistance)
+		{
+			const double Fraction = FMath::Max(
+				FMath::Square(FullDetailDistance / Distance),
+				double(MinFraction));
+			Wanted = uint64(FMath::CeilToInt64(Fraction * NumSplats));
+		}
+		const double Coverage =
+			FMath::Square(Radius / FMath::Max(CenterDistance, Radius));
+
+		Shares.Add({Proxy, Coverage, Wanted, Wanted});
+		NumWanted += Wanted;
+		TotalCoverage += Coverage;
+	}
+
+	const bool bFirstView =
+		BudgetController.Update(View, FrameTimes, NumWanted);
+	const uint64 Budget = BudgetController.GetBudget();
+
+	// Over budget, share it by screen coverage. Proxies wanting less than
+	// their share are given what they want first, and what they leave is
+	// shared between the rest.
+	if (NumWanted > Budget)
+	{
+		Shares.Sort(
+			[](const FShare& A, const FShare& B)
+			{
+				return A.NumWanted * B.Coverage < B.NumWanted * A.Coverage;
+			});
+		uint64 Remaining = Budget;
+		for (FShare& Share : Shares)
+		{
+			const double Portion = Share.Coverage / TotalCoverage;
+			Share.NumGiven = FMath::Min(
+				Share.NumWanted,
+				FMath::Min(Remaining, uint64(Portion * double(Remaining))));
+			Remaining -= Share.NumGiven;
+			TotalCoverage -= Share.Coverage;
+		}
+	}
+
+	uint32 NumSkipped = 0;
+	for (const FShare& Share : Shares)
+	{
+		FSplatSceneProxy* Proxy = Share.Proxy;
+		if (Proxy->IsOrderedByImportance())
+		{
+			// Prefixes shorten to exactly their share, down to the minimum.
+			const uint32 NumSplats = Proxy->GetNumSplats();
+			const uint64 NumRequired =
+				uint64(FMath::CeilToInt64(MinFraction * NumSplats));
+			Proxy->SetNumSplatsToSort(
+				uint32(FMath::Max(Share.NumGiven, NumRequired)));
+			Proxy->SetBudgetScale(1.f);
+			NumSkipped += NumSplats - Proxy->GetNumSplatsToSort();
+			continue;
+		}
+
+		// Other proxies coarsen their levels of detail, or cull more small
+		// splats. Either draws about as many fewer splats as the square of
+		// the threshold's scale, as each covers as much more of the screen.
+		const double Fraction = double(Share.NumGiven) /
+		                        double(FMath::Max<uint64>(Share.NumWanted, 1));
+		Proxy->SetBudgetScale(float(
+			1.0 / FMath::Sqrt(FMath::Max(Fraction, MIN_BUDGET_FRACTION))));
+	}
+	// Counted for the first view each frame, so views sharing proxies (e.g.
+	// split screen) do not count them again.
+	if (bFirstView)
+	{
+		INC_DWORD_STAT_BY(STAT_SplatImportanceSkipped, NumSkipped);
+	}
+}
+
 void FSplatSceneViewExtension::PreRenderView_RenderThread(
 	FRDGBuilder& GraphBuilder, FSceneView& View)
 {
@@ -76,21 +277,104 @@ void FSplatSceneViewExtension::PreRenderView_RenderThread(
 		return;
 	}
 
+	// Return sorting buffers no longer in use, so they can be shared.
+	const double Now = FPlatformTime::Seconds();
+	SortingBufferPool.Tick(Now);
+
+	// Evict and upload again assets' GPU buffers, before testing visibility.
+	ResidencyManager.Update(GraphBuilder.RHICmdList, View, Proxies);
+
+	TArray<FSplatSceneProxy*, TInlineAllocator<32>> VisibleProxies;
 	for (auto& Proxy : Proxies)
 	{
 		check(Proxy);
 
-		if (!Proxy->IsVisible(View))
+		Proxy->ReleaseIdleSortingBuffers(SortingBufferPool, Now);
+		if (Proxy->IsVisible(View))
 		{
-			continue;
+			VisibleProxies.Add(Proxy);
 		}
+	}
+
+	// Measure the previous frame, once per frame.
+	check(View.Family);
+	if (View.Family->FrameNumber != LastMeasuredFrameNumber)
+	{
+		LastMeasuredFrameNumber = View.Family->FrameNumber;
+		FrameTimes.Measure();
+	}
+
+	// The budget is applied first, as hybrid sorting splits sorts by size.
+	ApplySplatBudget(View, VisibleProxies);
+
+	// With hybrid sorting, choose the sorting device for each proxy.
+	SortingController.Update(View, VisibleProxies, FrameTimes);
+
+	UpdateDecodedCovariances(GraphBuilder.RHICmdList);
+
+	// Oversized splats are counted across proxies, and read back frames later.
+	const EOversizedSplatPolicy OversizedPolicy =
+		USplatSettings::GetOversizedSplatPolicy();
+	const FFoveation Foveation = FFoveation::FromSettings();
+	const bool bAdjustColors =
+		OversizedPolicy == EOversizedSplatPolicy::Fade || Foveation.bEnabled;
+	const uint32 MaxSHDegree = USplatSettings::GetMaxSHDegree();
+	bool bAnySH = false;
+	bool bAnyLOD = false;
+	bool bAnyPrefix = false;
+	for (auto& Proxy : VisibleProxies)
+	{
+		bAnySH |= FMath::Min(MaxSHDegree, Proxy->GetSHDegree()) > 0;
+		bAnyLOD |= Proxy->HasLOD();
+		bAnyPrefix |= Proxy->IsOrderedByImportance();
+	}
+	FRDGBufferUAVRef NumOversized = nullptr;
+	if (OversizedPolicy != EOversizedSplatPolicy::None || Foveation.bEnabled ||
+	    bAnySH || bAnyLOD || bAnyPrefix)
+	{
+		NumOversized = OversizedCounter.Begin(GraphBuilder);
+		SET_DWORD_STAT(STAT_SplatOversized, OversizedCounter.GetLatest());
+	}
+
+	for (auto& Proxy : VisibleProxies)
+	{
+		if (Proxy->ShouldSortOnCPU())
+		{
+			Proxy->UpdateSortingBuffers(
+				GraphBuilder.RHICmdList, SortingBufferPool);
+		}
+		Proxy->UpdateSortingDevice();
+
+		uint32 NumSplats = Proxy->GetNumSplatsToSort();
 
-		uint32 NumSplats = Proxy->GetNumSplats();
+		if (Proxy->HasCovarianceCodebook())
+		{
+			check(DecodedCovariances);
+			DecodeCovariances(GraphBuilder, Proxy, *DecodedCovariances);
+		}
 
 		FRDGPassRef ProjPass = ComputeTransforms(GraphBuilder, View, Proxy);
 
-		if (bIsSortingOnGPU)
+		const uint32 SHDegree = FMath::Min(MaxSHDegree, Proxy->GetSHDegree());
+		Proxy->SetAdjustedColorsEnabled(
+			GraphBuilder.RHICmdList,
+			bAdjustColors || SHDegree > 0 || Proxy->IsOrderedByImportance());
+		if (NumOversized)
+		{
+			AdjustSplats(
+				GraphBuilder,
+				View,
+				Proxy,
+				OversizedPolicy,
+				Foveation,
+				SHDegree,
+				NumOversized);
+		}
+
+		if (Proxy->IsSortingOnGPU())
 		{
+			INC_DWORD_STAT(STAT_SplatProxiesSortedOnGPU);
+
 			FRDGBufferDesc IndexDesc =
 				FRDGBufferDesc::CreateBufferDesc(sizeof(uint32), NumSplats);
 			Proxy->GetIndicesFake() =
@@ -117,14 +401,30 @@ void FSplatSceneViewExtension::PreRenderView_RenderThread(
 		}
 		else
 		{
+			INC_DWORD_STAT(STAT_SplatProxiesSortedOnCPU);
+
 			FRDGBufferDesc IndexDesc =
 				FRDGBufferDesc::CreateBufferDesc(sizeof(uint32), NumSplats);
 			Proxy->GetIndicesFake() = GraphBuilder.CreateBuffer(
 				IndexDesc, TEXT("IndicesWithDistances"));
+		}
 
-			Proxy->TryEnqueueSort(GetOrigin(View), GetForward(View));
+		// When switching to CPU sorting, this runs alongside GPU sorting until
+		// the first CPU sort is ready.
+		if (Proxy->ShouldSortOnCPU())
+		{
+			Proxy->TryEnqueueSort(
+				GetOrigin(View),
+				GetForward(View),
+				GetFocalLength(View),
+				GetEccentricityScale(View));
 		}
 	}
+
+	if (NumOversized)
+	{
+		OversizedCounter.End(GraphBuilder);
+	}
 }
 
 void FSplatSceneViewExtension::PrePostProcessPass_RenderThread(
@@ -132,20 +432,16 @@ void FSplatSceneViewExtension::PrePostProcessPass_RenderThread(
 	const FSceneView& View,
 	const FPostProcessingInputs& Inputs)
 {
-	for (auto& Proxy : Proxies)
+	TArray<FSplatSceneProxy*, TInlineAllocator<32>> VisibleProxies;
+	GatherVisibleProxiesBackToFront(Proxies, View, VisibleProxies);
+	for (auto& Proxy : VisibleProxies)
 	{
-		check(Proxy);
-
-		if (!Proxy->IsVisible(View))
-		{
-			continue;
-		}
-		if (Proxy->NeedsSort())
+		if (Proxy->NeedsSort() || Proxy->GetNumSplatsToDraw() == 0)
 		{
 			continue;
 		}
 
-		if (!bIsSortingOnGPU)
+		if (!Proxy->IsSortingOnGPU())
 		{
 			FCPUSortRenderProducerParameters* SetupParameters =
 				GraphBuilder
@@ -160,6 +456,8 @@ void FSplatSceneViewExtension::PrePostProcessPass_RenderThread(
 				[](FRHIComputeCommandList& RHICmdList) {});
 		}
 
+		// Captured now, as the pass may execute off the render thread.
+		const uint32 NumToDraw = Proxy->GetNumSplatsToDraw();
 		Shaders::FRenderSplatSharedParameters Shared =
 			SetSharedParameters(View, Proxy);
 		Shaders::FRenderSplatPS::FParameters ParamsPS;
@@ -172,7 +470,7 @@ void FSplatSceneViewExtension::PrePostProcessPass_RenderThread(
 			ERenderTargetLoadAction::ELoad,
 			FExclusiveDepthStencil::DepthWrite_StencilNop);
 
-		if (bIsSortingOnGPU)
+		if (Proxy->IsSortingOnGPU())
 		{
 			FRenderSplatGPUSortDeps* PassParameters =
 				GraphBuilder.AllocParameters<FRenderSplatGPUSortDeps>();
@@ -187,14 +485,10 @@ void FSplatSceneViewExtension::PrePostProcessPass_RenderThread(
 				RDG_EVENT_NAME("Splat: Render %s", *Proxy->GetName()),
 				PassParameters,
 				ERDGPassFlags::Raster,
-				[this, PassParameters, Proxy, &View](
-					FRHICommandList& RHICmdList)
+				[PassParameters, NumToDraw, &View](FRHICommandList& RHICmdList)
 				{
 					RenderSplatGPUSort(
-						RHICmdList,
-						PassParameters,
-						Proxy->GetNumSplats(),
-						View);
+						RHICmdList, PassParameters, NumToDraw, View);
 				});
 		}
 		else
@@ -213,14 +507,10 @@ void FSplatSceneViewExtension::PrePostProcessPass_RenderThread(
 				RDG_EVENT_NAME("Splat: Render %s", *Proxy->GetName()),
 				PassParameters,
 				ERDGPassFlags::Raster,
-				[this, PassParameters, Proxy, &View](
-					FRHICommandList& RHICmdList)
+				[PassParameters, NumToDraw, &View](FRHICommandList& RHICmdList)
 				{
 					RenderSplatCPUSort(
-						RHICmdList,
-						PassParameters,
-						Proxy->GetNumSplats(),
-						View);
+						RHICmdList, PassParameters, NumToDraw, View);
 				});
 		}
 	}
@@ -229,15 +519,11 @@ void FSplatSceneViewExtension::PrePostProcessPass_RenderThread(
 void FSplatSceneViewExtension::PostRenderBasePassMobile_RenderThread(
 	FRHICommandList& RHICmdList, FSceneView& InView)
 {
-	for (auto& Proxy : Proxies)
+	TArray<FSplatSceneProxy*, TInlineAllocator<32>> VisibleProxies;
+	GatherVisibleProxiesBackToFront(Proxies, InView, VisibleProxies);
+	for (auto& Proxy : VisibleProxies)
 	{
-		check(Proxy);
-
-		if (!Proxy->IsVisible(InView))
-		{
-			continue;
-		}
-		if (Proxy->NeedsSort())
+		if (Proxy->NeedsSort() || Proxy->GetNumSplatsToDraw() == 0)
 		{
 			continue;
 		}
@@ -250,13 +536,13 @@ void FSplatSceneViewExtension::PostRenderBasePassMobile_RenderThread(
 			RenderSplat,
 			TEXT("Splat: Render %s"),
 			Proxy->GetName());
-		if (bIsSortingOnGPU)
+		if (Proxy->IsSortingOnGPU())
 		{
 			FRenderSplatGPUSortDeps Parameters{};
 			Parameters.VS.Shared = Shared;
 			Parameters.VS.Indices = Proxy->GetIndicesSRV();
 			RenderSplatGPUSort(
-				RHICmdList, &Parameters, Proxy->GetNumSplats(), InView);
+				RHICmdList, &Parameters, Proxy->GetNumSplatsToDraw(), InView);
 		}
 		else
 		{
@@ -264,7 +550,7 @@ void FSplatSceneViewExtension::PostRenderBasePassMobile_RenderThread(
 			Parameters.VS.Shared = Shared;
 			Parameters.VS.Indices = Proxy->GetIndicesSRV();
 			RenderSplatCPUSort(
-				RHICmdList, &Parameters, Proxy->GetNumSplats(), InView);
+				RHICmdList, &Parameters, Proxy->GetNumSplatsToDraw(), InView);
 		}
 	}
 }
@@ -4,9 +4,16 @@
 
 #pragma once
 
+#include <optional>
+
 #include "Containers/Set.h"
+#include "GPUCounterReadback.h"
 #include "Misc/AssertionMacros.h"
 #include "SceneViewExtension.h"
+#include "SortingBufferPool.h"
+#include "SortingController.h"
+#include "SplatBudgetController.h"
+#include "SplatResidencyManager.h"
 #include "SplatSceneProxy.h"
 
 namespace PICO::Splat
@@ -26,6 +33,11 @@ class FSplatSceneViewExtension final : public FSceneViewExtensionBase
 public:
 	FSplatSceneViewExtension(const FAutoRegister& AutoRegister);
 
+	/**
+	 * Releases the decoded covariance buffer, if any.
+	 */
+	~FSplatSceneViewExtension();
+
 	//~ Begin ISceneViewExtension Interface
 	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {};
 	virtual void
@@ -37,9 +49,13 @@ public:
 	 * First stage: Enqueue async compute work, to be done before actual
 	 * rendering.
 	 *
+	 * 0. Decode covariances (if stored in the codebook format).
 	 * 1. Measure distance to each splat (if GPU sort enabled).
 	 * 2. Sort splats by distance (if GPU sort enabled).
 	 * 3. Project splats (calculate 2x2 transform).
+	 * 4. Cull, clamp or fade oversized splats, thin splats in the outer rings
+	 * of the view, add view-dependent color from spherical harmonics, and
+	 * compensate the opacity of splats ordered by importance (if enabled).
 	 */
 	virtual void PreRenderView_RenderThread(
 		FRDGBuilder& GraphBuilder, FSceneView& InView) override;
@@ -76,19 +92,56 @@ public:
 	}
 
 	/**
-	 * Stop rendering a splat.
+	 * Stop rendering a splat. Its CPU sorting buffers are returned to the pool.
 	 *
 	 * @param Proxy - The splat to stop rendering.
 	 */
 	void UnregisterSplat_RenderThread(FSplatSceneProxy* Proxy)
 	{
 		check(IsInRenderingThread());
+		check(Proxy);
+		Proxy->ReleaseSortingBuffers(SortingBufferPool);
 		Proxies.Remove(Proxy);
 	}
 
 private:
-	bool bIsSortingOnGPU;
+	/**
+	 * Sizes the decoded covariance buffer for the largest registered proxy
+	 * using the codebook format, or releases it if there are none.
+	 *
+	 * @param RHICmdList - The RHI command list to create resources with.
+	 */
+	void UpdateDecodedCovariances(FRHICommandListBase& RHICmdList);
+
+	/**
+	 * Updates the splat budget, and shares it between visible proxies by how
+	 * much of the screen each covers.
+	 *
+	 * Proxies ordered by importance draw a prefix falling with their distance
+	 * from the view, shortened to their share of the budget. Others draw
+	 * coarser levels of detail, or cull more small splats, in proportion to
+	 * how far their share falls short.
+	 *
+	 * @param View - View splats are drawn in.
+	 * @param VisibleProxies - Proxies visible in the view.
+	 */
+	void ApplySplatBudget(
+		const FSceneView& View,
+		TConstArrayView<FSplatSceneProxy*> VisibleProxies);
+
 	TSet<FSplatSceneProxy*> Proxies;
+	FSortingController SortingController;
+	FSplatBudgetController BudgetController;
+	FSplatResidencyManager ResidencyManager;
+	FSplatFrameTimes FrameTimes;
+	uint32 LastMeasuredFrameNumber = MAX_uint32;
+	FSortingBufferPool SortingBufferPool;
+	FGPUCounterReadback OversizedCounter;
+
+	// Covariances of proxies using the codebook format are decoded into this
+	// in turn, so only one uncompressed copy is resident.
+	std::optional<FSplatGPUToGPUBuffer> DecodedCovariances;
+	uint32 DecodedCovariancesCapacity = 0;
 };
 
 } // namespace PICO::Splat
\ No newline at end of file
@@ -21,11 +21,21 @@ IMPLEMENT_GLOBAL_SHADER(
 	"/Plugin/PICOSplat/Private/ComputeDistanceCS.usf",
 	"main",
 	SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(
+	FDecodeCovariancesCS,
+	"/Plugin/PICOSplat/Private/DecodeCovariancesCS.usf",
+	"main",
+	SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(
 	FComputeTransformCS,
 	"/Plugin/PICOSplat/Private/ComputeTransformCS.usf",
 	"main",
 	SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(
+	FAdjustSplatsCS,
+	"/Plugin/PICOSplat/Private/AdjustSplatsCS.usf",
+	"main",
+	SF_Compute);
 IMPLEMENT_TEMPLATED_GLOBAL_SHADER(
 	FRenderSplatVS<ESortingDevice::CPU>,
 	"/Plugin/PICOSplat/Private/RenderSplatVS.usf",
@@ -11,6 +11,8 @@
 #include "HLSLTypeAliases.h"
 #include "SceneView.h"
 #include "ShaderParameterStruct.h"
+#include "ShaderPermutation.h"
+#include "SplatConstants.h"
 
 namespace PICO::Splat::Shaders
 {
@@ -27,6 +29,26 @@ SHADER_PARAMETER(FVector3f, pos_scale_cm)
 SHADER_PARAMETER_SRV(Buffer<uint>, positions)
 END_SHADER_PARAMETER_STRUCT()
 
+// Vectors holding the range of each packed spherical harmonic coefficient.
+constexpr uint32 MAX_SH_VECTORS = GetSHStride(MaxSupportedSHDegree);
+
+BEGIN_SHADER_PARAMETER_STRUCT(FSHParameters, )
+SHADER_PARAMETER(FMatrix44f, local_to_sh)
+SHADER_PARAMETER(FVector3f, view_origin_local_cm)
+SHADER_PARAMETER(uint32, sh_stride)
+SHADER_PARAMETER(uint32, sh_indexed)
+SHADER_PARAMETER_ARRAY(FVector4f, sh_min, [MAX_SH_VECTORS])
+SHADER_PARAMETER_ARRAY(FVector4f, sh_scale, [MAX_SH_VECTORS])
+SHADER_PARAMETER_SRV(Buffer<uint>, sh_coefficients)
+SHADER_PARAMETER_SRV(Buffer<uint>, sh_indices)
+END_SHADER_PARAMETER_STRUCT()
+
+BEGIN_SHADER_PARAMETER_STRUCT(FLODParameters, )
+SHADER_PARAMETER(float, lod_scale)
+SHADER_PARAMETER(float, max_lod_error)
+SHADER_PARAMETER_SRV(Buffer<uint2>, lod_nodes)
+END_SHADER_PARAMETER_STRUCT()
+
 /**
  * Calculates distances to each splat, for GPU sorting.
  */
@@ -54,6 +76,33 @@ public:
 	}
 };
 
+/**
+ * Expands covariances stored in the codebook format into one per splat, for
+ * `FComputeTransformCS` and `FAdjustSplatsCS`.
+ */
+class FDecodeCovariancesCS final : public FGlobalShader
+{
+	DECLARE_GLOBAL_SHADER(FDecodeCovariancesCS);
+	SHADER_USE_PARAMETER_STRUCT(FDecodeCovariancesCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+	SHADER_PARAMETER(uint32, num_splats)
+	SHADER_PARAMETER_SRV(Buffer<uint2>, codebook)
+	SHADER_PARAMETER_SRV(Buffer<uint>, indices)
+	SHADER_PARAMETER_UAV(RWBuffer<uint2>, covariances)
+	END_SHADER_PARAMETER_STRUCT()
+
+public:
+	static void ModifyCompilationEnvironment(
+		const FGlobalShaderPermutationParameters& Parameters,
+		FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(
+			TEXT("THREAD_GROUP_SIZE_X"), THREAD_GROUP_SIZE_X);
+	}
+};
+
 /**
  * Calculates 2x2 transform for each splat.
  */
@@ -82,6 +131,76 @@ public:
 	}
 };
 
+/**
+ * Culls, clamps or fades splats with oversized projected footprints, thins
+ * splats in the outer rings of the view, adds view-dependent color from
+ * spherical harmonics, compensates the opacity of a prefix of splats ordered by
+ * importance, and culls splats outside the level of detail cut. Reads and
+ * modifies the output of `FComputeTransformCS`.
+ */
+class FAdjustSplatsCS final : public FGlobalShader
+{
+	DECLARE_GLOBAL_SHADER(FAdjustSplatsCS);
+	SHADER_USE_PARAMETER_STRUCT(FAdjustSplatsCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+	SHADER_PARAMETER(FMatrix44f, local_to_view)
+	SHADER_PARAMETER(float, focal_length)
+	SHADER_PARAMETER(float, max_radius_px)
+	SHADER_PARAMETER(uint32, cull)
+	SHADER_PARAMETER(uint32, num_splats)
+	SHADER_PARAMETER(float, eccentricity_scale)
+	SHADER_PARAMETER(FVector4f, ring_radii)
+	SHADER_PARAMETER(FVector4f, ring_densities)
+	SHADER_PARAMETER(float, importance_area)
+	SHADER_PARAMETER(float, radius_to_px)
+	SHADER_PARAMETER(float, min_radius_px)
+	SHADER_PARAMETER_SRV(Buffer<float>, radii)
+	SHADER_PARAMETER(float, prefix_coverage)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FPackedPositionParameters, Positions)
+	SHADER_PARAMETER_SRV(Buffer<uint2>, covariances)
+	SHADER_PARAMETER_UAV(RWBuffer<float4>, transforms)
+	SHADER_PARAMETER_SRV(Buffer<float4>, colors)
+	SHADER_PARAMETER_UAV(RWBuffer<float4>, adjusted_colors)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FSHParameters, SH)
+	SHADER_PARAMETER_STRUCT_INCLUDE(FLODParameters, LOD)
+	SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<uint>, num_oversized)
+	END_SHADER_PARAMETER_STRUCT()
+
+public:
+	// Fade writes a copy of the colors, rather than modifying transforms.
+	class FFadeDim : SHADER_PERMUTATION_BOOL("FADE");
+	// Foveate thins splats, and compensates in a copy of the colors.
+	class FFoveateDim : SHADER_PERMUTATION_BOOL("FOVEATE");
+	// Degree of spherical harmonics added to a copy of the colors, from 0 to
+	// `MaxSupportedSHDegree`.
+	class FSHDegreeDim : SHADER_PERMUTATION_RANGE_INT("SH_DEGREE", 0, 4);
+	// LOD culls splats outside the cut of the asset's level of detail
+	// hierarchy, when not culled by a CPU sort.
+	class FLODDim : SHADER_PERMUTATION_BOOL("LOD");
+	// Prefix compensates the opacity of a prefix of splats ordered by
+	// importance, in a copy of the colors.
+	class FPrefixDim : SHADER_PERMUTATION_BOOL("PREFIX");
+	using FPermutationDomain = TShaderPermutationDomain<
+		FFadeDim,
+		FFoveateDim,
+		FSHDegreeDim,
+		FLODDim,
+		FPrefixDim>;
+
+	static void ModifyCompilationEnvironment(
+		const FGlobalShaderPermutationParameters& Parameters,
+		FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(
+			TEXT("THREAD_GROUP_SIZE_X"), THREAD_GROUP_SIZE_X);
+		OutEnvironment.SetDefine(
+			TEXT("SPLAT_RADIUS_STD_DEVS"), SplatRadiusStdDevs);
+		OutEnvironment.SetDefine(TEXT("MAX_SH_VECTORS"), MAX_SH_VECTORS);
+	}
+};
+
 /**
  * For controlling shader parameters in RenderSplatVS.
  */
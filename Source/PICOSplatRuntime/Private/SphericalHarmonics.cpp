@@ -0,0 +1,247 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SphericalHarmonics.h"
+
+#if WITH_EDITOR
+#include "Async/ParallelFor.h"
+#include "KMeans.h"
+#include "Misc/AssertionMacros.h"
+
+namespace PICO::Splat
+{
+namespace
+{
+// Coefficients outside this many standard deviations of their mean are
+// clamped, so outliers do not coarsen the step of every other splat.
+constexpr float RANGE_STD_DEVS = 4.f;
+
+/**
+ * Finds the range each coefficient is quantized to.
+ *
+ * @param Values - Rows of coefficients.
+ * @param Dimension - Number of coefficients per row.
+ * @param Stride - Size of each packed row, in words.
+ * @param OutMin - Returns the minimum of each coefficient.
+ * @param OutScale - Returns the step of each coefficient.
+ */
+void FindRowRanges(
+	TConstArrayView<float> Values,
+	int32 Dimension,
+	int32 Stride,
+	TArray<float>& OutMin,
+	TArray<float>& OutScale)
+{
+	const int32 NumRows = Values.Num() / Dimension;
+
+	// Padding decodes to zero.
+	OutMin.Init(0.f, Stride * 4);
+	OutScale.Init(0.f, Stride * 4);
+	for (int32 Index = 0; Index < Dimension; ++Index)
+	{
+		double Sum = 0.0;
+		double SumSquared = 0.0;
+		float Lowest = TNumericLimits<float>::Max();
+		float Highest = TNumericLimits<float>::Lowest();
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			const float Value = Values[Row * Dimension + Index];
+			Sum += Value;
+			SumSquared += double(Value) * Value;
+			Lowest = FMath::Min(Lowest, Value);
+			Highest = FMath::Max(Highest, Value);
+		}
+
+		const double Mean = Sum / NumRows;
+		const double StdDev =
+			FMath::Sqrt(FMath::Max(SumSquared / NumRows - Mean * Mean, 0.0));
+		const float Min =
+			FMath::Max(Lowest, float(Mean - RANGE_STD_DEVS * StdDev));
+		const float Max =
+			FMath::Min(Highest, float(Mean + RANGE_STD_DEVS * StdDev));
+		OutMin[Index] = Min;
+		OutScale[Index] = (Max - Min) / 255.f;
+	}
+}
+
+/**
+ * Packs rows of coefficients to 8 bits each.
+ *
+ * @param Values - Rows of coefficients.
+ * @param Dimension - Number of coefficients per row.
+ * @param Stride - Size of each packed row, in words.
+ * @param Min - Minimum of each coefficient.
+ * @param Scale - Step of each coefficient.
+ * @param OutPacked - Returns the packed rows. *Must* be `Stride` words per
+ * row.
+ */
+void PackRows(
+	TConstArrayView<float> Values,
+	int32 Dimension,
+	int32 Stride,
+	TConstArrayView<float> Min,
+	TConstArrayView<float> Scale,
+	TArrayView<uint32> OutPacked)
+{
+	const int32 NumRows = Values.Num() / Dimension;
+	check(OutPacked.Num() == NumRows * Stride);
+	FMemory::Memzero(OutPacked.GetData(), OutPacked.NumBytes());
+	ParallelFor(
+		NumRows,
+		[&](int32 Row)
+		{
+			for (int32 Index = 0; Index < Dimension; ++Index)
+			{
+				const float Value = Values[Row * Dimension + Index];
+				const uint32 Quantized =
+					Scale[Index] > 0.f
+						? uint32(FMath::Clamp(
+							  FMath::RoundToInt(
+								  (Value - Min[Index]) / Scale[Index]),
+							  0,
+							  255))
+						: 0;
+				OutPacked[Row * Stride + Index / 4] |= Quantized
+				                                       << (8 * (Index % 4));
+			}
+		});
+}
+
+/**
+ * @param Packed - Packed rows.
+ * @param Stride - Size of each packed row, in words.
+ * @param Min - Minimum of each coefficient.
+ * @param Scale - Step of each coefficient.
+ * @param Row - Row to read.
+ * @param Index - Coefficient to read.
+ * @return The unpacked coefficient.
+ */
+float Unpack(
+	TConstArrayView<uint32> Packed,
+	int32 Stride,
+	TConstArrayView<float> Min,
+	TConstArrayView<float> Scale,
+	int32 Row,
+	int32 Index)
+{
+	const uint32 Word = Packed[Row * Stride + Index / 4];
+	const uint32 Quantized = (Word >> (8 * (Index % 4))) & 0xFF;
+	return Min[Index] + Quantized * Scale[Index];
+}
+} // namespace
+
+FCompressedSH FCompressedSH::Build(
+	uint32 Degree,
+	TConstArrayView<float> Coefficients,
+	ESHFormat Format,
+	int32 MaxEntries)
+{
+	check(Degree >= 1 && Degree <= MaxSupportedSHDegree);
+	check(Format != ESHFormat::None);
+	const int32 Dimension = 3 * GetNumSHCoefficients(Degree);
+	const int32 Stride = GetSHStride(Degree);
+	check(Coefficients.Num() % Dimension == 0);
+	const int32 NumSplats = Coefficients.Num() / Dimension;
+
+	FCompressedSH Compressed;
+	TArray<int32> Assignments;
+	if (Format == ESHFormat::Codebook)
+	{
+		check(MaxEntries >= 1 && MaxEntries <= 1 << 16);
+
+		TArray<float> Centroids;
+		ClusterKMeans(
+			Coefficients, Dimension, MaxEntries, Centroids, Assignments);
+		FindRowRanges(
+			Centroids, Dimension, Stride, Compressed.Min, Compressed.Scale);
+		Compressed.Coefficients.SetNumUninitialized(
+			Centroids.Num() / Dimension * Stride);
+		PackRows(
+			Centroids,
+			Dimension,
+			Stride,
+			Compressed.Min,
+			Compressed.Scale,
+			Compressed.Coefficients);
+
+		Compressed.Indices.SetNumUninitialized(NumSplats);
+		for (int32 Index = 0; Index < NumSplats; ++Index)
+		{
+			Compressed.Indices[Index] = uint16(Assignments[Index]);
+		}
+	}
+	else
+	{
+		FindRowRanges(
+			Coefficients,
+			Dimension,
+			Stride,
+			Compressed.Min,
+			Compressed.Scale);
+		Compressed.Coefficients.SetNumUninitialized(NumSplats * Stride);
+		PackRows(
+			Coefficients,
+			Dimension,
+			Stride,
+			Compressed.Min,
+			Compressed.Scale,
+			Compressed.Coefficients);
+	}
+
+	// Measure error against each splat's own coefficients.
+	double ErrorSquaredSum = 0.0;
+	for (int32 Splat = 0; Splat < NumSplats; ++Splat)
+	{
+		const int32 Row = Assignments.IsEmpty() ? Splat : Assignments[Splat];
+		for (int32 Index = 0; Index < Dimension; ++Index)
+		{
+			const float Decoded = Unpack(
+				Compressed.Coefficients,
+				Stride,
+				Compressed.Min,
+				Compressed.Scale,
+				Row,
+				Index);
+			ErrorSquaredSum += FMath::Square(
+				double(Decoded) - Coefficients[Splat * Dimension + Index]);
+		}
+	}
+	Compressed.RMSError =
+		NumSplats > 0 ? float(FMath::Sqrt(
+							ErrorSquaredSum / (double(NumSplats) * Dimension)))
+					  : 0.f;
+
+	return Compressed;
+}
+
+void FCompressedSH::FindRanges(
+	uint32 Degree,
+	TConstArrayView<float> Sample,
+	TArray<float>& OutMin,
+	TArray<float>& OutScale)
+{
+	check(Degree >= 1 && Degree <= MaxSupportedSHDegree);
+	const int32 Dimension = 3 * GetNumSHCoefficients(Degree);
+	check(Sample.Num() > 0 && Sample.Num() % Dimension == 0);
+
+	FindRowRanges(Sample, Dimension, GetSHStride(Degree), OutMin, OutScale);
+}
+
+void FCompressedSH::Pack(
+	uint32 Degree,
+	TConstArrayView<float> Coefficients,
+	TConstArrayView<float> Min,
+	TConstArrayView<float> Scale,
+	TArrayView<uint32> OutPacked)
+{
+	check(Degree >= 1 && Degree <= MaxSupportedSHDegree);
+	const int32 Dimension = 3 * GetNumSHCoefficients(Degree);
+	check(Coefficients.Num() % Dimension == 0);
+
+	PackRows(
+		Coefficients, Dimension, GetSHStride(Degree), Min, Scale, OutPacked);
+}
+
+} // namespace PICO::Splat
+#endif
@@ -0,0 +1,85 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "SplatConstants.h"
+#include "SplatSettings.h"
+
+#if WITH_EDITOR
+namespace PICO::Splat
+{
+
+/**
+ * Spherical harmonics, range-quantized to 8 bits per coefficient, either per
+ * splat or in a shared codebook with a 16-bit index per splat.
+ */
+struct FCompressedSH
+{
+	// Minimum and step of each quantized coefficient, `GetSHStride() * 4` each.
+	TArray<float> Min;
+	TArray<float> Scale;
+	// Packed coefficients, `GetSHStride()` words per splat or codebook entry.
+	TArray<uint32> Coefficients;
+	// With the codebook format, the entry of each splat. Otherwise empty.
+	TArray<uint16> Indices;
+	// Root-mean-square error of each coefficient, after decompression.
+	float RMSError = 0.f;
+
+	/**
+	 * Compresses spherical harmonics.
+	 *
+	 * @param Degree - Degree of the spherical harmonics, in [1, 3].
+	 * @param Coefficients - `3 * GetNumSHCoefficients(Degree)` coefficients per
+	 * splat, ordered by coefficient then channel.
+	 * @param Format - Format to compress to. *Must not* be none.
+	 * @param MaxEntries - With the codebook format, the largest number of
+	 * entries, in [1, 65536].
+	 * @return The compressed spherical harmonics.
+	 */
+	static FCompressedSH Build(
+		uint32 Degree,
+		TConstArrayView<float> Coefficients,
+		ESHFormat Format,
+		int32 MaxEntries);
+
+	/**
+	 * Finds the range each coefficient is quantized to, with the per-splat
+	 * format, from a sample of splats. For spherical harmonics too many to
+	 * compress at once, which are then packed a window at a time.
+	 *
+	 * @param Degree - Degree of the spherical harmonics, in [1, 3].
+	 * @param Sample - Coefficients of the sampled splats, as in `Build`.
+	 * @param OutMin - Returns the minimum of each coefficient.
+	 * @param OutScale - Returns the step of each coefficient.
+	 */
+	static void FindRanges(
+		uint32 Degree,
+		TConstArrayView<float> Sample,
+		TArray<float>& OutMin,
+		TArray<float>& OutScale);
+
+	/**
+	 * Packs a window of splats with the per-splat format, to ranges from
+	 * `FindRanges`.
+	 *
+	 * @param Degree - Degree of the spherical harmonics, in [1, 3].
+	 * @param Coefficients - Coefficients of each splat, as in `Build`.
+	 * @param Min - Minimum of each coefficient.
+	 * @param Scale - Step of each coefficient.
+	 * @param OutPacked - Returns the packed coefficients, `GetSHStride()`
+	 * words per splat.
+	 */
+	static void Pack(
+		uint32 Degree,
+		TConstArrayView<float> Coefficients,
+		TConstArrayView<float> Min,
+		TConstArrayView<float> Scale,
+		TArrayView<uint32> OutPacked);
+};
+
+} // namespace PICO::Splat
+#endif
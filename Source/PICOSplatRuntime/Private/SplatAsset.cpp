@@ -3,16 +3,238 @@
 */
 
 #include "SplatAsset.h"
+#include "CovarianceCodebook.h"
+#include "SphericalHarmonics.h"
 #include "SplatConstants.h"
+#include "SplatCustomVersion.h"
 #include "SplatSettings.h"
 
+#include <algorithm>
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "RHIResources.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_EDITOR
+#include "DerivedDataCacheInterface.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Misc/ConfigCacheIni.h"
+#endif
 
+using PICO::Splat::FCompressedSH;
+using PICO::Splat::FCovarianceCodebook;
 using PICO::Splat::FPackedCovMat;
+using PICO::Splat::FPackedLODNode;
 using PICO::Splat::FPackedPos;
+using PICO::Splat::FSplatCustomVersion;
+using PICO::Splat::GetNumSHCoefficients;
+using PICO::Splat::MaxSupportedSHDegree;
 using PICO::Splat::MetersToCentimeters;
 using PICO::Splat::TSplatStaticBuffer;
 
+// Change to invalidate derived data, when how it is built changes.
+#define SPLAT_DERIVEDDATA_VER TEXT("6B1F3C2A9D8E4F71A5C0E2D4B7F91836")
+
+namespace
+{
+// Smallest number of splats per task, when preparing loaded assets.
+constexpr int32 PREPARE_BATCH_SIZE = 16 * 1024;
+
+/**
+ * @param Ar - Archive an asset is being saved to.
+ * @return Whether it is cooked for a platform which only sorts on GPU, so data
+ * only used when sorting on CPU can be left out.
+ */
+bool ShouldStripCPUData(const FArchive& Ar)
+{
+#if WITH_EDITOR
+	const ITargetPlatform* Platform = Ar.CookingTarget();
+	if (!Platform)
+	{
+		return false;
+	}
+	FConfigCacheIni* Config =
+		FConfigCacheIni::ForPlatform(FName(Platform->IniPlatformName()));
+	return Config && USplatSettings::IsSortingOnGPU(Config);
+#else
+	return false;
+#endif
+}
+
+/**
+ * Copies a stream of splat data into bulk data to be saved, uncompressed, or
+ * out of loaded bulk data, which is then released.
+ *
+ * @param BulkData - Bulk data holding the stream.
+ * @param bSaving - Whether to copy into bulk data, rather than out of it.
+ * @param Serialize - Saves or loads the stream with a given archive.
+ */
+template <typename FSerializeFn>
+void SerializeStream(
+	FByteBulkData& BulkData, bool bSaving, FSerializeFn&& Serialize)
+{
+	if (bSaving)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes, true);
+		Serialize(Writer);
+
+		BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(
+			BulkData.Realloc(Bytes.Num()), Bytes.GetData(), Bytes.Num());
+		BulkData.Unlock();
+		BulkData.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+	}
+	else
+	{
+		// Loads the payload now, if it was not loaded with the export.
+		const int64 Size = BulkData.GetBulkDataSize();
+		const void* Payload = BulkData.LockReadOnly();
+		FMemoryReaderView Reader(FMemoryView(Payload, Size), true);
+		Serialize(Reader);
+		BulkData.Unlock();
+		BulkData.RemoveBulkData();
+	}
+}
+
+/**
+ * Copies a GPU buffer, as is, into bulk data to be saved, to be memory-mapped
+ * when loaded. Or, creates the buffer over loaded bulk data.
+ *
+ * @param BulkData - Bulk data holding the buffer.
+ * @param bSaving - Whether to copy into bulk data, rather than out of it.
+ * @param Buffer - The buffer. *Must* be set when saving, and not when loading.
+ * @param bKeepPayload - Whether a loaded buffer keeps its payload once
+ * uploaded, so it can be uploaded again.
+ */
+template <typename T>
+void SerializeMapped(
+	FByteBulkData& BulkData,
+	bool bSaving,
+	std::optional<TSplatStaticBuffer<T>>& Buffer,
+	bool bKeepPayload = false)
+{
+	if (bSaving)
+	{
+		check(Buffer);
+		const TConstArrayView<T> Data = Buffer->GetData();
+
+		BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(
+			BulkData.Realloc(Data.NumBytes()), Data.GetData(), Data.NumBytes());
+		BulkData.Unlock();
+		// Mapped payloads are stored uncompressed, and aligned by IoStore.
+		BulkData.SetBulkDataFlags(
+			BULKDATA_Force_NOT_InlinePayload | BULKDATA_MemoryMappedPayload);
+		BulkData.StoreCompressedOnDisk(NAME_None);
+	}
+	else
+	{
+		check(!Buffer);
+		Buffer = TSplatStaticBuffer<T>(
+			std::make_unique<PICO::Splat::FSplatMappedResourceArray>(
+				BulkData, bKeepPayload));
+	}
+}
+
+#if WITH_EDITOR
+/**
+ * Builds a covariance matrix, as Σ = Rᵀ S² R with row vectors. Only the 3x3
+ * rotation is built, and each row of Σ is a sum of rows of R, rather than a
+ * product of 4x4 matrices.
+ *
+ * @param Rotation - Rotation of the splat.
+ * @param ScaleCM - Scale of the splat, in centimeters.
+ * @return The covariance matrix, in the upper-left 3x3 of a 4x4 matrix.
+ */
+FMatrix44f MakeCovariance(const FQuat4f& Rotation, const FVector3f& ScaleCM)
+{
+	// As in FQuatRotationTranslationMatrix.
+	const float X2 = Rotation.X + Rotation.X;
+	const float Y2 = Rotation.Y + Rotation.Y;
+	const float Z2 = Rotation.Z + Rotation.Z;
+	const float XX = Rotation.X * X2;
+	const float XY = Rotation.X * Y2;
+	const float XZ = Rotation.X * Z2;
+	const float YY = Rotation.Y * Y2;
+	const float YZ = Rotation.Y * Z2;
+	const float ZZ = Rotation.Z * Z2;
+	const float WX = Rotation.W * X2;
+	const float WY = Rotation.W * Y2;
+	const float WZ = Rotation.W * Z2;
+	const float R[3][3] = {
+		{1.f - (YY + ZZ), XY + WZ, XZ - WY},
+		{XY - WZ, 1.f - (XX + ZZ), YZ + WX},
+		{XZ + WY, YZ - WX, 1.f - (XX + YY)}};
+	const VectorRegister4Float Rows[3] = {
+		MakeVectorRegisterFloat(R[0][0], R[0][1], R[0][2], 0.f),
+		MakeVectorRegisterFloat(R[1][0], R[1][1], R[1][2], 0.f),
+		MakeVectorRegisterFloat(R[2][0], R[2][1], R[2][2], 0.f)};
+	const FVector3f Variances = ScaleCM * ScaleCM;
+
+	// Row i of Σ is the sum over k of R[k][i] s_k² times row k of R.
+	FMatrix44f Sigma = FMatrix44f::Identity;
+	for (int32 Row = 0; Row < 3; ++Row)
+	{
+		VectorRegister4Float Sum =
+			VectorMultiply(VectorSetFloat1(R[0][Row] * Variances.X), Rows[0]);
+		Sum = VectorMultiplyAdd(
+			VectorSetFloat1(R[1][Row] * Variances.Y), Rows[1], Sum);
+		Sum = VectorMultiplyAdd(
+			VectorSetFloat1(R[2][Row] * Variances.Z), Rows[2], Sum);
+		VectorStore(Sum, Sigma.M[Row]);
+	}
+	return Sigma;
+}
+
+/**
+ * Packs covariance matrices describing rotations and scales, and finds radii
+ * from the scales.
+ *
+ * @param Rotations - Rotation of each splat.
+ * @param ScalesMeters - Scale of each splat, in meters.
+ * @param OutPacked - Returns the packed matrices, in cm^2.
+ * @param OutRadiiCM - Returns the radius of each splat, in centimeters.
+ */
+void PackCovariances(
+	TConstArrayView<FQuat4f> Rotations,
+	TConstArrayView<FVector3f> ScalesMeters,
+	TArrayView<FPackedCovMat> OutPacked,
+	TArrayView<FFloat16> OutRadiiCM)
+{
+	check(ScalesMeters.Num() == Rotations.Num());
+	check(OutPacked.Num() == Rotations.Num());
+	check(OutRadiiCM.Num() == Rotations.Num());
+
+	// Matrices are built in chunks, in parallel, which are then packed
+	// together.
+	constexpr int32 CHUNK_SIZE = 256;
+	ParallelFor(
+		FMath::DivideAndRoundUp(OutPacked.Num(), CHUNK_SIZE),
+		[&](int32 Chunk)
+		{
+			FMatrix44f Sigmas[CHUNK_SIZE];
+			const int32 Begin = Chunk * CHUNK_SIZE;
+			const int32 Size = FMath::Min(CHUNK_SIZE, OutPacked.Num() - Begin);
+			for (int32 Offset = 0; Offset < Size; ++Offset)
+			{
+				const int32 Index = Begin + Offset;
+				const FVector3f ScaleCM =
+					MetersToCentimeters * ScalesMeters[Index];
+				Sigmas[Offset] = MakeCovariance(Rotations[Index], ScaleCM);
+				OutRadiiCM[Index] = ScaleCM.GetMax();
+			}
+
+			FPackedCovMat::PackArray(
+				TConstArrayView<FMatrix44f>(Sigmas, Size),
+				OutPacked.Mid(Begin, Size));
+		});
+}
+#endif
+} // namespace
+
 void USplatAsset::BeginDestroy()
 {
 	Super::BeginDestroy();
@@ -26,10 +248,34 @@ void USplatAsset::BeginDestroy()
 	{
 		BeginReleaseResource(&*CovariancesCM);
 	}
+	if (CovarianceCodebook)
+	{
+		BeginReleaseResource(&*CovarianceCodebook);
+	}
+	if (CovarianceIndices)
+	{
+		BeginReleaseResource(&*CovarianceIndices);
+	}
 	if (Colors)
 	{
 		BeginReleaseResource(&*Colors);
 	}
+	if (SHCoefficients)
+	{
+		BeginReleaseResource(&*SHCoefficients);
+	}
+	if (SHIndices)
+	{
+		BeginReleaseResource(&*SHIndices);
+	}
+	if (LODNodesBuffer)
+	{
+		BeginReleaseResource(&*LODNodesBuffer);
+	}
+	if (RadiiBuffer)
+	{
+		BeginReleaseResource(&*RadiiBuffer);
+	}
 
 	ReleaseResourcesFence.BeginFence();
 }
@@ -37,59 +283,696 @@ void USplatAsset::BeginDestroy()
 void USplatAsset::BeginInit()
 {
 	check(Positions);
-	check(CovariancesCM);
 	check(Colors);
 
 	FName Name = FName(GetPathName());
 
 	Positions->SetOwnerName(Name);
 	BeginInitResource(&*Positions);
-	CovariancesCM->SetOwnerName(Name);
-	BeginInitResource(&*CovariancesCM);
+	if (CovarianceFormat == ECovarianceFormat::Codebook16)
+	{
+		check(CovarianceCodebook);
+		check(CovarianceIndices);
+		CovarianceCodebook->SetOwnerName(Name);
+		BeginInitResource(&*CovarianceCodebook);
+		CovarianceIndices->SetOwnerName(Name);
+		BeginInitResource(&*CovarianceIndices);
+	}
+	else
+	{
+		check(CovariancesCM);
+		CovariancesCM->SetOwnerName(Name);
+		BeginInitResource(&*CovariancesCM);
+	}
 	Colors->SetOwnerName(Name);
 	BeginInitResource(&*Colors);
+	if (SHDegree > 0)
+	{
+		check(SHCoefficients);
+		SHCoefficients->SetOwnerName(Name);
+		BeginInitResource(&*SHCoefficients);
+		if (SHFormat == ESHFormat::Codebook)
+		{
+			check(SHIndices);
+			SHIndices->SetOwnerName(Name);
+			BeginInitResource(&*SHIndices);
+		}
+	}
+	if (LODNodesBuffer)
+	{
+		LODNodesBuffer->SetOwnerName(Name);
+		BeginInitResource(&*LODNodesBuffer);
+	}
+	// Imported assets set radii just before.
+	SetRadiiBuffer();
+	if (RadiiBuffer)
+	{
+		RadiiBuffer->SetOwnerName(Name);
+		BeginInitResource(&*RadiiBuffer);
+	}
+
+	bInitialized = true;
+	InitializedDelegate.Broadcast();
+}
+
+void USplatAsset::BeginPrepare()
+{
+	check(!PrepareTask.IsValid());
+	PrepareTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this] { Prepare(); });
+}
+
+void USplatAsset::Prepare()
+{
+	// Assets saved before bulk data was used are read in Serialize().
+	if (PositionsBulkData.GetBulkDataSize() > 0)
+	{
+		SerializeBulkData(false, bMappedBuffers);
+	}
+
+	// Cooked assets are loaded with derived data.
+	if (!Positions)
+	{
+		CacheDerivedData();
+	}
+
+	// Must happen before BeginInit(), which releases CPU color data.
+	SetOpacitiesFromColors();
+	SetPackedLODNodes();
+	// Must happen before PostLoad(), which may release CPU radii.
+	SetRadiiBuffer();
+}
+
+bool USplatAsset::IsReadyForAsyncPostLoad() const
+{
+	return !PrepareTask.IsValid() || PrepareTask.IsCompleted();
 }
 
 bool USplatAsset::IsReadyForFinishDestroy()
 {
-	return ReleaseResourcesFence.IsFenceComplete();
+	return IsReadyForAsyncPostLoad() &&
+	       ReleaseResourcesFence.IsFenceComplete() && IsPrefetchComplete();
 }
 
 void USplatAsset::PostLoad()
 {
 	Super::PostLoad();
 
-	SetPositionsMetersInternal(PositionsFullPrecision);
+	// Preparation starts once serialized and, when loading asynchronously,
+	// PostLoad() is deferred until it completes. When loading synchronously,
+	// the asset is initialized on the game thread once prepared, rather than
+	// waiting. Only the Editor waits, as its tools read loaded data at once.
+	if (!PrepareTask.IsValid())
+	{
+		BeginPrepare();
+	}
+	if (!GIsEditor && !PrepareTask.IsCompleted())
+	{
+		UE::Tasks::Launch(
+			UE_SOURCE_LOCATION,
+			[WeakThis = TWeakObjectPtr<USplatAsset>(this)]
+			{
+				AsyncTask(
+					ENamedThreads::GameThread,
+					[WeakThis]
+					{
+						if (USplatAsset* Asset = WeakThis.Get())
+						{
+							Asset->FinishPrepare();
+						}
+					});
+			},
+			UE::Tasks::Prerequisites(PrepareTask));
+		return;
+	}
+	PrepareTask.Wait();
+	FinishPrepare();
+}
+
+void USplatAsset::FinishPrepare()
+{
+	check(IsInGameThread());
+
+#if WITH_EDITORONLY_DATA
+	PositionStepCM = PosScaleCM.GetMax();
+#endif
 
 	// If we are in the Editor, we cannot erase the full-precision positions else
 	// we will save empty data in Serialize().
 #if !WITH_EDITOR
 	if (USplatSettings::IsSortingOnGPU())
 	{
+		// Radii are already copied for the GPU.
 		PositionsFullPrecision.Empty();
+		RadiiCM.Empty();
+		Opacities.Empty();
+		LODNodes.Empty();
 	}
 #endif
 
 	BeginInit();
 }
 
+void USplatAsset::PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext)
+{
+	Super::PostSaveRoot(ObjectSaveContext);
+
+	// The package, and so the payloads, have been written.
+	ReleaseSavedBulkData();
+}
+
+void USplatAsset::ReleaseSavedBulkData()
+{
+	for (FByteBulkData* BulkData :
+	     {&PositionsBulkData,
+	      &CovariancesBulkData,
+	      &ColorsBulkData,
+	      &SHBulkData,
+	      &ConvexHullBulkData,
+	      &LODBulkData,
+	      &MappedPositionsBulkData,
+	      &MappedCovariancesBulkData,
+	      &MappedCovarianceIndicesBulkData,
+	      &MappedColorsBulkData,
+	      &MappedSHCoefficientsBulkData,
+	      &MappedSHIndicesBulkData})
+	{
+		BulkData->RemoveBulkData();
+	}
+}
+
+uint64 USplatAsset::GetGPUMemorySize() const
+{
+	uint64 Size = 0;
+	auto AddSize = [&Size](const auto& Buffer)
+	{
+		if (Buffer)
+		{
+			Size += Buffer->GetSize();
+		}
+	};
+	AddSize(Positions);
+	AddSize(CovariancesCM);
+	AddSize(CovarianceCodebook);
+	AddSize(CovarianceIndices);
+	AddSize(Colors);
+	AddSize(SHCoefficients);
+	AddSize(SHIndices);
+	AddSize(LODNodesBuffer);
+	AddSize(RadiiBuffer);
+	return Size;
+}
+
+void USplatAsset::EvictGPUBuffers_RenderThread()
+{
+	check(IsInRenderingThread());
+	check(bEvictable);
+
+	if (!bGPUResident)
+	{
+		return;
+	}
+
+	TArray<PICO::Splat::FSplatBufferBase*, TInlineAllocator<8>> Buffers;
+	GetGPUBuffers(Buffers);
+	for (PICO::Splat::FSplatBufferBase* Buffer : Buffers)
+	{
+		Buffer->ReleaseResource();
+	}
+	bGPUResident = false;
+}
+
+void USplatAsset::BeginPrefetchGPUBuffers_RenderThread()
+{
+	check(IsInRenderingThread());
+
+	if (bGPUResident || !IsPrefetchComplete())
+	{
+		return;
+	}
+
+	TArray<PICO::Splat::FSplatBufferBase*, TInlineAllocator<8>> Buffers;
+	GetGPUBuffers(Buffers);
+	PrefetchTask = UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Buffers = MoveTemp(Buffers)]
+		{
+			for (const PICO::Splat::FSplatBufferBase* Buffer : Buffers)
+			{
+				Buffer->PrefetchData();
+			}
+		});
+}
+
+void USplatAsset::RestoreGPUBuffers_RenderThread(
+	FRHICommandListBase& RHICmdList)
+{
+	check(IsInRenderingThread());
+
+	if (bGPUResident)
+	{
+		return;
+	}
+
+	if (PrefetchTask.IsValid())
+	{
+		PrefetchTask.Wait();
+	}
+	TArray<PICO::Splat::FSplatBufferBase*, TInlineAllocator<8>> Buffers;
+	GetGPUBuffers(Buffers);
+	for (PICO::Splat::FSplatBufferBase* Buffer : Buffers)
+	{
+		Buffer->InitResource(RHICmdList);
+	}
+	bGPUResident = true;
+}
+
+float USplatAsset::GetPrefixCoverage(uint32 NumDrawn) const
+{
+	if (PrefixCoverage.IsEmpty() || NumDrawn >= NumSplats)
+	{
+		return 1.f;
+	}
+
+	// Interpolate between the prefixes sampled, starting from none, which
+	// covers nothing.
+	const float Sample = float(NumDrawn) / NumSplats * PrefixCoverage.Num();
+	const int32 Index = FMath::Min(
+		FMath::FloorToInt32(Sample), PrefixCoverage.Num() - 1);
+	const float Lower = Index > 0 ? PrefixCoverage[Index - 1] : 0.f;
+	const float Coverage =
+		FMath::Lerp(Lower, PrefixCoverage[Index], Sample - Index);
+	return FMath::Clamp(Coverage, UE_KINDA_SMALL_NUMBER, 1.f);
+}
+
 void USplatAsset::Serialize(FArchive& Ar)
 {
 	Super::Serialize(Ar);
 
+	Ar.UsingCustomVersion(FSplatCustomVersion::GUID);
+
 	Ar << NumSplats;
 
 	// We have to support the null case for `UObject::DeclareCustomVersions`,
 	// which serializes the default (empty) object. If not, our checks in
 	// TSplatStaticBuffer<T>::operator<< will trip.
-	if (NumSplats > 0)
+	if (NumSplats == 0)
+	{
+		return;
+	}
+
+	// Loaded assets are prepared in the background, until PostLoad().
+	const bool bPrepare =
+		Ar.IsLoading() && Ar.IsPersistent() && !PrepareTask.IsValid();
+
+	if (Ar.CustomVer(FSplatCustomVersion::GUID) <
+	    FSplatCustomVersion::MovedToBulkData)
+	{
+		SerializeInline(Ar);
+		if (bPrepare)
+		{
+			BeginPrepare();
+		}
+		return;
+	}
+
+	// Only what is needed to interpret the streams stays in the export.
+	Ar << CovarianceFormat << SHDegree;
+	if (SHDegree > 0)
+	{
+		Ar << SHFormat << SHMin << SHScale << LocalToSH;
+	}
+	if (Ar.CustomVer(FSplatCustomVersion::GUID) >=
+	    FSplatCustomVersion::AddedImportanceOrder)
+	{
+		Ar << PrefixCoverage;
+	}
+
+	// Only cooked data is memory-mapped, as it is in the target's format. The
+	// asset being cooked is left as is, so it is still saved unmapped.
+	bool bMapped = Ar.IsSaving() ? Ar.IsCooking() : bMappedBuffers;
+	if (Ar.CustomVer(FSplatCustomVersion::GUID) >=
+	    FSplatCustomVersion::AddedMappedBuffers)
+	{
+		Ar << bMapped;
+	}
+	if (Ar.IsLoading())
+	{
+		bMappedBuffers = bMapped;
+	}
+
+	if (Ar.CustomVer(FSplatCustomVersion::GUID) >=
+	    FSplatCustomVersion::AddedDerivedData)
+	{
+#if WITH_EDITORONLY_DATA
+		if (!Ar.IsFilterEditorOnly())
+		{
+			if (Ar.IsSaving() && Ar.IsPersistent())
+			{
+				SourceHash = ComputeSourceHash();
+			}
+			Ar << SourceHash;
+		}
+#endif
+		// Cooked assets are saved with derived data, so need not build it.
+		if (bMapped)
+		{
+			Ar << PosMinCM << PosMaxCM << PosScaleCM;
+		}
+	}
+
+	// Streams are read in PostLoad(), so their payloads need not be loaded
+	// with the export. They are not copied for undo, as they are not edited
+	// in place, and only compressed when saved to disk.
+	const bool bSaveStreams = Ar.IsSaving() && !Ar.IsTransacting();
+	if (bSaveStreams)
+	{
+		SerializeBulkData(true, bMapped, ShouldStripCPUData(Ar));
+
+		const FName Format =
+			Ar.IsPersistent() && USplatSettings::ShouldCompressAssetData()
+				? NAME_Oodle
+				: NAME_None;
+		for (FByteBulkData* BulkData :
+		     {&PositionsBulkData,
+		      &CovariancesBulkData,
+		      &ColorsBulkData,
+		      &SHBulkData,
+		      &ConvexHullBulkData,
+		      &LODBulkData})
+		{
+			BulkData->StoreCompressedOnDisk(Format);
+		}
+	}
+	PositionsBulkData.Serialize(Ar, this);
+	CovariancesBulkData.Serialize(Ar, this);
+	if (bMapped)
+	{
+		if (Ar.CustomVer(FSplatCustomVersion::GUID) >=
+		    FSplatCustomVersion::AddedDerivedData)
+		{
+			MappedPositionsBulkData.Serialize(Ar, this);
+		}
+		MappedCovariancesBulkData.Serialize(Ar, this);
+		MappedCovarianceIndicesBulkData.Serialize(Ar, this);
+		MappedColorsBulkData.Serialize(Ar, this);
+		MappedSHCoefficientsBulkData.Serialize(Ar, this);
+		MappedSHIndicesBulkData.Serialize(Ar, this);
+	}
+	else
 	{
-		Ar << PositionsFullPrecision;
-		Ar << CovariancesCM << Colors;
-		Ar << ConvexHullVertices << ConvexHullIndices;
+		ColorsBulkData.Serialize(Ar, this);
+		if (SHDegree > 0)
+		{
+			SHBulkData.Serialize(Ar, this);
+		}
 	}
+	ConvexHullBulkData.Serialize(Ar, this);
+	if (Ar.CustomVer(FSplatCustomVersion::GUID) >=
+	    FSplatCustomVersion::AddedLOD)
+	{
+		LODBulkData.Serialize(Ar, this);
+	}
+
+	// Payloads are written with the export, unless saved to disk, which
+	// writes them after, so they are released in PostSaveRoot().
+	if (bSaveStreams && !Ar.IsPersistent())
+	{
+		ReleaseSavedBulkData();
+	}
+
+	if (bPrepare)
+	{
+		BeginPrepare();
+	}
+}
+
+void USplatAsset::SerializeInline(FArchive& Ar)
+{
+	check(Ar.IsLoading());
+
+	Ar << PositionsFullPrecision;
+
+	// Older assets only have one covariance per splat.
+	if (Ar.CustomVer(FSplatCustomVersion::GUID) >=
+	    FSplatCustomVersion::AddedCovarianceCodebook)
+	{
+		Ar << CovarianceFormat;
+	}
+	if (CovarianceFormat == ECovarianceFormat::Codebook16)
+	{
+		Ar << CovarianceCodebook << CovarianceIndices;
+	}
+	else
+	{
+		Ar << CovariancesCM;
+	}
+	Ar << Colors;
+	Ar << ConvexHullVertices << ConvexHullIndices;
+
+	// Older assets derive these in PostLoad().
+	if (Ar.CustomVer(FSplatCustomVersion::GUID) >=
+	    FSplatCustomVersion::AddedRadii)
+	{
+		Ar << RadiiCM;
+	}
+
+	// Older assets only have base colors.
+	if (Ar.CustomVer(FSplatCustomVersion::GUID) >=
+	    FSplatCustomVersion::AddedSphericalHarmonics)
+	{
+		Ar << SHDegree;
+		if (SHDegree > 0)
+		{
+			Ar << SHFormat << SHMin << SHScale << LocalToSH;
+			Ar << SHCoefficients;
+			if (SHFormat == ESHFormat::Codebook)
+			{
+				Ar << SHIndices;
+			}
+		}
+	}
+}
+
+void USplatAsset::SerializeBulkData(
+	bool bSaving, bool bMapped, bool bStripCPUData)
+{
+	// Data only used when sorting on CPU is stripped when cooking for GPU
+	// sorting, as cooked assets are saved with derived data. Radii are kept,
+	// as foveated thinning on the GPU reads them.
+	bStripCPUData = bStripCPUData && bSaving && bMapped;
+
+	SerializeStream(
+		PositionsBulkData,
+		bSaving,
+		[this, bStripCPUData](FArchive& Stream)
+		{
+			TArray<FVector3f> Stripped;
+			Stream << (bStripCPUData ? Stripped : PositionsFullPrecision);
+		});
+	SerializeStream(
+		CovariancesBulkData,
+		bSaving,
+		[this, bMapped](FArchive& Stream)
+		{
+			if (!bMapped)
+			{
+				if (CovarianceFormat == ECovarianceFormat::Codebook16)
+				{
+					Stream << CovarianceCodebook << CovarianceIndices;
+				}
+				else
+				{
+					Stream << CovariancesCM;
+				}
+			}
+			Stream << RadiiCM;
+		});
+
+	if (bMapped)
+	{
+		// While GPU residency is managed, loaded payloads are kept, so their
+		// buffers can be evicted and uploaded again. Only payloads the
+		// platform memory-mapped are, as their pages can be reclaimed while
+		// unused, whereas copies would stay resident. Positions are only
+		// mapped if cooked with derived data.
+		bool bKeep = !bSaving &&
+		             MappedPositionsBulkData.GetBulkDataSize() > 0 &&
+		             USplatSettings::GetResidencyBudget() > 0;
+		for (const FByteBulkData* BulkData :
+		     {&MappedPositionsBulkData,
+		      &MappedCovariancesBulkData,
+		      &MappedCovarianceIndicesBulkData,
+		      &MappedColorsBulkData,
+		      &MappedSHCoefficientsBulkData,
+		      &MappedSHIndicesBulkData})
+		{
+			bKeep &= BulkData->GetBulkDataSize() == 0 ||
+			         BulkData->IsDataMemoryMapped();
+		}
+		if (!bSaving)
+		{
+			bEvictable = bKeep;
+		}
+
+		// Empty if cooked before derived data was.
+		if (bSaving || MappedPositionsBulkData.GetBulkDataSize() > 0)
+		{
+			SerializeMapped(
+				MappedPositionsBulkData, bSaving, Positions, bKeep);
+		}
+		if (CovarianceFormat == ECovarianceFormat::Codebook16)
+		{
+			SerializeMapped(
+				MappedCovariancesBulkData, bSaving, CovarianceCodebook, bKeep);
+			SerializeMapped(
+				MappedCovarianceIndicesBulkData,
+				bSaving,
+				CovarianceIndices,
+				bKeep);
+		}
+		else
+		{
+			SerializeMapped(
+				MappedCovariancesBulkData, bSaving, CovariancesCM, bKeep);
+		}
+		SerializeMapped(MappedColorsBulkData, bSaving, Colors, bKeep);
+		if (SHDegree > 0)
+		{
+			SerializeMapped(
+				MappedSHCoefficientsBulkData, bSaving, SHCoefficients, bKeep);
+			if (SHFormat == ESHFormat::Codebook)
+			{
+				SerializeMapped(
+					MappedSHIndicesBulkData, bSaving, SHIndices, bKeep);
+			}
+		}
+	}
+	else
+	{
+		SerializeStream(
+			ColorsBulkData,
+			bSaving,
+			[this](FArchive& Stream) { Stream << Colors; });
+		if (SHDegree > 0)
+		{
+			SerializeStream(
+				SHBulkData,
+				bSaving,
+				[this](FArchive& Stream)
+				{
+					Stream << SHCoefficients;
+					if (SHFormat == ESHFormat::Codebook)
+					{
+						Stream << SHIndices;
+					}
+				});
+		}
+	}
+
+	SerializeStream(
+		ConvexHullBulkData,
+		bSaving,
+		[this](FArchive& Stream)
+		{ Stream << ConvexHullVertices << ConvexHullIndices; });
+
+	// Empty if saved before levels of detail were.
+	if (bSaving || LODBulkData.GetBulkDataSize() > 0)
+	{
+		SerializeStream(
+			LODBulkData,
+			bSaving,
+			[this](FArchive& Stream) { Stream << LODNodes; });
+	}
+}
+
+void USplatAsset::CacheDerivedData()
+{
+#if WITH_EDITOR
+	// Assets saved before source hashes were have none.
+	if (SourceHash == FSHAHash())
+	{
+		SourceHash = ComputeSourceHash();
+	}
+	// Keyed by the formats derived data is built in, as well as the source.
+	// It is never stripped, so the same data serves every platform.
+	const FString Key = FDerivedDataCacheInterface::BuildCacheKey(
+		TEXT("PICOSPLAT"),
+		SPLAT_DERIVEDDATA_VER,
+		*FString::Printf(
+			TEXT("%s_P%d_C%d"),
+			*SourceHash.ToString(),
+			int32(USplatSettings::GetPositionFormat()),
+			int32(CovarianceFormat)));
+
+	TArray<uint8> Bytes;
+	if (GetDerivedDataCacheRef().GetSynchronous(*Key, Bytes, GetPathName()))
+	{
+		FMemoryReader Reader(Bytes, true);
+		SerializeDerivedData(Reader);
+		if (!Reader.IsError())
+		{
+			return;
+		}
+
+		PICO_LOGW("Rebuilding corrupt derived data for %s.", *GetPathName());
+		Positions.reset();
+	}
+
+	BuildDerivedData();
+
+	Bytes.Reset();
+	FMemoryWriter Writer(Bytes, true);
+	SerializeDerivedData(Writer);
+	GetDerivedDataCacheRef().Put(*Key, Bytes, GetPathName());
+#else
+	BuildDerivedData();
+#endif
+}
+
+void USplatAsset::BuildDerivedData()
+{
+	SetPositionsMetersInternal(PositionsFullPrecision);
+
+	// Older assets derive these from covariances.
+	if (uint32(RadiiCM.Num()) != NumSplats)
+	{
+		SetRadiiFromCovariances();
+	}
+}
+
+void USplatAsset::SerializeDerivedData(FArchive& Ar)
+{
+	Ar << PosMinCM << PosMaxCM << PosScaleCM;
+	Ar << Positions;
+	Ar << RadiiCM;
 }
 
+#if WITH_EDITORONLY_DATA
+FSHAHash USplatAsset::ComputeSourceHash() const
+{
+	FSHA1 Sha;
+	Sha.Update(
+		reinterpret_cast<const uint8*>(PositionsFullPrecision.GetData()),
+		PositionsFullPrecision.NumBytes());
+	// Saved radii differ from those derived from covariances.
+	Sha.Update(
+		reinterpret_cast<const uint8*>(RadiiCM.GetData()), RadiiCM.NumBytes());
+	if (CovariancesCM)
+	{
+		const TConstArrayView<FPackedCovMat> Covariances =
+			CovariancesCM->GetData();
+		Sha.Update(
+			reinterpret_cast<const uint8*>(Covariances.GetData()),
+			Covariances.NumBytes());
+	}
+	Sha.Final();
+
+	FSHAHash Hash;
+	Sha.GetHash(Hash.Hash);
+	return Hash;
+}
+#endif
+
 #if WITH_EDITOR
 void USplatAsset::SetCovariancesQuatScaleMeters(
 	const TArray<FQuat4f>& Rotations, const TArray<FVector3f>& ScalesMeters)
@@ -97,23 +980,114 @@ void USplatAsset::SetCovariancesQuatScaleMeters(
 	check(Rotations.Num() == NumSplats);
 	check(ScalesMeters.Num() == NumSplats);
 
-	TStaticMeshVertexData<FPackedCovMat> Data;
-	Data.ResizeBuffer(NumSplats);
-	for (int32 Index = 0; Index < Data.Num(); ++Index)
+	if (USplatSettings::GetCovarianceFormat() == ECovarianceFormat::Codebook16)
 	{
-		FMatrix44f R = FRotationMatrix44f::Make(Rotations[Index]);
-		FMatrix44f S =
-			FScaleMatrix44f::Make(MetersToCentimeters * ScalesMeters[Index]);
-
-		// Σ = R * S * S * R^-1.
-		// Note: R^-1 = R^T.
-		reinterpret_cast<FPackedCovMat*>(Data.GetDataPointer())[Index] =
-			FPackedCovMat(R.GetTransposed() * S * S * R);
+		TArray<FVector3f> ScalesCM;
+		ScalesCM.SetNumUninitialized(NumSplats);
+		for (uint32 Index = 0; Index < NumSplats; ++Index)
+		{
+			ScalesCM[Index] = MetersToCentimeters * ScalesMeters[Index];
+		}
+		SetCovarianceCodebook(Rotations, ScalesCM);
+		return;
 	}
 
+	// Larger formats are not yet supported, so fall back to the smallest.
+	CovarianceFormat = ECovarianceFormat::Float10;
+
+	TStaticMeshVertexData<FPackedCovMat> Data;
+	Data.ResizeBuffer(NumSplats);
+	RadiiCM.SetNumUninitialized(NumSplats);
+	PackCovariances(
+		Rotations,
+		ScalesMeters,
+		TArrayView<FPackedCovMat>(
+			reinterpret_cast<FPackedCovMat*>(Data.GetDataPointer()),
+			NumSplats),
+		RadiiCM);
+
 	CovariancesCM = TSplatStaticBuffer(std::move(Data));
 }
 
+void USplatAsset::SetCovarianceCodebook(
+	TConstArrayView<FQuat4f> Rotations,
+	TConstArrayView<FVector3f> ScalesCM)
+{
+	FCovarianceCodebook Codebook = FCovarianceCodebook::Build(
+		Rotations, ScalesCM, USplatSettings::GetCovarianceCodebookSize());
+	check(uint32(Codebook.Indices.Num()) == NumSplats);
+
+	const int32 NumEntries = Codebook.Entries.Num();
+	const float BytesPerMB = 1024.f * 1024.f;
+	PICO_LOGL(
+		"Quantized %u covariances to %d codebook entries, with %.2f%% mean "
+		"and %.2f%% max error. Covariances use %.2f MB, down from %.2f MB.",
+		NumSplats,
+		NumEntries,
+		100.f * Codebook.MeanError,
+		100.f * Codebook.MaxError,
+		(NumEntries * sizeof(FPackedCovMat) + NumSplats * sizeof(uint16)) /
+			BytesPerMB,
+		NumSplats * sizeof(FPackedCovMat) / BytesPerMB);
+
+	TStaticMeshVertexData<FPackedCovMat> EntryData;
+	EntryData.Assign(Codebook.Entries);
+	TStaticMeshVertexData<uint16> IndexData;
+	IndexData.Assign(Codebook.Indices);
+
+	CovarianceFormat = ECovarianceFormat::Codebook16;
+	CovarianceCodebook = TSplatStaticBuffer(std::move(EntryData));
+	CovarianceIndices = TSplatStaticBuffer(std::move(IndexData));
+	RadiiCM = std::move(Codebook.RadiiCM);
+}
+
+void USplatAsset::SetSphericalHarmonics(
+	uint32 Degree,
+	TConstArrayView<float> Coefficients,
+	const FMatrix44f& InLocalToSH)
+{
+	check(Degree >= 1 && Degree <= MaxSupportedSHDegree);
+	const uint32 Dimension = 3 * GetNumSHCoefficients(Degree);
+	check(uint32(Coefficients.Num()) == NumSplats * Dimension);
+
+	const ESHFormat Format = USplatSettings::GetSHFormat();
+	check(Format != ESHFormat::None);
+	FCompressedSH Compressed = FCompressedSH::Build(
+		Degree, Coefficients, Format, USplatSettings::GetSHCodebookSize());
+
+	const float BytesPerMB = 1024.f * 1024.f;
+	const uint64 Bytes = Compressed.Coefficients.Num() * sizeof(uint32) +
+	                     Compressed.Indices.Num() * sizeof(uint16);
+	const uint64 BaselineBytes = uint64(NumSplats) * Dimension * sizeof(float);
+	PICO_LOGL(
+		"Compressed degree %u spherical harmonics of %u splats, with %.4f RMS "
+		"error. Spherical harmonics use %.2f MB (%.1f B per splat), down from "
+		"%.2f MB (%llu B per splat).",
+		Degree,
+		NumSplats,
+		Compressed.RMSError,
+		Bytes / BytesPerMB,
+		float(Bytes) / NumSplats,
+		BaselineBytes / BytesPerMB,
+		uint64(Dimension * sizeof(float)));
+
+	TStaticMeshVertexData<uint32> CoefficientData;
+	CoefficientData.Assign(Compressed.Coefficients);
+
+	SHDegree = Degree;
+	SHFormat = Format;
+	SHMin = std::move(Compressed.Min);
+	SHScale = std::move(Compressed.Scale);
+	LocalToSH = InLocalToSH;
+	SHCoefficients = TSplatStaticBuffer(std::move(CoefficientData));
+	if (Format == ESHFormat::Codebook)
+	{
+		TStaticMeshVertexData<uint16> IndexData;
+		IndexData.Assign(Compressed.Indices);
+		SHIndices = TSplatStaticBuffer(std::move(IndexData));
+	}
+}
+
 void USplatAsset::SetPositionsMeters(TArray<FVector3f>&& PositionsMeters)
 {
 	// Do not condition this on sorting implementation. This is executed within
@@ -122,9 +1096,269 @@ void USplatAsset::SetPositionsMeters(TArray<FVector3f>&& PositionsMeters)
 	PositionsFullPrecision = std::move(PositionsMeters);
 
 	SetPositionsMetersInternal(PositionsFullPrecision);
+	LogPositionPrecision();
+}
+
+void USplatAsset::BeginStreamedSplats(
+	uint32 InNumSplats,
+	uint32 Degree,
+	TConstArrayView<float> SHSample,
+	const FMatrix44f& InLocalToSH)
+{
+	check(Degree <= MaxSupportedSHDegree);
+	check(Degree == 0 || !SHSample.IsEmpty());
+
+	if (USplatSettings::GetCovarianceFormat() != ECovarianceFormat::Float10)
+	{
+		PICO_LOGW(
+			"Streamed imports store a covariance per splat, rather than in a "
+			"codebook.");
+	}
+	if (Degree > 0 && USplatSettings::GetSHFormat() != ESHFormat::Quantized)
+	{
+		PICO_LOGW(
+			"Streamed imports range-quantize spherical harmonics per splat, "
+			"rather than in a codebook.");
+	}
+
+	NumSplats = InNumSplats;
+	PositionsFullPrecision.SetNumUninitialized(NumSplats);
+	RadiiCM.SetNumUninitialized(NumSplats);
+	CovarianceFormat = ECovarianceFormat::Float10;
+	StreamedCovariances.ResizeBuffer(NumSplats);
+	StreamedColors.ResizeBuffer(NumSplats);
+
+	SHDegree = Degree;
+	SHFormat = Degree > 0 ? ESHFormat::Quantized : ESHFormat::None;
+	LocalToSH = InLocalToSH;
+	if (Degree > 0)
+	{
+		FCompressedSH::FindRanges(Degree, SHSample, SHMin, SHScale);
+		StreamedSHCoefficients.ResizeBuffer(
+			NumSplats * PICO::Splat::GetSHStride(Degree));
+	}
+}
+
+void USplatAsset::AddStreamedSplats(
+	uint32 First,
+	TConstArrayView<FVector3f> PositionsMeters,
+	TConstArrayView<FQuat4f> Rotations,
+	TConstArrayView<FVector3f> ScalesMeters,
+	TConstArrayView<FColor> ColorsLinear,
+	TConstArrayView<float> SHCoefficients)
+{
+	const int32 Num = PositionsMeters.Num();
+	check(uint64(First) + Num <= NumSplats);
+	check(ColorsLinear.Num() == Num);
+
+	FMemory::Memcpy(
+		&PositionsFullPrecision[First],
+		PositionsMeters.GetData(),
+		PositionsMeters.NumBytes());
+	FMemory::Memcpy(
+		reinterpret_cast<FColor*>(StreamedColors.GetDataPointer()) + First,
+		ColorsLinear.GetData(),
+		ColorsLinear.NumBytes());
+	PackCovariances(
+		Rotations,
+		ScalesMeters,
+		TArrayView<FPackedCovMat>(
+			reinterpret_cast<FPackedCovMat*>(
+				StreamedCovariances.GetDataPointer()) +
+				First,
+			Num),
+		TArrayView<FFloat16>(RadiiCM).Mid(First, Num));
+
+	if (SHDegree > 0)
+	{
+		const uint32 Stride = PICO::Splat::GetSHStride(SHDegree);
+		FCompressedSH::Pack(
+			SHDegree,
+			SHCoefficients,
+			SHMin,
+			SHScale,
+			TArrayView<uint32>(
+				reinterpret_cast<uint32*>(
+					StreamedSHCoefficients.GetDataPointer()) +
+					uint64(First) * Stride,
+				Num * Stride));
+	}
+}
+
+void USplatAsset::EndStreamedSplats()
+{
+	CovariancesCM = TSplatStaticBuffer(std::move(StreamedCovariances));
+	Colors = TSplatStaticBuffer(std::move(StreamedColors));
+	SetOpacitiesFromColors();
+	if (SHDegree > 0)
+	{
+		SHCoefficients = TSplatStaticBuffer(std::move(StreamedSHCoefficients));
+
+		const float BytesPerMB = 1024.f * 1024.f;
+		PICO_LOGL(
+			"Quantized degree %u spherical harmonics of %u splats, to ranges "
+			"from a sample. Spherical harmonics use %.2f MB.",
+			SHDegree,
+			NumSplats,
+			uint64(NumSplats) * PICO::Splat::GetSHStride(SHDegree) *
+				sizeof(uint32) / BytesPerMB);
+	}
+
+	SetPositionsMetersInternal(PositionsFullPrecision);
+	LogPositionPrecision();
+}
+
+void USplatAsset::LogPositionPrecision()
+{
+	// Steps coarser than this visibly misplace splats up close.
+	constexpr float MAX_STEP_CM = 1.f;
+	// Fraction of splats, at each end of each axis, treated as outliers.
+	constexpr float OUTLIER_FRACTION = 0.005f;
+
+	const float StepCM = PosScaleCM.GetMax();
+	PositionStepCM = StepCM;
+	if (StepCM <= MAX_STEP_CM)
+	{
+		PICO_LOGL("Positions are quantized in steps of %.2f cm.", StepCM);
+		return;
+	}
+
+	// Find the step without outliers, as a few distant splats (e.g. floaters
+	// or a skybox) often stretch the bounds of a whole scan.
+	const int32 NumOutliers = int32(OUTLIER_FRACTION * NumSplats);
+	FVector3f InnerStepCM;
+	TArray<float> Coordinates;
+	Coordinates.SetNumUninitialized(NumSplats);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		for (uint32 Index = 0; Index < NumSplats; ++Index)
+		{
+			Coordinates[Index] = PositionsFullPrecision[Index][Axis];
+		}
+		float* Begin = Coordinates.GetData();
+		float* End = Begin + Coordinates.Num();
+		std::nth_element(Begin, Begin + NumOutliers, End);
+		const float Low = Begin[NumOutliers];
+		std::nth_element(Begin, End - 1 - NumOutliers, End);
+		const float High = End[-1 - NumOutliers];
+		InnerStepCM[Axis] =
+			MetersToCentimeters * (High - Low) / FPackedPos::MAX[Axis];
+	}
+
+	PICO_LOGW(
+		"Positions are quantized in steps of up to %.2f cm, as splats span "
+		"(%.1f, %.1f, %.1f) m. Without the outermost %.1f%% of splats on "
+		"each axis, steps would be %.2f cm. Consider cropping outliers, or "
+		"setting Max Position Step to split the scan into chunks.",
+		StepCM,
+		(PosMaxCM.X - PosMinCM.X) / MetersToCentimeters,
+		(PosMaxCM.Y - PosMinCM.Y) / MetersToCentimeters,
+		(PosMaxCM.Z - PosMinCM.Z) / MetersToCentimeters,
+		100.f * OUTLIER_FRACTION,
+		InnerStepCM.GetMax());
 }
 #endif
 
+void USplatAsset::SetRadiiFromCovariances()
+{
+	check(CovariancesCM);
+
+	TConstArrayView<FPackedCovMat> Covariances = CovariancesCM->GetData();
+	check(uint32(Covariances.Num()) == NumSplats);
+
+	// The largest eigenvalue of Σ is at most its trace.
+	RadiiCM.SetNumUninitialized(NumSplats);
+	ParallelFor(
+		TEXT("SplatRadii"),
+		int32(NumSplats),
+		PREPARE_BATCH_SIZE,
+		[this, Covariances](int32 Index)
+		{ RadiiCM[Index] = FMath::Sqrt(Covariances[Index].GetTrace()); });
+}
+
+void USplatAsset::SetOpacitiesFromColors()
+{
+	check(Colors);
+
+	TConstArrayView<FColor> ColorData = Colors->GetData();
+	check(uint32(ColorData.Num()) == NumSplats);
+
+	Opacities.SetNumUninitialized(NumSplats);
+	ParallelFor(
+		TEXT("SplatOpacities"),
+		int32(NumSplats),
+		PREPARE_BATCH_SIZE,
+		[this, ColorData](int32 Index)
+		{ Opacities[Index] = ColorData[Index].A; });
+}
+
+void USplatAsset::SetPackedLODNodes()
+{
+	if (LODNodes.IsEmpty())
+	{
+		return;
+	}
+	check(uint32(LODNodes.Num()) == NumSplats);
+
+	// Built when loaded, rather than mapped, so evictable assets keep a copy
+	// to upload again.
+	TStaticMeshVertexData<FPackedLODNode> Data{
+		/*InNeedsCPUAccess=*/bEvictable};
+	Data.ResizeBuffer(NumSplats);
+	FPackedLODNode* Packed =
+		reinterpret_cast<FPackedLODNode*>(Data.GetDataPointer());
+	ParallelFor(
+		TEXT("SplatLODNodes"),
+		int32(NumSplats),
+		PREPARE_BATCH_SIZE,
+		[this, Packed](int32 Index)
+		{ Packed[Index] = LODNodes[Index].Pack(); });
+	LODNodesBuffer = TSplatStaticBuffer(std::move(Data));
+
+	// Nodes are stored in pre-order, so leaves are those whose subtree ends
+	// right after them.
+	NumLODLeaves = 0;
+	for (uint32 Index = 0; Index < NumSplats; ++Index)
+	{
+		NumLODLeaves += LODNodes[Index].SubtreeEnd == Index + 1 ? 1 : 0;
+	}
+}
+
+void USplatAsset::SetRadiiBuffer()
+{
+	if (RadiiBuffer || uint32(RadiiCM.Num()) != NumSplats)
+	{
+		return;
+	}
+
+	// Kept on the CPU as well, so evictable assets can upload it again.
+	TStaticMeshVertexData<FFloat16> Data{/*InNeedsCPUAccess=*/bEvictable};
+	Data.Assign(RadiiCM);
+	RadiiBuffer = TSplatStaticBuffer(std::move(Data));
+}
+
+void USplatAsset::GetGPUBuffers(
+	TArray<PICO::Splat::FSplatBufferBase*, TInlineAllocator<8>>& OutBuffers)
+{
+	OutBuffers.Reset();
+	auto AddBuffer = [&OutBuffers](auto& Buffer)
+	{
+		if (Buffer)
+		{
+			OutBuffers.Add(&*Buffer);
+		}
+	};
+	AddBuffer(Positions);
+	AddBuffer(CovariancesCM);
+	AddBuffer(CovarianceCodebook);
+	AddBuffer(CovarianceIndices);
+	AddBuffer(Colors);
+	AddBuffer(SHCoefficients);
+	AddBuffer(SHIndices);
+	AddBuffer(LODNodesBuffer);
+	AddBuffer(RadiiBuffer);
+}
+
 void USplatAsset::SetPositionsMetersInternal(
 	const TArray<FVector3f>& PositionsMeters)
 {
@@ -136,12 +1370,34 @@ void USplatAsset::SetPositionsMetersInternal(
 	 * describing a position between the min and max. This is more accurate
 	 * at low bit size representations than floating-point.
 	 */
+	const int32 NumBatches =
+		FMath::DivideAndRoundUp(PositionsMeters.Num(), PREPARE_BATCH_SIZE);
+	TArray<FVector3f> BatchMaxM;
+	BatchMaxM.Init(FVector3f(std::numeric_limits<float>::lowest()), NumBatches);
+	TArray<FVector3f> BatchMinM;
+	BatchMinM.Init(FVector3f(std::numeric_limits<float>::max()), NumBatches);
+	ParallelFor(
+		NumBatches,
+		[&](int32 Batch)
+		{
+			const int32 Begin = Batch * PREPARE_BATCH_SIZE;
+			const int32 End =
+				FMath::Min(Begin + PREPARE_BATCH_SIZE, PositionsMeters.Num());
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				BatchMaxM[Batch] =
+					BatchMaxM[Batch].ComponentMax(PositionsMeters[Index]);
+				BatchMinM[Batch] =
+					BatchMinM[Batch].ComponentMin(PositionsMeters[Index]);
+			}
+		});
+
 	FVector3f PosMaxM(std::numeric_limits<float>::lowest());
 	FVector3f PosMinM(std::numeric_limits<float>::max());
-	for (const FVector3f& PosM : PositionsMeters)
+	for (int32 Batch = 0; Batch < NumBatches; ++Batch)
 	{
-		PosMaxM = PosMaxM.ComponentMax(PosM);
-		PosMinM = PosMinM.ComponentMin(PosM);
+		PosMaxM = PosMaxM.ComponentMax(BatchMaxM[Batch]);
+		PosMinM = PosMinM.ComponentMin(BatchMinM[Batch]);
 	}
 	check(PosMaxM.GetMin() > std::numeric_limits<float>::lowest());
 	check(PosMinM.GetMax() < std::numeric_limits<float>::max());
@@ -152,10 +1408,21 @@ void USplatAsset::SetPositionsMetersInternal(
 
 	TStaticMeshVertexData<FPackedPos> Data{/*InNeedsCPUAccess=*/false};
 	Data.ResizeBuffer(NumSplats);
-	for (int32 Index = 0; Index < Data.Num(); ++Index)
-	{
-		reinterpret_cast<FPackedPos*>(Data.GetDataPointer())[Index] =
-			(PositionsMeters[Index] - PosMinM) / (PosMaxM - PosMinM);
-	}
+	TArrayView<FPackedPos> Packed(
+		reinterpret_cast<FPackedPos*>(Data.GetDataPointer()), NumSplats);
+	// Batches are a multiple of four positions, so pack bit-exactly.
+	ParallelFor(
+		NumBatches,
+		[&](int32 Batch)
+		{
+			const int32 Begin = Batch * PREPARE_BATCH_SIZE;
+			const int32 Size =
+				FMath::Min(PREPARE_BATCH_SIZE, PositionsMeters.Num() - Begin);
+			FPackedPos::PackArray(
+				TConstArrayView<FVector3f>(PositionsMeters).Mid(Begin, Size),
+				PosMinM,
+				PosMaxM,
+				Packed.Mid(Begin, Size));
+		});
 	Positions = TSplatStaticBuffer(std::move(Data));
 }
\ No newline at end of file
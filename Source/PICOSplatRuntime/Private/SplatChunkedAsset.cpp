@@ -0,0 +1,24 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatChunkedAsset.h"
+
+#include "Misc/AssertionMacros.h"
+
+#if WITH_EDITOR
+void USplatChunkedAsset::AddChunk(USplatAsset* Asset)
+{
+	check(Asset);
+
+	// The convex hull bounds every splat drawn, and is already in centimeters.
+	FSplatChunk& Chunk = Chunks.AddDefaulted_GetRef();
+	Chunk.Asset = Asset;
+	for (const FVector3f& Vertex : Asset->GetConvexHullVertices())
+	{
+		Chunk.Bounds += FVector(Vertex);
+	}
+	Chunk.GPUMemorySize = int64(Asset->GetGPUMemorySize());
+	Bounds += Chunk.Bounds;
+}
+#endif
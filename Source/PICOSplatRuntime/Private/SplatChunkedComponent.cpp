@@ -0,0 +1,151 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatChunkedComponent.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "Logging.h"
+#include "Misc/AssertionMacros.h"
+#include "SplatStreamingSubsystem.h"
+
+USplatChunkedComponent::USplatChunkedComponent()
+{
+	// Chunks collide and are selected by their own components.
+	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	SetGenerateOverlapEvents(false);
+}
+
+void USplatChunkedComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	const int32 NumChunks = Asset ? Asset->GetChunks().Num() : 0;
+	ChunkComponents.SetNum(NumChunks);
+	Handles.SetNum(NumChunks);
+
+	UWorld* World = GetWorld();
+	if (Asset && World)
+	{
+		if (USplatStreamingSubsystem* Subsystem =
+		        World->GetSubsystem<USplatStreamingSubsystem>())
+		{
+			Subsystem->RegisterComponent(this);
+		}
+	}
+}
+
+void USplatChunkedComponent::OnUnregister()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (USplatStreamingSubsystem* Subsystem =
+		        World->GetSubsystem<USplatStreamingSubsystem>())
+		{
+			Subsystem->UnregisterComponent(this);
+		}
+	}
+	for (int32 Index = 0; Index < Handles.Num(); ++Index)
+	{
+		ReleaseChunk(Index);
+	}
+	ChunkComponents.Reset();
+	Handles.Reset();
+
+	Super::OnUnregister();
+}
+
+FBoxSphereBounds
+USplatChunkedComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	if (Asset && Asset->GetBounds().IsValid)
+	{
+		return FBoxSphereBounds(Asset->GetBounds()).TransformBy(LocalToWorld);
+	}
+	else
+	{
+		return FBoxSphereBounds(
+			LocalToWorld.GetLocation(), FVector::ZeroVector, 0.f);
+	}
+}
+
+bool USplatChunkedComponent::IsChunkRequested(int32 Index) const
+{
+	return Handles.IsValidIndex(Index) && Handles[Index].IsValid();
+}
+
+bool USplatChunkedComponent::IsChunkLoading(int32 Index) const
+{
+	return IsChunkRequested(Index) && Handles[Index]->IsLoadingInProgress();
+}
+
+void USplatChunkedComponent::RequestChunk(int32 Index)
+{
+	check(Asset);
+	check(Handles.IsValidIndex(Index));
+
+	if (Handles[Index])
+	{
+		return;
+	}
+
+	// Chunks already in memory may complete within this call.
+	Handles[Index] = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		Asset->GetChunks()[Index].Asset.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(
+			this, &USplatChunkedComponent::OnChunkLoaded, Index));
+	if (!Handles[Index])
+	{
+		PICO_LOGE(
+			"Failed to request chunk %d of %s.", Index, *Asset->GetName());
+	}
+}
+
+void USplatChunkedComponent::ReleaseChunk(int32 Index)
+{
+	check(Handles.IsValidIndex(Index));
+
+	if (USplatComponent* Component = ChunkComponents[Index])
+	{
+		Component->DestroyComponent();
+		ChunkComponents[Index] = nullptr;
+	}
+	if (TSharedPtr<FStreamableHandle> Handle = MoveTemp(Handles[Index]))
+	{
+		// Loads still in progress are cancelled, so never call back.
+		if (Handle->IsLoadingInProgress())
+		{
+			Handle->CancelHandle();
+		}
+		else
+		{
+			Handle->ReleaseHandle();
+		}
+	}
+}
+
+void USplatChunkedComponent::OnChunkLoaded(int32 Index)
+{
+	// Released, or unregistered, while loading.
+	if (!IsRegistered() || !ChunkComponents.IsValidIndex(Index) ||
+	    ChunkComponents[Index])
+	{
+		return;
+	}
+
+	USplatAsset* ChunkAsset = Asset->GetChunks()[Index].Asset.Get();
+	if (!ChunkAsset)
+	{
+		PICO_LOGE("Failed to load chunk %d of %s.", Index, *Asset->GetName());
+		return;
+	}
+
+	USplatComponent* Component =
+		NewObject<USplatComponent>(this, NAME_None, RF_Transient);
+	Component->SetAsset(ChunkAsset);
+	Component->SetupAttachment(this);
+	Component->RegisterComponent();
+	ChunkComponents[Index] = Component;
+}
@@ -17,12 +17,46 @@ using PICO::Splat::FSplatSceneProxy;
 FPrimitiveSceneProxy* USplatComponent::CreateSceneProxy()
 {
 	// Note: Unreal expects a new here, and will handle deletion itself.
-	return Asset ? new FSplatSceneProxy{*this} : nullptr;
+	return Asset && Asset->IsInitialized() ? new FSplatSceneProxy{*this}
+	                                       : nullptr;
+}
+
+void USplatComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// Assets still being prepared are drawn once initialized.
+	if (Asset && !Asset->IsInitialized())
+	{
+		Asset->OnInitialized().AddUObject(
+			this, &USplatComponent::OnAssetInitialized);
+		InitializingAsset = Asset;
+	}
+}
+
+void USplatComponent::OnUnregister()
+{
+	// The asset may have been changed since, e.g. in the Editor's details.
+	if (USplatAsset* Bound = InitializingAsset.Get())
+	{
+		Bound->OnInitialized().RemoveAll(this);
+	}
+	InitializingAsset.Reset();
+
+	Super::OnUnregister();
+}
+
+void USplatComponent::SetAsset(USplatAsset* InAsset)
+{
+	check(!IsRegistered());
+	Asset = InAsset;
+	BodySetup = nullptr;
 }
 
 UBodySetup* USplatComponent::GetBodySetup()
 {
-	if (!Asset)
+	// Assets still being prepared have no convex hull yet.
+	if (!Asset || (!BodySetup && !Asset->IsInitialized()))
 	{
 		return nullptr;
 	}
@@ -49,6 +83,14 @@ UBodySetup* USplatComponent::GetBodySetup()
 	return BodySetup;
 }
 
+void USplatComponent::OnAssetInitialized()
+{
+	GetBodySetup();
+	RecreatePhysicsState();
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
 #if WITH_EDITOR
 void USplatComponent::GetUsedMaterials(
 	TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials) const
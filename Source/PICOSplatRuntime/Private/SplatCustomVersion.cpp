@@ -0,0 +1,23 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatCustomVersion.h"
+
+#include "Serialization/CustomVersion.h"
+
+namespace PICO::Splat
+{
+
+const FGuid FSplatCustomVersion::GUID(
+	0x0402D3EB, 0x6AED4272, 0xBD291022, 0x1F757EEC);
+
+namespace
+{
+FCustomVersionRegistration GRegisterSplatCustomVersion(
+	FSplatCustomVersion::GUID,
+	FSplatCustomVersion::LatestVersion,
+	TEXT("PICOSplat"));
+} // namespace
+
+} // namespace PICO::Splat
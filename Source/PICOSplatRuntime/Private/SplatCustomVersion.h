@@ -0,0 +1,59 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Misc/Guid.h"
+
+namespace PICO::Splat
+{
+
+/**
+ * Versions of serialized splat assets. Assets saved before a version can still
+ * be loaded, with any missing data derived on load.
+ */
+struct FSplatCustomVersion
+{
+	enum Type
+	{
+		// Before any version changes were made.
+		BeforeCustomVersionWasAdded = 0,
+
+		// Added per-splat radii, for culling when sorting on CPU.
+		AddedRadii,
+
+		// Added covariance formats, and the codebook format.
+		AddedCovarianceCodebook,
+
+		// Added higher-order spherical harmonics.
+		AddedSphericalHarmonics,
+
+		// Moved splat data out of the export, into bulk data per stream.
+		MovedToBulkData,
+
+		// Added the cooked layout, with GPU buffers stored to be memory-mapped.
+		AddedMappedBuffers,
+
+		// Added the hash of source data, keying derived data, and cooked
+		// derived data.
+		AddedDerivedData,
+
+		// Added level of detail hierarchies.
+		AddedLOD,
+
+		// Added importance order, and the coverage of its prefixes.
+		AddedImportanceOrder,
+
+		// -----<new versions can be added above this line>-----
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// Unique ID for this custom version.
+	static const FGuid GUID;
+
+	FSplatCustomVersion() = delete;
+};
+
+} // namespace PICO::Splat
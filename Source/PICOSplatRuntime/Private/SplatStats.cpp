@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatStats.h"
+
+DEFINE_STAT(STAT_SplatCPUSortSlice);
+DEFINE_STAT(STAT_SplatCPUSortSlices);
+DEFINE_STAT(STAT_SplatCPUSortsCompleted);
+DEFINE_STAT(STAT_SplatCPUSortsPartial);
+DEFINE_STAT(STAT_SplatCPUSortBudget);
+DEFINE_STAT(STAT_SplatCPUSortsInFlight);
+DEFINE_STAT(STAT_SplatCPUSortCulledSubPixel);
+DEFINE_STAT(STAT_SplatCPUSortThinned);
+DEFINE_STAT(STAT_SplatCPUSortCoarsened);
+DEFINE_STAT(STAT_SplatImportanceSkipped);
+DEFINE_STAT(STAT_SplatOversized);
+DEFINE_STAT(STAT_SplatProxiesSortedOnCPU);
+DEFINE_STAT(STAT_SplatProxiesSortedOnGPU);
+DEFINE_STAT(STAT_SplatHybridGPUQuota);
+DEFINE_STAT(STAT_SplatBudget);
+DEFINE_STAT(STAT_SplatCPUSortMs);
+DEFINE_STAT(STAT_SplatGPUFrameMs);
+DEFINE_STAT(STAT_SplatRenderThreadMs);
+DEFINE_STAT(STAT_SplatSortingBuffersInUse);
+DEFINE_STAT(STAT_SplatSortingBuffersPooled);
+DEFINE_STAT(STAT_SplatSortingBufferMemory);
+DEFINE_STAT(STAT_SplatChunksResident);
+DEFINE_STAT(STAT_SplatChunksLoading);
+DEFINE_STAT(STAT_SplatChunkLoads);
+DEFINE_STAT(STAT_SplatChunkMemory);
+DEFINE_STAT(STAT_SplatAssetsResident);
+DEFINE_STAT(STAT_SplatAssetsEvicted);
+DEFINE_STAT(STAT_SplatResidentMemory);
+DEFINE_STAT(STAT_SplatEvictions);
+DEFINE_STAT(STAT_SplatReloads);
+DEFINE_STAT(STAT_SplatReloadLatencyMs);
@@ -0,0 +1,120 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+/**
+ * Stats for splat rendering. View in-game with `stat PICOSplat`.
+ *
+ * @see https://dev.epicgames.com/documentation/en-us/unreal-engine/stat-commands-in-unreal-engine
+ */
+DECLARE_STATS_GROUP(TEXT("PICO Splat"), STATGROUP_PICOSplat, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("CPU Sort Slice"), STAT_SplatCPUSortSlice, STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("CPU Sort Slices"), STAT_SplatCPUSortSlices, STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("CPU Sorts Completed"),
+	STAT_SplatCPUSortsCompleted,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("CPU Sorts Published Partially"),
+	STAT_SplatCPUSortsPartial,
+	STATGROUP_PICOSplat, );
+// Summed over every slice this frame, across proxies. Divide by the number of
+// slices for the average.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("CPU Sort Budget (Splats)"),
+	STAT_SplatCPUSortBudget,
+	STATGROUP_PICOSplat, );
+// Sorts left unfinished by a slice, to resume in a later frame.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("CPU Sorts In Flight"),
+	STAT_SplatCPUSortsInFlight,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("CPU Sort Culled (Sub-Pixel)"),
+	STAT_SplatCPUSortCulledSubPixel,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("CPU Sort Thinned (Foveated)"),
+	STAT_SplatCPUSortThinned,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("CPU Sort Skipped (LOD)"),
+	STAT_SplatCPUSortCoarsened,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Skipped (Importance)"),
+	STAT_SplatImportanceSkipped,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Oversized Splats (Delayed)"),
+	STAT_SplatOversized,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Proxies Sorted on CPU"),
+	STAT_SplatProxiesSortedOnCPU,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Proxies Sorted on GPU"),
+	STAT_SplatProxiesSortedOnGPU,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Hybrid GPU Sort Quota (Splats)"),
+	STAT_SplatHybridGPUQuota,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Splat Budget (Splats)"), STAT_SplatBudget, STATGROUP_PICOSplat, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(
+	TEXT("CPU Sort Time (ms)"), STAT_SplatCPUSortMs, STATGROUP_PICOSplat, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(
+	TEXT("GPU Frame Time (ms)"), STAT_SplatGPUFrameMs, STATGROUP_PICOSplat, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Render Thread Time (ms)"),
+	STAT_SplatRenderThreadMs,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Sorting Buffers In Use"),
+	STAT_SplatSortingBuffersInUse,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Sorting Buffers Pooled"),
+	STAT_SplatSortingBuffersPooled,
+	STATGROUP_PICOSplat, );
+DECLARE_MEMORY_STAT_EXTERN(
+	TEXT("Sorting Buffer Memory (GPU)"),
+	STAT_SplatSortingBufferMemory,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Chunks Resident"), STAT_SplatChunksResident, STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Chunks Loading"), STAT_SplatChunksLoading, STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Chunk Loads Started"), STAT_SplatChunkLoads, STATGROUP_PICOSplat, );
+DECLARE_MEMORY_STAT_EXTERN(
+	TEXT("Chunk Memory (GPU)"), STAT_SplatChunkMemory, STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Assets Resident (GPU)"),
+	STAT_SplatAssetsResident,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Assets Evicted (GPU)"),
+	STAT_SplatAssetsEvicted,
+	STATGROUP_PICOSplat, );
+DECLARE_MEMORY_STAT_EXTERN(
+	TEXT("Resident Asset Memory (GPU)"),
+	STAT_SplatResidentMemory,
+	STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Asset Evictions"), STAT_SplatEvictions, STATGROUP_PICOSplat, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Asset Reloads"), STAT_SplatReloads, STATGROUP_PICOSplat, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Last Asset Reload Latency (ms)"),
+	STAT_SplatReloadLatencyMs,
+	STATGROUP_PICOSplat, );
@@ -0,0 +1,188 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "SplatStreamingSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AssertionMacros.h"
+#include "SplatSettings.h"
+#include "SplatStats.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+
+void USplatStreamingSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TArray<FStreamingSource> Sources;
+	GatherSources(Sources);
+	// Without any sources (e.g. before the first frame), leave chunks as
+	// they are, rather than unloading everything.
+	if (Sources.IsEmpty())
+	{
+		return;
+	}
+
+	const double LoadDistance = USplatSettings::GetChunkLoadDistance();
+	const double Hysteresis = 1.0 + USplatSettings::GetChunkUnloadHysteresis();
+	const int64 MemoryBudget = USplatSettings::GetChunkMemoryBudget();
+
+	struct FCandidate
+	{
+		USplatChunkedComponent* Component;
+		int32 Index;
+		// Distance, favoring requested chunks by the hysteresis.
+		double Priority;
+		int64 MemorySize;
+		bool bRequested;
+		bool bLoading;
+	};
+	TArray<FCandidate> Candidates;
+	uint32 NumLoading = 0;
+	for (USplatChunkedComponent* Component : Components)
+	{
+		check(Component);
+		const FTransform& LocalToWorld = Component->GetComponentTransform();
+		const TConstArrayView<FSplatChunk> Chunks =
+			Component->GetAsset()->GetChunks();
+		for (int32 Index = 0; Index < Chunks.Num(); ++Index)
+		{
+			const FBox Bounds = Chunks[Index].Bounds.TransformBy(LocalToWorld);
+			double Distance = TNumericLimits<double>::Max();
+			for (const FStreamingSource& Source : Sources)
+			{
+				double SourceDistance = FMath::Sqrt(
+					Bounds.ComputeSquaredDistanceToPoint(Source.Location));
+				if (FVector::DotProduct(
+						Bounds.GetCenter() - Source.Location, Source.Forward) <
+				    0.0)
+				{
+					SourceDistance *= BEHIND_SOURCE_SCALE;
+				}
+				Distance = FMath::Min(Distance, SourceDistance);
+			}
+
+			const bool bRequested = Component->IsChunkRequested(Index);
+			if (Distance > (bRequested ? LoadDistance * Hysteresis
+			                           : LoadDistance))
+			{
+				if (bRequested)
+				{
+					Component->ReleaseChunk(Index);
+				}
+				continue;
+			}
+			const bool bLoading = Component->IsChunkLoading(Index);
+			NumLoading += bLoading ? 1 : 0;
+			Candidates.Add(
+				{Component,
+			     Index,
+			     bRequested ? Distance / Hysteresis : Distance,
+			     Chunks[Index].GPUMemorySize,
+			     bRequested,
+			     bLoading});
+		}
+	}
+
+	// Nearest first, until out of memory. Chunks which do not fit are
+	// unloaded, so nearer chunks can load in their place.
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+	                { return A.Priority < B.Priority; });
+	const uint32 MaxLoads = USplatSettings::GetMaxChunkLoads();
+	int64 MemorySize = 0;
+	uint32 NumResident = 0;
+	uint32 NumStarted = 0;
+	for (const FCandidate& Candidate : Candidates)
+	{
+		if (MemoryBudget > 0 &&
+		    MemorySize + Candidate.MemorySize > MemoryBudget)
+		{
+			if (Candidate.bRequested)
+			{
+				Candidate.Component->ReleaseChunk(Candidate.Index);
+				NumLoading -= Candidate.bLoading ? 1 : 0;
+			}
+			continue;
+		}
+
+		if (!Candidate.bRequested)
+		{
+			if (NumLoading >= MaxLoads)
+			{
+				continue;
+			}
+			Candidate.Component->RequestChunk(Candidate.Index);
+			if (Candidate.Component->IsChunkLoading(Candidate.Index))
+			{
+				++NumLoading;
+			}
+			++NumStarted;
+		}
+		MemorySize += Candidate.MemorySize;
+		++NumResident;
+	}
+
+	SET_DWORD_STAT(STAT_SplatChunksResident, NumResident);
+	SET_DWORD_STAT(STAT_SplatChunksLoading, NumLoading);
+	INC_DWORD_STAT_BY(STAT_SplatChunkLoads, NumStarted);
+	SET_MEMORY_STAT(STAT_SplatChunkMemory, MemorySize);
+}
+
+TStatId USplatStreamingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(
+		USplatStreamingSubsystem, STATGROUP_Tickables);
+}
+
+void USplatStreamingSubsystem::RegisterComponent(
+	USplatChunkedComponent* Component)
+{
+	check(Component);
+	check(Component->GetAsset());
+	Components.Add(Component);
+}
+
+void USplatStreamingSubsystem::UnregisterComponent(
+	USplatChunkedComponent* Component)
+{
+	Components.Remove(Component);
+}
+
+void USplatStreamingSubsystem::GatherSources(
+	TArray<FStreamingSource>& OutSources) const
+{
+	OutSources.Reset();
+
+	const UWorld* World = GetWorld();
+	check(World);
+
+	// Players, as World Partition streams around them.
+	for (FConstPlayerControllerIterator It =
+	         World->GetPlayerControllerIterator();
+	     It;
+	     ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		TArray<FWorldPartitionStreamingSource> StreamingSources;
+		if (!Controller || !Controller->IsStreamingSourceEnabled() ||
+		    !Controller->GetStreamingSources(StreamingSources))
+		{
+			continue;
+		}
+		for (const FWorldPartitionStreamingSource& Source : StreamingSources)
+		{
+			OutSources.Add({Source.Location, Source.Rotation.Vector()});
+		}
+	}
+
+	// Without players (e.g. in Editor), views rendered last frame. Players'
+	// views are not added, as they would undo favoring what players face.
+	if (OutSources.IsEmpty())
+	{
+		for (const FVector& Location : World->ViewLocationsRenderedLastFrame)
+		{
+			OutSources.Add({Location, FVector::ZeroVector});
+		}
+	}
+}
@@ -0,0 +1,75 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Set.h"
+#include "SplatChunkedComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "SplatStreamingSubsystem.generated.h"
+
+/**
+ * Loads and unloads the chunks of every `USplatChunkedComponent` in a world,
+ * by their distance from streaming sources: players, as World Partition
+ * streams cells around, or without any, views rendered last frame (e.g.
+ * Editor viewports).
+ *
+ * Chunks within the load distance are loaded, nearest first, and a few at a
+ * time. Loaded chunks are kept until further than the load distance plus
+ * hysteresis. Chunks behind every source count as further away. Once the
+ * chunk memory budget is full, the furthest chunks are unloaded to make room
+ * for nearer ones.
+ */
+UCLASS()
+class USplatStreamingSubsystem final : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * Starts streaming the chunks of a component, until a subsequent call to
+	 * `UnregisterComponent`.
+	 *
+	 * @param Component - The component to stream the chunks of.
+	 */
+	void RegisterComponent(USplatChunkedComponent* Component);
+
+	/**
+	 * Stops streaming the chunks of a component. Chunks it has loaded are left
+	 * to the component to release.
+	 *
+	 * @param Component - The component to stop streaming the chunks of.
+	 */
+	void UnregisterComponent(USplatChunkedComponent* Component);
+
+private:
+	/**
+	 * A position chunks are streamed around.
+	 */
+	struct FStreamingSource
+	{
+		FVector Location;
+		// Direction the source faces, or zero if it has none.
+		FVector Forward;
+	};
+
+	/**
+	 * Gathers the positions chunks are streamed around this frame.
+	 *
+	 * @param OutSources - Returns the streaming sources.
+	 */
+	void GatherSources(TArray<FStreamingSource>& OutSources) const;
+
+	// Chunks behind every source are treated as this much further away.
+	static constexpr double BEHIND_SOURCE_SCALE = 2.0;
+
+	TSet<USplatChunkedComponent*> Components;
+};
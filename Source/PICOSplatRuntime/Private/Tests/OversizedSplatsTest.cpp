@@ -0,0 +1,141 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "Misc/AutomationTest.h"
+#include "OversizedSplats.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PICO::Splat
+{
+namespace
+{
+constexpr float FOCAL_LENGTH = 1000.f;
+
+/**
+ * @param Variances - Variances along each axis, in cm^2. Powers of 2 pack
+ * exactly.
+ * @return Packed covariance of an axis-aligned splat.
+ */
+FPackedCovMat MakeCovariance(const FVector3f& Variances)
+{
+	return FPackedCovMat(FScaleMatrix44f::Make(Variances));
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FOversizedSplatsRadiusTest,
+	"PICOSplat.OversizedSplats.Radius",
+	EAutomationTestFlags_ApplicationContextMask |
+		EAutomationTestFlags::EngineFilter)
+
+bool FOversizedSplatsRadiusTest::RunTest(const FString& Parameters)
+{
+	// At the center of the view, the footprint is the standard deviation
+	// scaled by the focal length over the depth.
+	const FVector3f PosView(0.f, 0.f, 100.f);
+	TestNearlyEqual(
+		TEXT("Isotropic radius"),
+		FOversizedSplats::GetRadiusPixels(
+			FMatrix44f::Identity,
+			FOCAL_LENGTH,
+			PosView,
+			MakeCovariance(FVector3f(4.f))),
+		SplatRadiusStdDevs * 2.f * FOCAL_LENGTH / PosView.Z,
+		1e-3f);
+
+	// The major axis is measured, however the splat is turned in view.
+	const FPackedCovMat Elongated = MakeCovariance(FVector3f(16.f, 1.f, 1.f));
+	const float Expected = SplatRadiusStdDevs * 4.f * FOCAL_LENGTH / PosView.Z;
+	TestNearlyEqual(
+		TEXT("Elongated radius"),
+		FOversizedSplats::GetRadiusPixels(
+			FMatrix44f::Identity, FOCAL_LENGTH, PosView, Elongated),
+		Expected,
+		1e-3f);
+	TestNearlyEqual(
+		TEXT("Turned radius"),
+		FOversizedSplats::GetRadiusPixels(
+			FRotationMatrix44f::Make(FRotator3f(0.f, 90.f, 0.f)),
+			FOCAL_LENGTH,
+			PosView,
+			Elongated),
+		Expected,
+		1e-3f);
+
+	// Along the view axis, the splat is seen end on.
+	TestNearlyEqual(
+		TEXT("End on radius"),
+		FOversizedSplats::GetRadiusPixels(
+			FMatrix44f::Identity,
+			FOCAL_LENGTH,
+			PosView,
+			MakeCovariance(FVector3f(1.f, 1.f, 16.f))),
+		SplatRadiusStdDevs * FOCAL_LENGTH / PosView.Z,
+		1e-3f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FOversizedSplatsPolicyTest,
+	"PICOSplat.OversizedSplats.Policy",
+	EAutomationTestFlags_ApplicationContextMask |
+		EAutomationTestFlags::EngineFilter)
+
+bool FOversizedSplatsPolicyTest::RunTest(const FString& Parameters)
+{
+	const FPackedCovMat Covariance = MakeCovariance(FVector3f(4.f));
+	const FVector3f PosView(0.f, 0.f, 100.f);
+	const float RadiusPx = FOversizedSplats::GetRadiusPixels(
+		FMatrix44f::Identity, FOCAL_LENGTH, PosView, Covariance);
+
+	auto Adjust = [&](EOversizedSplatPolicy Policy,
+	                  float MaxRadiusPx,
+	                  const FVector3f& Pos)
+	{
+		const FOversizedSplats Oversized{Policy, MaxRadiusPx};
+		return Oversized.Adjust(
+			FMatrix44f::Identity, FOCAL_LENGTH, Pos, Covariance);
+	};
+
+	// Twice the maximum radius.
+	const float MaxRadiusPx = 0.5f * RadiusPx;
+	FOversizedSplats::FAdjustment Adjustment =
+		Adjust(EOversizedSplatPolicy::Cull, MaxRadiusPx, PosView);
+	TestTrue(TEXT("Culled is oversized"), Adjustment.bOversized);
+	TestEqual(TEXT("Culled footprint"), Adjustment.FootprintScale, 0.f);
+	TestEqual(TEXT("Culled opacity"), Adjustment.OpacityScale, 1.f);
+
+	Adjustment = Adjust(EOversizedSplatPolicy::Clamp, MaxRadiusPx, PosView);
+	TestTrue(TEXT("Clamped is oversized"), Adjustment.bOversized);
+	TestNearlyEqual(
+		TEXT("Clamped footprint"), Adjustment.FootprintScale, 0.5f, 1e-5f);
+	TestEqual(TEXT("Clamped opacity"), Adjustment.OpacityScale, 1.f);
+
+	Adjustment = Adjust(EOversizedSplatPolicy::Fade, MaxRadiusPx, PosView);
+	TestTrue(TEXT("Faded is oversized"), Adjustment.bOversized);
+	TestEqual(TEXT("Faded footprint"), Adjustment.FootprintScale, 1.f);
+	TestNearlyEqual(
+		TEXT("Faded opacity"), Adjustment.OpacityScale, 0.25f, 1e-5f);
+
+	// Splats within the maximum, nearer than the near plane, or without a
+	// policy, are left as they are.
+	for (const FOversizedSplats::FAdjustment& Unchanged :
+	     {Adjust(EOversizedSplatPolicy::None, MaxRadiusPx, PosView),
+	      Adjust(EOversizedSplatPolicy::Cull, 2.f * RadiusPx, PosView),
+	      Adjust(
+			  EOversizedSplatPolicy::Cull,
+			  MaxRadiusPx,
+			  FVector3f(0.f, 0.f, 0.5f * FOversizedSplats::NEAR_CLIP_CM))})
+	{
+		TestFalse(TEXT("Unchanged is not oversized"), Unchanged.bOversized);
+		TestEqual(TEXT("Unchanged footprint"), Unchanged.FootprintScale, 1.f);
+		TestEqual(TEXT("Unchanged opacity"), Unchanged.OpacityScale, 1.f);
+	}
+	return true;
+}
+
+} // namespace PICO::Splat
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,148 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include <limits>
+
+#include "Misc/AutomationTest.h"
+#include "PackedTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PICO::Splat
+{
+namespace
+{
+// Inputs packers clip, round or bit-cast differently, if at all.
+const float EDGE_VALUES[] = {
+	0.f,
+	-0.f,
+	TNumericLimits<float>::Min() / 2.f, // Denormal.
+	-TNumericLimits<float>::Min() / 2.f,
+	TNumericLimits<float>::Min(),
+	0.5f / FPackedPos::MAX_UNORM_11, // Rounds half away from zero.
+	0.5f,
+	1.f,
+	1.5f,
+	-0.5f,
+	-1.f,
+	1e-6f,
+	65504.f,
+	1e30f,
+	-1e30f,
+	TNumericLimits<float>::Max(),
+	TNumericLimits<float>::Lowest(),
+	std::numeric_limits<float>::infinity(),
+	-std::numeric_limits<float>::infinity(),
+	std::numeric_limits<float>::quiet_NaN(),
+};
+constexpr int32 NUM_EDGE_VALUES = UE_ARRAY_COUNT(EDGE_VALUES);
+
+/**
+ * @param Index - Index of a value, wrapping around the edge values.
+ * @return The edge value.
+ */
+float GetEdgeValue(int32 Index)
+{
+	return EDGE_VALUES[Index % NUM_EDGE_VALUES];
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FPackedPosBatchTest,
+	"PICOSplat.PackedTypes.PackedPosBatchMatchesScalar",
+	EAutomationTestFlags_ApplicationContextMask |
+		EAutomationTestFlags::EngineFilter)
+
+bool FPackedPosBatchTest::RunTest(const FString& Parameters)
+{
+	// Unit bounds pass edge values through as is, and empty bounds divide
+	// by zero.
+	const FVector3f Bounds[][2] = {
+		{FVector3f::ZeroVector, FVector3f::OneVector},
+		{FVector3f(-2.f, 0.f, 5.f), FVector3f(-2.f, 1.f, 5.f)},
+	};
+	// Counts which are not multiples of the vector width leave a remainder.
+	for (int32 Num = 0; Num <= NUM_EDGE_VALUES + 3; ++Num)
+	{
+		TArray<FVector3f> Positions;
+		Positions.SetNumUninitialized(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Positions[Index] = FVector3f(
+				GetEdgeValue(Index),
+				GetEdgeValue(Index + 1),
+				GetEdgeValue(Index + 2));
+		}
+
+		for (const FVector3f(&MinMax)[2] : Bounds)
+		{
+			TArray<FPackedPos> Batch;
+			Batch.SetNumUninitialized(Num);
+			FPackedPos::PackArray(Positions, MinMax[0], MinMax[1], Batch);
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				const FPackedPos Scalar =
+					(Positions[Index] - MinMax[0]) / (MinMax[1] - MinMax[0]);
+				if (FMemory::Memcmp(
+						&Scalar, &Batch[Index], sizeof(FPackedPos)) != 0)
+				{
+					AddError(FString::Printf(
+						TEXT("Position %d of %d, %s, packed differently."),
+						Index,
+						Num,
+						*Positions[Index].ToString()));
+				}
+			}
+		}
+	}
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FPackedCovMatBatchTest,
+	"PICOSplat.PackedTypes.PackedCovMatBatchMatchesScalar",
+	EAutomationTestFlags_ApplicationContextMask |
+		EAutomationTestFlags::EngineFilter)
+
+bool FPackedCovMatBatchTest::RunTest(const FString& Parameters)
+{
+	for (int32 Num = 0; Num <= NUM_EDGE_VALUES + 3; ++Num)
+	{
+		// Each element packed is a different edge value, in each matrix.
+		TArray<FMatrix44f> Sigmas;
+		Sigmas.SetNumUninitialized(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			for (int32 Row = 0; Row < 4; ++Row)
+			{
+				for (int32 Column = 0; Column < 4; ++Column)
+				{
+					Sigmas[Index].M[Row][Column] =
+						GetEdgeValue(Index + Row * 4 + Column);
+				}
+			}
+		}
+
+		TArray<FPackedCovMat> Batch;
+		Batch.SetNumUninitialized(Num);
+		FPackedCovMat::PackArray(Sigmas, Batch);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			const FPackedCovMat Scalar(Sigmas[Index]);
+			if (FMemory::Memcmp(
+					&Scalar, &Batch[Index], sizeof(FPackedCovMat)) != 0)
+			{
+				AddError(FString::Printf(
+					TEXT("Covariance %d of %d packed differently."),
+					Index,
+					Num));
+			}
+		}
+	}
+	return !HasAnyErrors();
+}
+
+} // namespace PICO::Splat
+
+#endif // WITH_DEV_AUTOMATION_TESTS
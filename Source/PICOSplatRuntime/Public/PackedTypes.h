@@ -8,11 +8,13 @@
 #include <cmath>
 
 #include "HAL/Platform.h"
+#include "Containers/ArrayView.h"
 #include "Logging.h"
 #include "Math/Float16.h"
 #include "Math/FloatPacker.h"
 #include "Math/Matrix.h"
 #include "Math/Vector.h"
+#include "Math/VectorRegister.h"
 #include "SplatConstants.h"
 
 namespace PICO::Splat
@@ -31,11 +33,6 @@ template <uint32 Signed, uint32 ExpBits, uint32 SigBits> uint32 ToFloat(float F)
 {
 	static_assert(Signed == 1 || Signed == 0);
 
-	if (F == 0.f)
-	{
-		return 0;
-	}
-
 	/**
 	 * HACK(seth): Attempt to remove after migration to UE 5.5+.
 	 * This is a workaround for a bug in TFloatPacker. The exponent is coming
@@ -44,6 +41,13 @@ template <uint32 Signed, uint32 ExpBits, uint32 SigBits> uint32 ToFloat(float F)
 	using FPacker = TFloatPacker<ExpBits, SigBits, false>;
 	uint32 Raw = *reinterpret_cast<uint32*>(&F);
 
+	// Zeros of either sign pack to 0. Compared as bits, so denormals do not,
+	// even if flushed to zero.
+	if ((Raw & ~FFloatInfo_IEEE32::SignMask) == 0)
+	{
+		return 0;
+	}
+
 	int32 Exponent = (Raw & FFloatInfo_IEEE32::ExponentMask) >>
 	                 FFloatInfo_IEEE32::MantissaBits;
 	Exponent -= FFloatInfo_IEEE32::ExponentBias;
@@ -71,10 +75,49 @@ template <uint32 Signed, uint32 ExpBits, uint32 SigBits> uint32 ToFloat(float F)
 	}
 }
 
+/**
+ * Converts an unsigned float produced by `ToFloat` back to a standard 32-bit
+ * float.
+ *
+ * @param Packed - The packed float, stored starting from the lowest bits.
+ * @return The unpacked float.
+ */
+template <uint32 ExpBits, uint32 SigBits> float FromUnsignedFloat(uint32 Packed)
+{
+	using FPacker = TFloatPacker<ExpBits, SigBits, false>;
+
+	if (Packed == 0)
+	{
+		return 0.f;
+	}
+
+	// `ToFloat` never produces denormals, so the leading 1 is always implied.
+	const int32 Exponent = int32((Packed >> SigBits) & ((1 << ExpBits) - 1)) -
+	                       FPacker::ExponentBias;
+	const uint32 Significand = Packed & ((1 << SigBits) - 1);
+
+	return std::ldexp(1.f + float(Significand) / (1 << SigBits), Exponent);
+}
+
+/**
+ * Converts a signed float produced by `ToFloat` back to a standard 32-bit
+ * float.
+ *
+ * @param Packed - The packed float, stored starting from the lowest bits.
+ * @return The unpacked float.
+ */
+template <uint32 ExpBits, uint32 SigBits> float FromSignedFloat(uint32 Packed)
+{
+	constexpr uint32 SignBit = 1 << (ExpBits + SigBits);
+	const float Magnitude =
+		FromUnsignedFloat<ExpBits, SigBits>(Packed & (SignBit - 1));
+	return (Packed & SignBit) ? -Magnitude : Magnitude;
+}
+
 /**
  * Converts a float to an unsigned, normalized integer, with the specified
  * number of bits.
- * Clips F to the range [0, 1].
+ * Clips F to the range [0, 1], and NaN to 0.
  *
  * @param F - The float that will be converted.
  * @return An unsigned, normalized integer equivalent to F.
@@ -84,7 +127,7 @@ template <uint32 Bits> uint32 ToUNorm(float F)
 	static_assert(Bits <= 32);
 	constexpr uint32 MaxValue = (1 << Bits) - 1;
 
-	if (F == 0.f)
+	if (!(F > 0.f))
 	{
 		return 0;
 	}
@@ -96,6 +139,87 @@ template <uint32 Bits> uint32 ToUNorm(float F)
 	const float FScaled = std::round(F * MaxValue);
 	return uint32(FScaled);
 }
+
+/**
+ * Vectorized `ToFloat`, converting four floats at once. Bit-exact with
+ * `ToFloat` for every input.
+ *
+ * @param F - The floats that will be converted.
+ * @return The outputs, each stored starting from the lowest bits.
+ */
+template <uint32 Signed, uint32 ExpBits, uint32 SigBits>
+VectorRegister4Int VectorToFloat(const VectorRegister4Float& F)
+{
+	static_assert(Signed == 1 || Signed == 0);
+
+	using FPacker = TFloatPacker<ExpBits, SigBits, false>;
+	const VectorRegister4Int Raw = VectorCastFloatToInt(F);
+
+	VectorRegister4Int Exponent = VectorShiftRightImmLogical(
+		VectorIntAnd(Raw, VectorIntSet1(FFloatInfo_IEEE32::ExponentMask)),
+		FFloatInfo_IEEE32::MantissaBits);
+	Exponent = VectorIntSubtract(
+		Exponent, VectorIntSet1(FFloatInfo_IEEE32::ExponentBias));
+	Exponent = VectorIntMin(
+		VectorIntMax(Exponent, VectorIntSet1(-FPacker::ExponentBias + 1)),
+		VectorIntSet1(FPacker::ExponentBias));
+	Exponent = VectorIntAdd(Exponent, VectorIntSet1(FPacker::ExponentBias));
+	Exponent = VectorIntAnd(
+		VectorShiftLeftImm(Exponent, SigBits),
+		VectorIntSet1(FPacker::ExponentMask));
+
+	VectorRegister4Int Significand = VectorShiftRightImmLogical(
+		VectorIntAnd(Raw, VectorIntSet1(FFloatInfo_IEEE32::MantissaMask)),
+		FFloatInfo_IEEE32::MantissaBits - SigBits);
+	Significand =
+		VectorIntAnd(Significand, VectorIntSet1(FPacker::MantissaMask));
+
+	VectorRegister4Int Packed = VectorIntOr(Exponent, Significand);
+	if constexpr (Signed == 1)
+	{
+		VectorRegister4Int Sign = VectorShiftRightImmLogical(
+			VectorIntAnd(Raw, VectorIntSet1(FFloatInfo_IEEE32::SignMask)),
+			FFloatInfo_IEEE32::SignShift - ExpBits - SigBits);
+		Sign = VectorIntAnd(Sign, VectorIntSet1(FPacker::SignMask));
+		Packed = VectorIntOr(Packed, Sign);
+	}
+
+	// Zeros of either sign pack to 0.
+	const VectorRegister4Int IsZero = VectorIntCompareEQ(
+		VectorIntAnd(Raw, VectorIntSet1(~FFloatInfo_IEEE32::SignMask)),
+		VectorIntSet1(0));
+	return VectorIntAndNot(IsZero, Packed);
+}
+
+/**
+ * Vectorized `ToUNorm`, converting four floats at once. Bit-exact with
+ * `ToUNorm` for every input.
+ *
+ * @param F - The floats that will be converted.
+ * @return Unsigned, normalized integers equivalent to F.
+ */
+template <uint32 Bits>
+VectorRegister4Int VectorToUNorm(const VectorRegister4Float& F)
+{
+	// Keeps scaled values exact integers, or halves, in a float.
+	static_assert(Bits < 24);
+	const VectorRegister4Float MaxValue =
+		VectorSetFloat1(float((1 << Bits) - 1));
+
+	// std::round rounds halfway cases away from zero. Adding 0.5 and
+	// truncating would not, as the sum may round up.
+	const VectorRegister4Float Scaled = VectorMultiply(F, MaxValue);
+	const VectorRegister4Float Whole = VectorTruncate(Scaled);
+	const VectorRegister4Float RoundUp = VectorBitwiseAnd(
+		VectorCompareGE(VectorSubtract(Scaled, Whole), VectorSetFloat1(0.5f)),
+		VectorOne());
+	VectorRegister4Float Rounded = VectorAdd(Whole, RoundUp);
+
+	Rounded = VectorSelect(VectorCompareGT(F, VectorOne()), MaxValue, Rounded);
+	Rounded =
+		VectorSelect(VectorCompareGT(F, VectorZero()), Rounded, VectorZero());
+	return VectorFloatToInt(Rounded);
+}
 } // namespace
 
 /**
@@ -137,6 +261,67 @@ struct FPackedPos
 	 */
 	FPackedPos(const FVector3f& V) : FPackedPos(V.X, V.Y, V.Z) {}
 
+	/**
+	 * Packs positions, each normalized between a per-axis minimum and maximum,
+	 * four at a time. Bit-exact with packing `(P - Min) / (Max - Min)` one
+	 * position at a time.
+	 *
+	 * @param Positions - Positions to pack.
+	 * @param Min - Element-wise minimum of the positions.
+	 * @param Max - Element-wise maximum of the positions.
+	 * @param OutPacked - Returns the packed positions. *Must* be the same size
+	 * as `Positions`.
+	 */
+	static void PackArray(
+		TConstArrayView<FVector3f> Positions,
+		const FVector3f& Min,
+		const FVector3f& Max,
+		TArrayView<FPackedPos> OutPacked)
+	{
+		check(Positions.Num() == OutPacked.Num());
+
+		const FVector3f Range = Max - Min;
+		const VectorRegister4Float MinX = VectorSetFloat1(Min.X);
+		const VectorRegister4Float MinY = VectorSetFloat1(Min.Y);
+		const VectorRegister4Float MinZ = VectorSetFloat1(Min.Z);
+		const VectorRegister4Float RangeX = VectorSetFloat1(Range.X);
+		const VectorRegister4Float RangeY = VectorSetFloat1(Range.Y);
+		const VectorRegister4Float RangeZ = VectorSetFloat1(Range.Z);
+
+		const int32 NumVectorized = Positions.Num() & ~3;
+		for (int32 Index = 0; Index < NumVectorized; Index += 4)
+		{
+			const FVector3f* P = &Positions[Index];
+			const VectorRegister4Float X = VectorDivide(
+				VectorSubtract(
+					MakeVectorRegisterFloat(P[0].X, P[1].X, P[2].X, P[3].X),
+					MinX),
+				RangeX);
+			const VectorRegister4Float Y = VectorDivide(
+				VectorSubtract(
+					MakeVectorRegisterFloat(P[0].Y, P[1].Y, P[2].Y, P[3].Y),
+					MinY),
+				RangeY);
+			const VectorRegister4Float Z = VectorDivide(
+				VectorSubtract(
+					MakeVectorRegisterFloat(P[0].Z, P[1].Z, P[2].Z, P[3].Z),
+					MinZ),
+				RangeZ);
+
+			const VectorRegister4Int Packed = VectorIntOr(
+				VectorIntOr(
+					VectorShiftLeftImm(VectorToUNorm<10>(Z), 22),
+					VectorShiftLeftImm(VectorToUNorm<11>(Y), 11)),
+				VectorToUNorm<11>(X));
+			VectorIntStore(Packed, &OutPacked[Index]);
+		}
+
+		for (int32 Index = NumVectorized; Index < Positions.Num(); ++Index)
+		{
+			OutPacked[Index] = (Positions[Index] - Min) / Range;
+		}
+	}
+
 	/**
 	 * Serializes / deserializes a packed position.
 	 *
@@ -209,6 +394,102 @@ struct FPackedCovMat
 		         (YYPacked << 22) | (YZPacked << 11) | ZZPacked;
 	}
 
+	/**
+	 * Packs covariance matrices four at a time. Bit-exact with packing one
+	 * matrix at a time.
+	 *
+	 * @param Sigmas - Covariance matrices. Only upper-triangular portions will
+	 * be read.
+	 * @param OutPacked - Returns the packed matrices. *Must* be the same size
+	 * as `Sigmas`.
+	 */
+	static void PackArray(
+		TConstArrayView<FMatrix44f> Sigmas, TArrayView<FPackedCovMat> OutPacked)
+	{
+		check(Sigmas.Num() == OutPacked.Num());
+
+		const int32 NumVectorized = Sigmas.Num() & ~3;
+		for (int32 Index = 0; Index < NumVectorized; Index += 4)
+		{
+			const FMatrix44f* S = &Sigmas[Index];
+			auto Gather = [S](int32 Row, int32 Column)
+			{
+				return MakeVectorRegisterFloat(
+					S[0].M[Row][Column],
+					S[1].M[Row][Column],
+					S[2].M[Row][Column],
+					S[3].M[Row][Column]);
+			};
+
+			// Upper and lower 32 bits, as in the scalar constructor.
+			const VectorRegister4Int XX = VectorToFloat<0, 5, 5>(Gather(0, 0));
+			const VectorRegister4Int XY = VectorToFloat<1, 5, 5>(Gather(0, 1));
+			const VectorRegister4Int XZ = VectorToFloat<1, 5, 5>(Gather(0, 2));
+			const VectorRegister4Int YY = VectorToFloat<0, 5, 5>(Gather(1, 1));
+			const VectorRegister4Int YZ = VectorToFloat<1, 5, 5>(Gather(1, 2));
+			const VectorRegister4Int ZZ = VectorToFloat<0, 5, 6>(Gather(2, 2));
+			const VectorRegister4Int High = VectorIntOr(
+				VectorIntOr(
+					VectorShiftLeftImm(XX, 22), VectorShiftLeftImm(XY, 11)),
+				XZ);
+			const VectorRegister4Int Low = VectorIntOr(
+				VectorIntOr(
+					VectorShiftLeftImm(YY, 22), VectorShiftLeftImm(YZ, 11)),
+				ZZ);
+
+			alignas(16) uint32 HighBits[4];
+			alignas(16) uint32 LowBits[4];
+			VectorIntStoreAligned(High, HighBits);
+			VectorIntStoreAligned(Low, LowBits);
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				OutPacked[Index + Lane].Packed =
+					(uint64(HighBits[Lane]) << 32) | LowBits[Lane];
+			}
+		}
+
+		for (int32 Index = NumVectorized; Index < Sigmas.Num(); ++Index)
+		{
+			OutPacked[Index] = Sigmas[Index];
+		}
+	}
+
+	/**
+	 * Gets the sum of the variances, which bounds the largest variance along
+	 * any axis.
+	 *
+	 * @return Trace of the covariance matrix.
+	 */
+	float GetTrace() const
+	{
+		const float XX = FromUnsignedFloat<5, 5>((Packed >> 54) & 0x3FF);
+		const float YY = FromUnsignedFloat<5, 5>((Packed >> 22) & 0x3FF);
+		const float ZZ = FromUnsignedFloat<5, 6>(Packed & 0x7FF);
+		return XX + YY + ZZ;
+	}
+
+	/**
+	 * Unpacks the covariance matrix. Matches `unpack_covariance` in
+	 * `AdjustSplatsCS.usf`.
+	 *
+	 * @return Covariance matrix, in the upper-left 3x3 of a 4x4 matrix.
+	 */
+	FMatrix44f Unpack() const
+	{
+		const float XX = FromUnsignedFloat<5, 5>((Packed >> 54) & 0x3FF);
+		const float XY = FromSignedFloat<5, 5>((Packed >> 43) & 0x7FF);
+		const float XZ = FromSignedFloat<5, 5>((Packed >> 32) & 0x7FF);
+		const float YY = FromUnsignedFloat<5, 5>((Packed >> 22) & 0x3FF);
+		const float YZ = FromSignedFloat<5, 5>((Packed >> 11) & 0x7FF);
+		const float ZZ = FromUnsignedFloat<5, 6>(Packed & 0x7FF);
+
+		return FMatrix44f(
+			FPlane4f(XX, XY, XZ, 0.f),
+			FPlane4f(XY, YY, YZ, 0.f),
+			FPlane4f(XZ, YZ, ZZ, 0.f),
+			FPlane4f(0.f, 0.f, 0.f, 1.f));
+	}
+
 	/**
 	 * Serializes / deserializes a packed covariance matrix.
 	 *
@@ -273,6 +554,11 @@ struct FIndexedDistance
 		                               : NOT_VISIBLE;
 	}
 
+	/**
+	 * @return Quantized inverse depth of this splat. Larger values are nearer.
+	 */
+	uint16 GetDistance() const { return Distance; }
+
 	/**
 	 * Returns whether this splat is nearer than the provided one. Used to
 	 * support std::sort.
@@ -304,7 +590,87 @@ private:
 	uint16 Distance;
 };
 
-// Safety check.
+/**
+ * A node of a splat level of detail hierarchy, as read by shaders.
+ */
+struct FPackedLODNode
+{
+	// Index of the parent, or `MAX_uint32` for roots.
+	uint32 Parent;
+	// Bounds radius in the lower 16 bits, and error in the upper, as halves.
+	uint32 RadiusAndError;
+};
+
+/**
+ * A node of a splat level of detail hierarchy. Every splat is a node, and
+ * parents are coarser splats standing in for their children. Splats are stored
+ * in pre-order, so each subtree is contiguous, starting at its root.
+ *
+ * A node is detailed enough for a view when its error, seen from the nearest
+ * point of its bounds, projects below a threshold. Bounds nest, and errors
+ * only grow towards the root, so a node is detailed enough whenever its parent
+ * is. The cut drawn is every node detailed enough whose parent is not.
+ */
+struct FSplatLODNode
+{
+	// Distance below which nodes are measured as if at it, in centimeters.
+	// Matches the near clip of `FIndexedDistance`.
+	static constexpr float MIN_DISTANCE_CM = 10.f;
+
+	// Index one past the last node of this node's subtree.
+	uint32 SubtreeEnd = 0;
+	// Index of the parent, or `INDEX_NONE` for roots.
+	int32 Parent = INDEX_NONE;
+	// Radius of a sphere about this node bounding its subtree, in meters.
+	FFloat16 BoundsRadius;
+	// How far this node misplaces the detail of its subtree, in meters. 0 for
+	// leaves.
+	FFloat16 Error;
+
+	/**
+	 * Gets whether this node is detailed enough for a view.
+	 *
+	 * @param DistanceCM - Distance from the view to this node, in centimeters.
+	 * @param LODScale - Scale from this node's meters to centimeters in the
+	 * space of `DistanceCM`.
+	 * @param MaxError - Largest error allowed, over the distance it is seen
+	 * from (i.e. in pixels, over the focal length).
+	 * @return Whether this node may be drawn in place of its subtree.
+	 */
+	bool IsDetailed(float DistanceCM, float LODScale, float MaxError) const
+	{
+		const float NearestCM = FMath::Max(
+			DistanceCM - LODScale * BoundsRadius.GetFloat(), MIN_DISTANCE_CM);
+		return LODScale * Error.GetFloat() <= MaxError * NearestCM;
+	}
+
+	/**
+	 * @return This node, as read by shaders.
+	 */
+	FPackedLODNode Pack() const
+	{
+		return FPackedLODNode{
+			Parent == INDEX_NONE ? MAX_uint32 : uint32(Parent),
+			(uint32(Error.Encoded) << 16) | BoundsRadius.Encoded};
+	}
+
+	/**
+	 * Serializes / deserializes a node.
+	 *
+	 * @param Ar - Archive to load from or save to.
+	 * @param Node - Node to read or write.
+	 */
+	friend FArchive& operator<<(FArchive& Ar, FSplatLODNode& Node)
+	{
+		return Ar << Node.SubtreeEnd << Node.Parent << Node.BoundsRadius
+		          << Node.Error;
+	}
+};
+
+// Safety checks.
+static_assert(sizeof(FPackedPos) == sizeof(uint32));
+static_assert(sizeof(FPackedCovMat) == sizeof(uint64));
 static_assert(sizeof(FIndexedDistance) == 8);
+static_assert(sizeof(FPackedLODNode) == sizeof(uint64));
 
 } // namespace PICO::Splat
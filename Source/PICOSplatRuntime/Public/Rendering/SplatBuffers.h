@@ -8,10 +8,12 @@
 #include <optional>
 
 #include "Logging.h"
+#include "Math/Float16.h"
 #include "PackedTypes.h"
 #include "RHICommandList.h"
 #include "RHIResources.h"
 #include "RenderResource.h"
+#include "Serialization/BulkData.h"
 #include "StaticMeshVertexData.h"
 
 namespace PICO::Splat
@@ -27,6 +29,17 @@ public:
 	virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
 	//~ End FRenderResource Interface
 
+	/**
+	 * @return Size of this buffer on the GPU, in bytes.
+	 */
+	uint32 GetSize() const { return Size; }
+
+	/**
+	 * Reads every page of the CPU copy of this buffer's data, if still held,
+	 * so uploading it again does not wait on the disk.
+	 */
+	void PrefetchData() const;
+
 protected:
 	FSplatBufferBase(
 		uint32 NumSplats,
@@ -132,6 +145,40 @@ public:
 	//~ End FRenderResource Interface
 };
 
+/**
+ * Data for a static buffer, stored in its GPU format in cooked bulk data. Where
+ * the platform allows, the payload is memory-mapped rather than copied. Either
+ * way, it is released once uploaded, unless kept to upload again.
+ */
+class FSplatMappedResourceArray final : public FResourceArrayInterface
+{
+public:
+	/**
+	 * Takes the payload of bulk data.
+	 *
+	 * @param BulkData - Bulk data holding the payload. Returns without it.
+	 * @param bInKeepPayload - Whether to keep the payload once uploaded, so
+	 * the buffer can be released and uploaded again. Should only be set if
+	 * the payload is memory-mapped, else a copy stays in memory.
+	 */
+	FSplatMappedResourceArray(FByteBulkData& BulkData, bool bInKeepPayload);
+
+	//~ Begin FResourceArrayInterface Interface
+	virtual const void* GetResourceData() const override;
+	virtual uint32 GetResourceDataSize() const override;
+	virtual void Discard() override;
+	virtual bool IsStatic() const override { return true; }
+	virtual bool GetAllowCPUAccess() const override { return false; }
+	virtual void SetAllowCPUAccess(bool bInNeedsCPUAccess) override {}
+	//~ End FResourceArrayInterface Interface
+
+private:
+	// Read before the payload is taken.
+	uint32 Size;
+	bool bKeepPayload;
+	std::unique_ptr<FOwnedBulkDataPtr> Payload;
+};
+
 /**
  * Helper to get the GPU format that will hold C++-defined types.
  */
@@ -148,6 +195,10 @@ template <typename T> EPixelFormat GetFormat()
 		// PF_R64_UINT doesn't work.
 		return PF_R32G32_UINT;
 	}
+	else if (std::is_same_v<T, FPackedLODNode>)
+	{
+		return PF_R32G32_UINT;
+	}
 	// 32 bits per splat.
 	else if (std::is_same_v<T, FColor>)
 	{
@@ -157,6 +208,19 @@ template <typename T> EPixelFormat GetFormat()
 	{
 		return PF_R32_UINT;
 	}
+	else if (std::is_same_v<T, uint32>)
+	{
+		return PF_R32_UINT;
+	}
+	// 16 bits per splat.
+	else if (std::is_same_v<T, uint16>)
+	{
+		return PF_R16_UINT;
+	}
+	else if (std::is_same_v<T, FFloat16>)
+	{
+		return PF_R16F;
+	}
 }
 
 /**
@@ -188,21 +252,44 @@ public:
 		check(ResourceArray);
 	}
 
+	/**
+	 * Create buffer from data already in its GPU format, e.g. memory-mapped.
+	 *
+	 * @param InMappedData - Data to upload. This buffer will take ownership of
+	 * InMappedData, and release it later, either after RHI initialization or in
+	 * the destructor.
+	 */
+	TSplatStaticBuffer(std::unique_ptr<FResourceArrayInterface>&& InMappedData)
+		: FSplatBufferBase(
+			  InMappedData->GetResourceDataSize() / sizeof(T),
+			  GetFormat<T>(),
+			  false,
+			  ERHIAccess::SRVGraphics,
+			  EBufferUsageFlags::Dynamic |
+				  EBufferUsageFlags::KeepCPUAccessible |
+				  EBufferUsageFlags::ShaderResource)
+		, MappedData(std::move(InMappedData))
+	{
+		ResourceArray = MappedData.get();
+	}
+
 	// Move-only, with extra checking to avoid leaks.
 	~TSplatStaticBuffer() = default;
 	TSplatStaticBuffer(const TSplatStaticBuffer&) = delete;
 	TSplatStaticBuffer(TSplatStaticBuffer&& Buffer) : FSplatBufferBase(Buffer)
 	{
-		check(Buffer.Data);
+		check(Buffer.Data || Buffer.MappedData);
 		Data = std::move(Buffer.Data);
+		MappedData = std::move(Buffer.MappedData);
 	}
 	TSplatStaticBuffer& operator=(const TSplatStaticBuffer&) = delete;
 	TSplatStaticBuffer& operator=(TSplatStaticBuffer&& Buffer)
 	{
-		check(!Data);
-		check(Buffer.Data);
+		check(!Data && !MappedData);
+		check(Buffer.Data || Buffer.MappedData);
 		FSplatBufferBase::operator=(Buffer);
 		Data = std::move(Buffer.Data);
+		MappedData = std::move(Buffer.MappedData);
 		return *this;
 	}
 
@@ -218,10 +305,30 @@ public:
 		if (ResourceArray->GetResourceDataSize() == 0)
 		{
 			Data.reset();
+			MappedData.reset();
 		}
 	}
 	//~ End FRenderResource Interface
 
+	/**
+	 * Gets the CPU copy of this buffer's data. This is released once uploaded
+	 * to the GPU, so must be read before RHI initialization.
+	 *
+	 * @return Constant view of the data.
+	 */
+	TConstArrayView<T> GetData() const
+	{
+		if (MappedData)
+		{
+			return TConstArrayView<T>(
+				static_cast<const T*>(MappedData->GetResourceData()),
+				MappedData->GetResourceDataSize() / sizeof(T));
+		}
+		check(Data);
+		return TConstArrayView<T>(
+			reinterpret_cast<const T*>(Data->GetDataPointer()), Data->Num());
+	}
+
 	/**
 	 * Saves a buffer to or loads it from an archive.
 	 *
@@ -260,7 +367,9 @@ public:
 	}
 
 private:
+	// Only one of these is set, until released.
 	std::unique_ptr<TStaticMeshVertexData<T>> Data;
+	std::unique_ptr<FResourceArrayInterface> MappedData;
 };
 
 } // namespace PICO::Splat
\ No newline at end of file
@@ -4,13 +4,20 @@
 
 #pragma once
 
+#include <atomic>
 #include <optional>
 
 #include "Containers/Array.h"
+#include "Math/Float16.h"
+#include "Misc/SecureHash.h"
 #include "PackedTypes.h"
 #include "RenderCommandFence.h"
 #include "Rendering/SplatBuffers.h"
+#include "Serialization/BulkData.h"
+#include "SplatSettings.h"
+#include "Tasks/Task.h"
 #include "UObject/Object.h"
+#include "UObject/ObjectSaveContext.h"
 
 #include "SplatAsset.generated.h"
 
@@ -28,11 +35,26 @@ class PICOSPLATRUNTIME_API USplatAsset : public UObject
 public:
 	//~ Begin UObject Interface
 	virtual void BeginDestroy() override;
+	virtual bool IsReadyForAsyncPostLoad() const override;
 	virtual bool IsReadyForFinishDestroy() override;
 	virtual void PostLoad() override; // Loading from disk only.
+	virtual void
+	PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext) override;
 	virtual void Serialize(FArchive& Ar) override;
 	//~ End UObject Interface
 
+	/**
+	 * @return Whether this asset's GPU resources have been initialized, so it
+	 * can be drawn. Assets being loaded are not until prepared.
+	 */
+	bool IsInitialized() const { return bInitialized; }
+
+	/**
+	 * @return Delegate broadcast on the game thread once this asset's GPU
+	 * resources have been initialized.
+	 */
+	FSimpleMulticastDelegate& OnInitialized() { return InitializedDelegate; }
+
 	/**
 	 * @return SRV for this asset's colors.
 	 */
@@ -64,6 +86,9 @@ public:
 	}
 
 	/**
+	 * Gets this asset's covariance matrices. *Must not* use the codebook
+	 * format.
+	 *
 	 * @return SRV for this asset's covariance matrices.
 	 */
 	FShaderResourceViewRHIRef GetCovariancesSRV() const
@@ -73,11 +98,132 @@ public:
 		return CovariancesCM->ShaderResourceViewRHI;
 	}
 
+	/**
+	 * @return SRV for the codebook of this asset's covariance matrices, indexed
+	 * by `GetCovarianceIndicesSRV`. *Must* use the codebook format.
+	 */
+	FShaderResourceViewRHIRef GetCovarianceCodebookSRV() const
+	{
+		check(CovarianceCodebook);
+		check(CovarianceCodebook->ShaderResourceViewRHI);
+		return CovarianceCodebook->ShaderResourceViewRHI;
+	}
+
+	/**
+	 * @return SRV for the codebook index of each splat's covariance matrix.
+	 * *Must* use the codebook format.
+	 */
+	FShaderResourceViewRHIRef GetCovarianceIndicesSRV() const
+	{
+		check(CovarianceIndices);
+		check(CovarianceIndices->ShaderResourceViewRHI);
+		return CovarianceIndices->ShaderResourceViewRHI;
+	}
+
+	/**
+	 * @return Format this asset's covariance matrices are stored in.
+	 */
+	ECovarianceFormat GetCovarianceFormat() const { return CovarianceFormat; }
+
+	/**
+	 * Gets this asset's higher-order spherical harmonics, alongside the range
+	 * each coefficient is quantized to. *Must* have a degree above 0.
+	 *
+	 * @param OutMin - Minimum of each coefficient.
+	 * @param OutScale - Step of each coefficient.
+	 * @return SRV for this asset's packed coefficients, per splat or, with the
+	 * codebook format, per codebook entry.
+	 */
+	FShaderResourceViewRHIRef GetSHCoefficientsSRV(
+		TConstArrayView<float>& OutMin, TConstArrayView<float>& OutScale) const
+	{
+		check(SHCoefficients);
+		check(SHCoefficients->ShaderResourceViewRHI);
+		OutMin = SHMin;
+		OutScale = SHScale;
+		return SHCoefficients->ShaderResourceViewRHI;
+	}
+
+	/**
+	 * @return SRV for the codebook index of each splat's spherical harmonics.
+	 * *Must* use the codebook format.
+	 */
+	FShaderResourceViewRHIRef GetSHIndicesSRV() const
+	{
+		check(SHIndices);
+		check(SHIndices->ShaderResourceViewRHI);
+		return SHIndices->ShaderResourceViewRHI;
+	}
+
+	/**
+	 * @return Degree of this asset's spherical harmonics, or 0 if it only has
+	 * base colors.
+	 */
+	uint32 GetSHDegree() const { return SHDegree; }
+
+	/**
+	 * @return Format this asset's spherical harmonics are stored in.
+	 */
+	ESHFormat GetSHFormat() const { return SHFormat; }
+
+	/**
+	 * Gets the matrix from local directions to the directions spherical
+	 * harmonics were fit in, as the source may use different axes.
+	 *
+	 * @return Local to spherical harmonics matrix.
+	 */
+	const FMatrix44f& GetLocalToSH() const { return LocalToSH; }
+
 	/**
 	 * @return The number of splats in this asset.
 	 */
 	uint32 GetNumSplats() const { return NumSplats; }
 
+	/**
+	 * @return Size of this asset's buffers on the GPU, in bytes.
+	 */
+	uint64 GetGPUMemorySize() const;
+
+	/**
+	 * @return Whether this asset's GPU buffers can be evicted while unused, as
+	 * the payloads they were uploaded from are kept.
+	 */
+	bool CanEvictGPUBuffers() const { return bEvictable; }
+
+	/**
+	 * @return Whether this asset's GPU buffers are uploaded, so it can be
+	 * drawn. Only read on the render thread.
+	 */
+	bool IsGPUResident() const { return bGPUResident; }
+
+	/**
+	 * Releases this asset's GPU buffers, keeping the payloads they were
+	 * uploaded from. *Must* be evictable.
+	 */
+	void EvictGPUBuffers_RenderThread();
+
+	/**
+	 * Starts reading the payloads of evicted GPU buffers back into memory on a
+	 * worker thread, so uploading them again does not wait on the disk.
+	 */
+	void BeginPrefetchGPUBuffers_RenderThread();
+
+	/**
+	 * @return Whether payloads being read back into memory have been.
+	 */
+	bool IsPrefetchComplete() const
+	{
+		return !PrefetchTask.IsValid() || PrefetchTask.IsCompleted();
+	}
+
+	/**
+	 * Uploads evicted GPU buffers again, waiting for any payloads still being
+	 * read back into memory.
+	 *
+	 * @param RHICmdList - The RHI command list to create resources with.
+	 */
+	void RestoreGPUBuffers_RenderThread(FRHICommandListBase& RHICmdList);
+
 	/**
 	 * @return Constant view of this asset's positions.
 	 */
@@ -86,6 +232,94 @@ public:
 		return PositionsFullPrecision;
 	}
 
+	/**
+	 * Gets the radius of each splat along its largest axis, at one standard
+	 * deviation. Empty if only sorting on GPU.
+	 *
+	 * @return Constant view of this asset's radii, in centimeters.
+	 */
+	TConstArrayView<FFloat16> GetRadiiCM() const { return RadiiCM; }
+
+	/**
+	 * @return Whether this asset's radii are uploaded, for foveated thinning
+	 * on the GPU. Only assets cooked without radii have none.
+	 */
+	bool HasRadiiBuffer() const { return RadiiBuffer.has_value(); }
+
+	/**
+	 * @return SRV for this asset's radii, as in `GetRadiiCM()`. *Must* have
+	 * them uploaded.
+	 */
+	FShaderResourceViewRHIRef GetRadiiSRV() const
+	{
+		check(RadiiBuffer);
+		check(RadiiBuffer->ShaderResourceViewRHI);
+		return RadiiBuffer->ShaderResourceViewRHI;
+	}
+
+	/**
+	 * Gets the opacity of each splat, as in its color. Empty if only sorting on
+	 * GPU.
+	 *
+	 * @return Constant view of this asset's opacities.
+	 */
+	TConstArrayView<uint8> GetOpacities() const { return Opacities; }
+
+	/**
+	 * @return Whether this asset has a level of detail hierarchy, so only a cut
+	 * of it may be drawn.
+	 */
+	bool HasLOD() const { return LODNodesBuffer.has_value(); }
+
+	/**
+	 * Gets the number of leaves of this asset's level of detail hierarchy,
+	 * the most any cut of it draws.
+	 *
+	 * @return Number of leaves, or of splats without a hierarchy.
+	 */
+	uint32 GetNumLODLeaves() const
+	{
+		return HasLOD() ? NumLODLeaves : NumSplats;
+	}
+
+	/**
+	 * Gets the level of detail node of each splat, in the order splats are
+	 * stored. Empty without a hierarchy, or if only sorting on GPU.
+	 *
+	 * @return Constant view of this asset's nodes.
+	 */
+	TConstArrayView<PICO::Splat::FSplatLODNode> GetLODNodes() const
+	{
+		return LODNodes;
+	}
+
+	/**
+	 * @return SRV for this asset's level of detail nodes, packed. *Must* have a
+	 * hierarchy.
+	 */
+	FShaderResourceViewRHIRef GetLODNodesSRV() const
+	{
+		check(LODNodesBuffer);
+		check(LODNodesBuffer->ShaderResourceViewRHI);
+		return LODNodesBuffer->ShaderResourceViewRHI;
+	}
+
+	/**
+	 * @return Whether this asset's splats are ordered by importance, so any
+	 * prefix of them may be drawn in place of all.
+	 */
+	bool IsOrderedByImportance() const { return !PrefixCoverage.IsEmpty(); }
+
+	/**
+	 * Gets how much of this asset's coverage a prefix of its splats keeps, so
+	 * the splats drawn can be made more opaque to compensate.
+	 *
+	 * @param NumDrawn - Number of splats drawn, from the first.
+	 * @return Fraction of the coverage of every splat, in (0, 1], or 1 if not
+	 * ordered by importance.
+	 */
+	float GetPrefixCoverage(uint32 NumDrawn) const;
+
 	/**
 	 * Gets this assets positions, alongside element-wise minimum and scaling.
 	 *
@@ -116,11 +350,13 @@ public:
 		TStaticMeshVertexData<FColor> Data;
 		Data.Assign(ColorsLinear);
 		Colors = PICO::Splat::TSplatStaticBuffer(std::move(Data));
+		SetOpacitiesFromColors();
 	}
 
 	/**
 	 * Populates this asset with covariance matrices describing the given
-	 * rotations and scales.
+	 * rotations and scales, and with radii from the scales. With the codebook
+	 * format, these are quantized, and the error is logged.
 	 *
 	 * @param Rotations - Array of rotations, one per splat.
 	 * @param ScalesMeters - Array of scales, one per splat, in meters.
@@ -129,6 +365,48 @@ public:
 		const TArray<FQuat4f>& Rotations,
 		const TArray<FVector3f>& ScalesMeters);
 
+	/**
+	 * Populates this asset with higher-order spherical harmonics, compressed to
+	 * the format in settings. The error and memory used are logged.
+	 *
+	 * @param Degree - Degree of the spherical harmonics, in [1, 3].
+	 * @param Coefficients - Coefficients of each splat, ordered by coefficient
+	 * then channel, not counting the constant term.
+	 * @param InLocalToSH - Matrix from local directions to the directions the
+	 * spherical harmonics were fit in.
+	 */
+	void SetSphericalHarmonics(
+		uint32 Degree,
+		TConstArrayView<float> Coefficients,
+		const FMatrix44f& InLocalToSH);
+
+	/**
+	 * Populates this asset with a level of detail hierarchy, over splats
+	 * already stored in its pre-order.
+	 *
+	 * @param Nodes - The node of each splat.
+	 */
+	void SetLODNodes(TArray<PICO::Splat::FSplatLODNode>&& Nodes)
+	{
+		check(Nodes.Num() == NumSplats);
+
+		LODNodes = std::move(Nodes);
+		SetPackedLODNodes();
+	}
+
+	/**
+	 * Marks this asset's splats, already stored in order, as ordered by
+	 * importance.
+	 *
+	 * @param InPrefixCoverage - Fraction of the coverage of every splat kept by
+	 * each of evenly spaced prefixes, the last being every splat.
+	 */
+	void SetPrefixCoverage(TArray<float>&& InPrefixCoverage)
+	{
+		check(!InPrefixCoverage.IsEmpty());
+		PrefixCoverage = std::move(InPrefixCoverage);
+	}
+
 	/**
 	 * Sets the number of splats in the asset.
 	 *
@@ -143,6 +421,50 @@ public:
 	 * @param PositionsMeters - An array of positions, one per splat, in meters.
 	 */
 	void SetPositionsMeters(TArray<FVector3f>&& PositionsMeters);
+
+	/**
+	 * Starts populating this asset a window of splats at a time, for imports
+	 * too large to unpack at once. Each window is packed as it is added, so
+	 * only packed data grows with the number of splats. Covariances and
+	 * spherical harmonics are stored per splat, as codebooks are built from
+	 * every splat at once.
+	 *
+	 * @param InNumSplats - Number of splats.
+	 * @param Degree - Degree of the spherical harmonics, in [0, 3].
+	 * @param SHSample - Coefficients of a sample of splats, ordered as in
+	 * `SetSphericalHarmonics`, to quantize to. Empty for degree 0.
+	 * @param InLocalToSH - Matrix from local directions to the directions the
+	 * spherical harmonics were fit in.
+	 */
+	void BeginStreamedSplats(
+		uint32 InNumSplats,
+		uint32 Degree,
+		TConstArrayView<float> SHSample,
+		const FMatrix44f& InLocalToSH);
+
+	/**
+	 * Packs a window of splats, after `BeginStreamedSplats`.
+	 *
+	 * @param First - Index of the first splat in the window.
+	 * @param PositionsMeters - Position of each splat, in meters.
+	 * @param Rotations - Rotation of each splat.
+	 * @param ScalesMeters - Scale of each splat, in meters.
+	 * @param ColorsLinear - Linear, 8-bit-per-channel color of each splat.
+	 * @param SHCoefficients - Coefficients of each splat, ordered as in
+	 * `SetSphericalHarmonics`. Empty for degree 0.
+	 */
+	void AddStreamedSplats(
+		uint32 First,
+		TConstArrayView<FVector3f> PositionsMeters,
+		TConstArrayView<FQuat4f> Rotations,
+		TConstArrayView<FVector3f> ScalesMeters,
+		TConstArrayView<FColor> ColorsLinear,
+		TConstArrayView<float> SHCoefficients);
+
+	/**
+	 * Finishes populating this asset, once every window has been added.
+	 */
+	void EndStreamedSplats();
 #endif
 
 private:
@@ -151,6 +473,74 @@ private:
 	 */
 	void BeginInit();
 
+	/**
+	 * Starts preparing a loaded asset (i.e. reading bulk data and derived data)
+	 * in the background.
+	 */
+	void BeginPrepare();
+
+	/**
+	 * Prepares a loaded asset, for BeginInit(). Runs in the background.
+	 */
+	void Prepare();
+
+	/**
+	 * Releases CPU data no longer needed by a prepared asset, and initializes
+	 * it. Runs on the game thread.
+	 */
+	void FinishPrepare();
+
+	/**
+	 * Loads splat data stored inline in the export, by assets saved before
+	 * bulk data was used.
+	 *
+	 * @param Ar - The archive to load from.
+	 */
+	void SerializeInline(FArchive& Ar);
+
+	/**
+	 * Copies splat data into bulk data to be saved, or out of loaded bulk data,
+	 * one stream each. Loaded bulk data is released once read.
+	 *
+	 * @param bSaving - Whether to copy into bulk data, rather than out of it.
+	 * @param bMapped - Whether GPU buffers are in mapped bulk data, i.e. the
+	 * data is cooked.
+	 * @param bStripCPUData - Whether to leave out data only used when sorting
+	 * on CPU, when saving cooked data.
+	 */
+	void
+	SerializeBulkData(bool bSaving, bool bMapped, bool bStripCPUData = false);
+
+	/**
+	 * Releases the copies of splat data made to save bulk data, once written.
+	 */
+	void ReleaseSavedBulkData();
+
+	/**
+	 * Sets derived data (i.e. packed positions and radii), from the derived
+	 * data cache if there, else by building and caching it.
+	 */
+	void CacheDerivedData();
+
+	/**
+	 * Builds derived data from source data.
+	 */
+	void BuildDerivedData();
+
+	/**
+	 * Saves derived data to or loads it from an archive.
+	 *
+	 * @param Ar - The archive.
+	 */
+	void SerializeDerivedData(FArchive& Ar);
+
+#if WITH_EDITORONLY_DATA
+	/**
+	 * @return Hash of the source data derived data is built from.
+	 */
+	FSHAHash ComputeSourceHash() const;
+#endif
+
 	/**
 	 * Creates packed position data from an array of positions. Does not copy or
 	 * destroy the given buffer.
@@ -159,13 +549,81 @@ private:
 	 */
 	void SetPositionsMetersInternal(const TArray<FVector3f>& PositionsMeters);
 
+#if WITH_EDITOR
+	/**
+	 * Quantizes covariance matrices into a codebook, with an index per splat,
+	 * and sets radii from the quantized scales.
+	 *
+	 * @param Rotations - Array of rotations, one per splat.
+	 * @param ScalesCM - Array of scales, one per splat, in centimeters.
+	 */
+	void SetCovarianceCodebook(
+		TConstArrayView<FQuat4f> Rotations,
+		TConstArrayView<FVector3f> ScalesCM);
+
+	/**
+	 * Logs the step positions are quantized in, warning if it is coarse enough
+	 * to misplace splats, and how much outliers are to blame. Shows the step
+	 * in the asset's details.
+	 */
+	void LogPositionPrecision();
+#endif
+
+	/**
+	 * Derives radii from packed covariances, for assets saved without them.
+	 * These are bounds, as only the variances survive packing.
+	 */
+	void SetRadiiFromCovariances();
+
+	/**
+	 * Copies opacities out of colors, as these are not kept on the CPU.
+	 */
+	void SetOpacitiesFromColors();
+
+	/**
+	 * Copies radii for the GPU, if there are any and they are not already.
+	 */
+	void SetRadiiBuffer();
+
+	/**
+	 * Packs level of detail nodes for the GPU, if there are any.
+	 */
+	void SetPackedLODNodes();
+
+	/**
+	 * Gathers every GPU buffer this asset has, as evicted and restored
+	 * together.
+	 *
+	 * @param OutBuffers - Returns the buffers.
+	 */
+	void GetGPUBuffers(
+		TArray<PICO::Splat::FSplatBufferBase*, TInlineAllocator<8>>&
+			OutBuffers);
+
 	uint32 NumSplats = 0;
 
+#if WITH_EDITORONLY_DATA
+	/** Largest step positions are quantized in. Steps coarser than about 1 cm visibly misplace splats up close. Cropping outliers, or splitting the scan into chunks (see Max Position Step in the project settings), makes them finer. */
+	UPROPERTY(
+		Category = Splat,
+		VisibleAnywhere,
+		Transient,
+		meta = (DisplayName = "Position Step", Units = "cm"))
+	float PositionStepCM = 0.f;
+#endif
+
 	TArray<FVector3f> PositionsFullPrecision;
 	FVector3f PosMinCM;
 	FVector3f PosMaxCM;
 	FVector3f PosScaleCM;
 
+	// Used for CPU sorting, and uploaded for foveated thinning on the GPU, so
+	// both thin by the same radii.
+	TArray<FFloat16> RadiiCM;
+	std::optional<PICO::Splat::TSplatStaticBuffer<FFloat16>> RadiiBuffer;
+	// Only used for CPU sorting. Not serialized, as colors hold these.
+	TArray<uint8> Opacities;
+
 	/**
 	 * Note: Using optionals as these are not populated until after the
 	 * asset is constructed. This way, at least these buffers can always be
@@ -173,15 +631,91 @@ private:
 	 */
 	std::optional<PICO::Splat::TSplatStaticBuffer<PICO::Splat::FPackedPos>>
 		Positions;
+	// Covariances are either one per splat, or with the codebook format, an
+	// index per splat into a shared codebook.
+	ECovarianceFormat CovarianceFormat = ECovarianceFormat::Float10;
 	std::optional<PICO::Splat::TSplatStaticBuffer<PICO::Splat::FPackedCovMat>>
 		CovariancesCM;
+	std::optional<PICO::Splat::TSplatStaticBuffer<PICO::Splat::FPackedCovMat>>
+		CovarianceCodebook;
+	std::optional<PICO::Splat::TSplatStaticBuffer<uint16>> CovarianceIndices;
 	std::optional<PICO::Splat::TSplatStaticBuffer<FColor>> Colors;
+	// Higher-order spherical harmonics, at 8 bits per coefficient, either per
+	// splat, or with the codebook format, an index per splat into a shared
+	// codebook.
+	uint32 SHDegree = 0;
+	ESHFormat SHFormat = ESHFormat::None;
+	TArray<float> SHMin;
+	TArray<float> SHScale;
+	FMatrix44f LocalToSH = FMatrix44f::Identity;
+	std::optional<PICO::Splat::TSplatStaticBuffer<uint32>> SHCoefficients;
+	std::optional<PICO::Splat::TSplatStaticBuffer<uint16>> SHIndices;
 
 	TArray<FVector3f> ConvexHullVertices;
 	TArray<uint32> ConvexHullIndices;
 
+	// Level of detail hierarchy over the splats above, or empty. Kept on the
+	// CPU only for CPU sorting.
+	TArray<PICO::Splat::FSplatLODNode> LODNodes;
+	std::optional<PICO::Splat::TSplatStaticBuffer<PICO::Splat::FPackedLODNode>>
+		LODNodesBuffer;
+	uint32 NumLODLeaves = 0;
+
+	// With importance order, the fraction of coverage kept by drawing each of
+	// evenly spaced prefixes of the splats, ending with all of them. Else
+	// empty.
+	TArray<float> PrefixCoverage;
+
+	// Splat data is saved outside the export, in bulk data per stream, so the
+	// export stays small and each stream can be compressed, and streamed or
+	// inlined per platform when cooking. Empty once loaded or saved.
+	FByteBulkData PositionsBulkData;
+	FByteBulkData CovariancesBulkData;
+	FByteBulkData ColorsBulkData;
+	FByteBulkData SHBulkData;
+	FByteBulkData ConvexHullBulkData;
+	FByteBulkData LODBulkData;
+
+	// When cooked, GPU buffers, including packed positions, are instead each
+	// stored in their exact format, uncompressed, to be memory-mapped and
+	// uploaded without copies. Radii stay in the covariances stream.
+	// Covariances hold the codebook, with the codebook format.
+	bool bMappedBuffers = false;
+	FByteBulkData MappedPositionsBulkData;
+	FByteBulkData MappedCovariancesBulkData;
+	FByteBulkData MappedCovarianceIndicesBulkData;
+	FByteBulkData MappedColorsBulkData;
+	FByteBulkData MappedSHCoefficientsBulkData;
+	FByteBulkData MappedSHIndicesBulkData;
+
+#if WITH_EDITOR
+	// Streams being populated a window at a time, until EndStreamedSplats().
+	TStaticMeshVertexData<PICO::Splat::FPackedCovMat> StreamedCovariances;
+	TStaticMeshVertexData<FColor> StreamedColors;
+	TStaticMeshVertexData<uint32> StreamedSHCoefficients;
+#endif
+
+#if WITH_EDITORONLY_DATA
+	// Keys derived data in the derived data cache. Cooked assets are saved
+	// with derived data instead.
+	FSHAHash SourceHash;
+#endif
+
+	// Preparation of loaded assets, which FinishPrepare() follows.
+	UE::Tasks::FTask PrepareTask;
+	std::atomic<bool> bInitialized = false;
+	FSimpleMulticastDelegate InitializedDelegate;
+
 	FRenderCommandFence ReleaseResourcesFence;
 
+	// Set when loaded with the payloads of every GPU buffer memory-mapped and
+	// kept, so they can be evicted and uploaded again. Residency is only
+	// changed on the render thread.
+	bool bEvictable = false;
+	bool bGPUResident = true;
+	// Reading of evicted payloads back into memory, before uploading them.
+	UE::Tasks::FTask PrefetchTask;
+
 #if WITH_EDITOR
 	friend class USplatAssetFactory;
 #endif
@@ -0,0 +1,47 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "SplatChunkedComponent.h"
+
+#include "SplatChunkedActor.generated.h"
+
+/**
+ * Placeable object representing a 3DGS scene split into chunks, streamed in
+ * around players and Editor viewports.
+ * Holds a `USplatChunkedComponent`.
+ *
+ * @see https://dev.epicgames.com/documentation/en-us/unreal-engine/actors-in-unreal-engine
+ */
+UCLASS(ComponentWrapperClass)
+class PICOSPLATRUNTIME_API ASplatChunkedActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Creates a Splat Chunked Actor with a default Splat Chunked Component,
+	 * holding no asset.
+	 */
+	ASplatChunkedActor()
+	{
+		ChunkedComponent = CreateDefaultSubobject<USplatChunkedComponent>(
+			TEXT("ChunkedComponent"));
+		RootComponent = ChunkedComponent;
+	}
+
+private:
+	UPROPERTY(
+		BlueprintReadOnly,
+		Category = Splat,
+		VisibleAnywhere,
+		meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<USplatChunkedComponent> ChunkedComponent;
+
+#if WITH_EDITOR
+	friend class UActorFactorySplatChunked;
+#endif
+};
@@ -0,0 +1,73 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Box.h"
+#include "SplatAsset.h"
+#include "UObject/Object.h"
+#include "UObject/SoftObjectPtr.h"
+
+#include "SplatChunkedAsset.generated.h"
+
+/**
+ * A spatial cell of a chunked splat asset, stored as its own splat asset so it
+ * can be loaded and unloaded on its own.
+ */
+USTRUCT()
+struct FSplatChunk
+{
+	GENERATED_BODY()
+
+	// Splats of the cell, in the same space as every other chunk.
+	UPROPERTY(VisibleAnywhere, Category = Splat)
+	TSoftObjectPtr<USplatAsset> Asset;
+
+	// Bounds of the cell's splats, in centimeters.
+	UPROPERTY(VisibleAnywhere, Category = Splat)
+	FBox Bounds = FBox(ForceInit);
+
+	// GPU memory used once loaded, in bytes.
+	UPROPERTY(VisibleAnywhere, Category = Splat)
+	int64 GPUMemorySize = 0;
+};
+
+/**
+ * A scan too large to load at once, split into spatial cells (see
+ * `FSplatChunk`). Only references its chunks softly, so none are loaded with
+ * it, and `USplatChunkedComponent` loads those near streaming sources.
+ */
+UCLASS()
+class PICOSPLATRUNTIME_API USplatChunkedAsset : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @return Constant view of this asset's chunks.
+	 */
+	TConstArrayView<FSplatChunk> GetChunks() const { return Chunks; }
+
+	/**
+	 * @return Bounds of every chunk, in centimeters.
+	 */
+	const FBox& GetBounds() const { return Bounds; }
+
+#if WITH_EDITOR
+	/**
+	 * Adds a chunk to this asset.
+	 *
+	 * @param Asset - Splats of the chunk, built and initialized.
+	 */
+	void AddChunk(USplatAsset* Asset);
+#endif
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = Splat)
+	TArray<FSplatChunk> Chunks;
+
+	UPROPERTY()
+	FBox Bounds = FBox(ForceInit);
+};
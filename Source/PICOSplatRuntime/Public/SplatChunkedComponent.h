@@ -0,0 +1,101 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/StreamableManager.h"
+#include "SplatChunkedAsset.h"
+#include "SplatComponent.h"
+
+#include "SplatChunkedComponent.generated.h"
+
+/**
+ * Component holding a chunked 3DGS scene, too large to load at once.
+ *
+ * Draws nothing itself, but bounds every chunk, so World Partition streams
+ * its actor in by the whole scene. While registered, the chunks near
+ * streaming sources are loaded by `USplatStreamingSubsystem`, each drawn by a
+ * transient `USplatComponent` attached to this.
+ */
+UCLASS()
+class PICOSPLATRUNTIME_API USplatChunkedComponent final
+	: public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Creates a component holding no asset, without collision.
+	 */
+	USplatChunkedComponent();
+
+	//~ Begin UActorComponent Interface
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	//~ End UActorComponent Interface
+
+	//~ Begin USceneComponent Interface
+	virtual FBoxSphereBounds
+	CalcBounds(const FTransform& LocalToWorld) const override;
+	//~ End USceneComponent Interface
+
+	/**
+	 * Gets the asset this component is tied to, if any.
+	 *
+	 * @return The asset attached to this component, or nullptr.
+	 */
+	TObjectPtr<USplatChunkedAsset> GetAsset() const { return Asset; }
+
+	/**
+	 * @param Index - Index of the chunk in the asset.
+	 * @return Whether the chunk is loaded or loading, and so using memory.
+	 */
+	bool IsChunkRequested(int32 Index) const;
+
+	/**
+	 * @param Index - Index of the chunk in the asset.
+	 * @return Whether the chunk is still loading.
+	 */
+	bool IsChunkLoading(int32 Index) const;
+
+	/**
+	 * Starts loading a chunk, which is drawn once loaded. Does nothing if it
+	 * is already requested.
+	 *
+	 * @param Index - Index of the chunk in the asset.
+	 */
+	void RequestChunk(int32 Index);
+
+	/**
+	 * Stops drawing a chunk, cancelling its load if still loading, so it can
+	 * be garbage collected. In the Editor, loaded assets are standalone, so
+	 * stay loaded until their package is unloaded.
+	 *
+	 * @param Index - Index of the chunk in the asset.
+	 */
+	void ReleaseChunk(int32 Index);
+
+private:
+	/**
+	 * Creates the component drawing a chunk, once it has loaded.
+	 *
+	 * @param Index - Index of the chunk in the asset.
+	 */
+	void OnChunkLoaded(int32 Index);
+
+	UPROPERTY(Category = Splat, EditAnywhere)
+	TObjectPtr<USplatChunkedAsset> Asset;
+
+	// Components drawing each loaded chunk, or nullptr.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USplatComponent>> ChunkComponents;
+
+	// Handles keeping each requested chunk loaded, or nullptr.
+	TArray<TSharedPtr<FStreamableHandle>> Handles;
+
+#if WITH_EDITOR
+	friend class UActorFactorySplatChunked;
+#endif
+};
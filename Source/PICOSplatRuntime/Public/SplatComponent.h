@@ -35,6 +35,11 @@ public:
 #endif
 	//~ End UPrimitiveComponent Interface
 
+	//~ Begin UActorComponent Interface
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	//~ End UActorComponent Interface
+
 	//~ Begin USceneComponent Interface
 	virtual FBoxSphereBounds
 	CalcBounds(const FTransform& LocalToWorld) const override;
@@ -50,13 +55,29 @@ public:
 	 */
 	TObjectPtr<USplatAsset> GetAsset() const { return Asset; }
 
+	/**
+	 * Ties this component to an asset. *Must* be called before the component
+	 * is registered.
+	 *
+	 * @param InAsset - The asset to draw, or nullptr.
+	 */
+	void SetAsset(USplatAsset* InAsset);
+
 private:
+	/**
+	 * Builds collision and bounds from, and draws, an asset once initialized.
+	 */
+	void OnAssetInitialized();
+
 	UPROPERTY(Category = Splat, EditAnywhere)
 	TObjectPtr<USplatAsset> Asset;
 
 	UPROPERTY()
 	TObjectPtr<UBodySetup> BodySetup;
 
+	// Asset whose initialization this is bound to, while registered.
+	TWeakObjectPtr<USplatAsset> InitializingAsset;
+
 #if WITH_EDITOR
 	friend class UActorFactorySplat;
 #endif
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "Math/Color.h"
+#include "Math/UnrealMathUtility.h"
 
 namespace PICO::Splat
 {
@@ -13,5 +14,35 @@ static constexpr FColor EditorColor(50, 0, 110, 255);
 #endif
 
 static constexpr float MetersToCentimeters = 100.f;
+// Distance from the center of a splat at which it is cut off, in standard
+// deviations. Matches the standard radius of `ESplatRadius`.
+static constexpr float SplatRadiusStdDevs = UE_SQRT_2 * 2.f;
 static constexpr uint32 DepthMask = 0x0000FFFF;
+// Highest degree of spherical harmonics imported and evaluated.
+static constexpr uint32 MaxSupportedSHDegree = 3;
+
+/**
+ * Gets the number of spherical harmonic coefficients per color channel, not
+ * counting the constant term, which is baked into colors.
+ *
+ * @param Degree - Degree of the spherical harmonics.
+ * @return Number of coefficients per channel.
+ */
+constexpr uint32 GetNumSHCoefficients(uint32 Degree)
+{
+	return (Degree + 1) * (Degree + 1) - 1;
+}
+
+/**
+ * Gets the size of each splat's spherical harmonics, once compressed. Each
+ * coefficient is 8 bits, ordered by coefficient then channel, and packed 4 to
+ * a word.
+ *
+ * @param Degree - Degree of the spherical harmonics.
+ * @return Size of each splat's coefficients, in 32-bit words.
+ */
+constexpr uint32 GetSHStride(uint32 Degree)
+{
+	return (3 * GetNumSHCoefficients(Degree) + 3) / 4;
+}
 } // namespace PICO::Splat
\ No newline at end of file
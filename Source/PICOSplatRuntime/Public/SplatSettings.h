@@ -14,8 +14,9 @@ UENUM(BlueprintType)
 enum class ECovarianceFormat : uint8
 {
 	Float10 = 0 UMETA(DisplayName = "64 Bits: Float10/11x6"),
-	Float16 = 1 UMETA(DisplayName = "128 Bits: Float16x6 + Pad"),
-	Float32 = 2 UMETA(DisplayName = "256 Bits: Float32x6 + Pad")
+	Float16 = 1 UMETA(DisplayName = "128 Bits: Float16x6 + Pad", Hidden),
+	Float32 = 2 UMETA(DisplayName = "256 Bits: Float32x6 + Pad", Hidden),
+	Codebook16 = 3 UMETA(DisplayName = "16 Bits: Codebook Index")
 };
 
 UENUM(BlueprintType)
@@ -32,11 +33,29 @@ enum class EPositionFormat : uint8
 	Float32 = 2 UMETA(DisplayName = "128 Bits: Float32x3 + Pad")
 };
 
+UENUM(BlueprintType)
+enum class ESHFormat : uint8
+{
+	None = 0 UMETA(DisplayName = "None"),
+	Codebook = 1 UMETA(DisplayName = "Codebook: 16-Bit Index"),
+	Quantized = 2 UMETA(DisplayName = "Range Quantized: 8 Bits"),
+};
+
 UENUM(BlueprintType)
 enum class ESortingMethod : uint8
 {
 	CPUAsynchronous = 0 UMETA(DisplayName = "CPU Asynchronous"),
 	GPUSynchronous = 1 UMETA(DisplayName = "GPU Synchronous"),
+	Hybrid = 2 UMETA(DisplayName = "Hybrid"),
+};
+
+UENUM(BlueprintType)
+enum class EOversizedSplatPolicy : uint8
+{
+	None = 0 UMETA(DisplayName = "None"),
+	Cull = 1 UMETA(DisplayName = "Cull"),
+	Clamp = 2 UMETA(DisplayName = "Clamp Footprint"),
+	Fade = 3 UMETA(DisplayName = "Fade Opacity"),
 };
 
 UENUM(BlueprintType)
@@ -46,6 +65,36 @@ enum class ESplatRadius : uint8
 	Three = 1 UMETA(DisplayName = "3 σ"),
 };
 
+/**
+ * A ring of the view, outside which splats are thinned to a lower density.
+ */
+USTRUCT(BlueprintType)
+struct FSplatFoveationRing
+{
+	GENERATED_BODY()
+
+	FSplatFoveationRing() = default;
+	FSplatFoveationRing(float InInnerRadius, float InDensity)
+		: InnerRadius(InInnerRadius)
+		, Density(InDensity)
+	{
+	}
+
+	/** Distance from the center of the view at which this ring starts, as a fraction of the distance to its left or right edge. Rings apply until the next larger ring starts. */
+	UPROPERTY(
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, DisplayName = "Inner Radius"))
+	float InnerRadius = 0.f;
+
+	/** Fraction of low-importance splats kept within this ring. Kept splats are made more opaque to compensate. */
+	UPROPERTY(
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0.05, ClampMax = 1, DisplayName = "Density"))
+	float Density = 1.f;
+};
+
 /**
  * Global settings.
  *
@@ -61,12 +110,15 @@ public:
 	/**
 	 * Helper to check config `.ini` for sorting method.
 	 *
-	 * @return Whether to use GPU sorting.
+	 * @param Config - Config to read, e.g. of a platform being cooked for.
+	 * @return The sorting method in use.
 	 */
-	static bool IsSortingOnGPU()
+	static ESortingMethod GetSortingMethod(FConfigCacheIni* Config = GConfig)
 	{
+		check(Config);
+
 		FString SortingMethod;
-		if (GConfig->GetString(
+		if (Config->GetString(
 				TEXT("/Script/PICOSplatRuntime.SplatSettings"),
 				TEXT("SortingMethod"),
 				SortingMethod,
@@ -74,13 +126,18 @@ public:
 		{
 			const FString NAME_GPU_SYNC(TEXT("GPUSynchronous"));
 			const FString NAME_CPU_ASYNC(TEXT("CPUAsynchronous"));
+			const FString NAME_HYBRID(TEXT("Hybrid"));
 			if (SortingMethod == NAME_GPU_SYNC)
 			{
-				return true;
+				return ESortingMethod::GPUSynchronous;
 			}
 			else if (SortingMethod == NAME_CPU_ASYNC)
 			{
-				return false;
+				return ESortingMethod::CPUAsynchronous;
+			}
+			else if (SortingMethod == NAME_HYBRID)
+			{
+				return ESortingMethod::Hybrid;
 			}
 			else
 			{
@@ -88,7 +145,406 @@ public:
 			}
 		}
 
-		return false;
+		return ESortingMethod::CPUAsynchronous;
+	}
+
+	/**
+	 * Helper to check config `.ini` for sorting method.
+	 *
+	 * @param Config - Config to read, e.g. of a platform being cooked for.
+	 * @return Whether to use GPU sorting only. Hybrid sorting may still sort on
+	 * GPU, but also requires the data for CPU sorting.
+	 */
+	static bool IsSortingOnGPU(FConfigCacheIni* Config = GConfig)
+	{
+		return GetSortingMethod(Config) == ESortingMethod::GPUSynchronous;
+	}
+
+	/**
+	 * @return Format covariances of newly imported splats are stored in.
+	 */
+	static ECovarianceFormat GetCovarianceFormat()
+	{
+		return GetDefault<USplatSettings>()->CovarianceFormat;
+	}
+
+	/**
+	 * @return Format positions are packed in, for the GPU.
+	 */
+	static EPositionFormat GetPositionFormat()
+	{
+		return GetDefault<USplatSettings>()->PositionFormat;
+	}
+
+	/**
+	 * @return Maximum number of entries in the codebook of covariances of
+	 * newly imported splats, with the codebook format.
+	 */
+	static int32 GetCovarianceCodebookSize()
+	{
+		return FMath::Clamp(
+			GetDefault<USplatSettings>()->CovarianceCodebookSize, 1, 1 << 16);
+	}
+
+	/**
+	 * @return Format higher-order spherical harmonics of newly imported splats
+	 * are stored in, or none to discard them.
+	 */
+	static ESHFormat GetSHFormat()
+	{
+		return GetDefault<USplatSettings>()->SHFormat;
+	}
+
+	/**
+	 * @return Maximum number of entries in the codebook of spherical harmonics
+	 * of newly imported splats, with the codebook format.
+	 */
+	static int32 GetSHCodebookSize()
+	{
+		return FMath::Clamp(
+			GetDefault<USplatSettings>()->SHCodebookSize, 1, 1 << 16);
+	}
+
+	/**
+	 * @return Highest degree of spherical harmonics evaluated when drawing, in
+	 * [0, 3].
+	 */
+	static uint32 GetMaxSHDegree()
+	{
+		return uint32(
+			FMath::Clamp(GetDefault<USplatSettings>()->MaxSHDegree, 0, 3));
+	}
+
+	/**
+	 * @return Whether splat data is compressed when assets are saved.
+	 */
+	static bool ShouldCompressAssetData()
+	{
+		return GetDefault<USplatSettings>()->bCompressAssetData;
+	}
+
+	/**
+	 * @return Opacity below which splats are removed at import, in [0, 1].
+	 */
+	static float GetMinImportOpacity()
+	{
+		return FMath::Clamp(
+			GetDefault<USplatSettings>()->MinImportOpacity, 0.f, 1.f);
+	}
+
+	/**
+	 * @return Size below which splats are removed at import, in centimeters.
+	 */
+	static float GetMinImportScale()
+	{
+		return FMath::Max(GetDefault<USplatSettings>()->MinImportScale, 0.f);
+	}
+
+	/**
+	 * @return Distance within which similar splats are merged at import, in
+	 * centimeters, or 0 to not merge splats.
+	 */
+	static float GetImportMergeDistance()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->ImportMergeDistance, 0.f);
+	}
+
+	/**
+	 * @return Opacity below which splats may be left out of the convex hull of
+	 * newly imported assets, in [0, 1].
+	 */
+	static float GetHullMinOpacity()
+	{
+		return FMath::Clamp(
+			GetDefault<USplatSettings>()->HullMinOpacity, 0.f, 1.f);
+	}
+
+	/**
+	 * @return Whether newly imported assets are given a level of detail
+	 * hierarchy.
+	 */
+	static bool ShouldGenerateLOD()
+	{
+		return GetDefault<USplatSettings>()->bGenerateLOD;
+	}
+
+	/**
+	 * @return Whether splats of newly imported assets without a level of
+	 * detail hierarchy are ordered by importance.
+	 */
+	static bool ShouldOrderByImportance()
+	{
+		return GetDefault<USplatSettings>()->bOrderByImportance;
+	}
+
+	/**
+	 * @return Size of file above which splats are imported a window at a time,
+	 * in bytes.
+	 */
+	static int64 GetStreamedImportSize()
+	{
+		constexpr int64 BYTES_PER_MB = 1024 * 1024;
+		return BYTES_PER_MB *
+		       FMath::Max(
+				   GetDefault<USplatSettings>()->StreamedImportSizeMB, 0);
+	}
+
+	/**
+	 * @return Size of the cells newly imported scans are split into, in
+	 * centimeters, or 0 to never split them.
+	 */
+	static float GetChunkSize()
+	{
+		return FMath::Max(GetDefault<USplatSettings>()->ChunkSize, 0.f);
+	}
+
+	/**
+	 * @return Coarsest step newly imported positions may be quantized in
+	 * horizontally, in centimeters, before scans are split, or 0 to never
+	 * split them for it.
+	 */
+	static float GetMaxPositionStep()
+	{
+		return FMath::Max(GetDefault<USplatSettings>()->MaxPositionStep, 0.f);
+	}
+
+	/**
+	 * @return Frame rate hybrid sorting attempts to hold, in Hz.
+	 */
+	static float GetHybridTargetFrameRate()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->HybridTargetFrameRate, 1.f);
+	}
+
+	/**
+	 * @return Worker thread time hybrid sorting may spend on CPU sorting each
+	 * frame, in milliseconds.
+	 */
+	static float GetHybridCPUSortBudgetMs()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->HybridCPUSortBudgetMs, 0.f);
+	}
+
+	/**
+	 * Gets the maximum amount of work a single CPU sorting task may do.
+	 *
+	 * @return Splats processed per sorting slice, or 0 for no limit.
+	 */
+	static uint32 GetCPUSortSliceBudget()
+	{
+		return uint32(
+			FMath::Max(GetDefault<USplatSettings>()->CPUSortSliceBudget, 0));
+	}
+
+	/**
+	 * @return Whether to draw a partially sorted order while a time-sliced CPU
+	 * sort is still in progress.
+	 */
+	static bool ShouldPublishPartialSort()
+	{
+		return GetDefault<USplatSettings>()->bPublishPartialSort;
+	}
+
+	/**
+	 * @return Projected radius below which splats are culled when sorting on
+	 * CPU, or thinning, in pixels, or 0 to disable culling.
+	 */
+	static float GetMinSplatRadiusPixels()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->MinSplatRadiusPixels, 0.f);
+	}
+
+	/**
+	 * @return Projected error up to which coarser levels of detail are drawn,
+	 * in pixels, or 0 to draw only the finest.
+	 */
+	static float GetMaxLODErrorPixels()
+	{
+		return FMath::Max(GetDefault<USplatSettings>()->MaxLODErrorPixels, 0.f);
+	}
+
+	/**
+	 * @return Distance within which every splat of assets ordered by
+	 * importance is drawn, in centimeters.
+	 */
+	static float GetImportanceFullDetailDistance()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->ImportanceFullDetailDistance, 1.f);
+	}
+
+	/**
+	 * @return Fewest splats of assets ordered by importance drawn, as a
+	 * fraction of each, in [0.01, 1].
+	 */
+	static float GetMinImportanceFraction()
+	{
+		return FMath::Clamp(
+			GetDefault<USplatSettings>()->MinImportanceFraction, 0.01f, 1.f);
+	}
+
+	/**
+	 * @return Most splats drawn per view, or 0 for no limit.
+	 */
+	static uint32 GetSplatBudget()
+	{
+		return uint32(FMath::Max(GetDefault<USplatSettings>()->SplatBudget, 0));
+	}
+
+	/**
+	 * @return Whether the splat budget is adjusted at runtime to hold the
+	 * budget target frame rate.
+	 */
+	static bool ShouldGovernSplatBudget()
+	{
+		return GetDefault<USplatSettings>()->bGovernSplatBudget;
+	}
+
+	/**
+	 * @return Frame rate the splat budget governor attempts to hold, in Hz.
+	 */
+	static float GetBudgetTargetFrameRate()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->BudgetTargetFrameRate, 1.f);
+	}
+
+	/**
+	 * @return Worker thread time CPU sorting may use each frame before the
+	 * splat budget governor shrinks the budget, in milliseconds, or 0 to
+	 * ignore it.
+	 */
+	static float GetBudgetCPUSortMs()
+	{
+		return FMath::Max(GetDefault<USplatSettings>()->BudgetCPUSortMs, 0.f);
+	}
+
+	/**
+	 * @return How splats covering too much of the screen are handled.
+	 */
+	static EOversizedSplatPolicy GetOversizedSplatPolicy()
+	{
+		return GetDefault<USplatSettings>()->OversizedSplatPolicy;
+	}
+
+	/**
+	 * @return Largest projected diameter of a splat before it is considered
+	 * oversized, as a fraction of the view width.
+	 */
+	static float GetMaxSplatScreenFraction()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->MaxSplatScreenFraction, 0.f);
+	}
+
+	/**
+	 * @return Whether splats in the outer rings of the view are thinned.
+	 */
+	static bool IsFoveatedThinningEnabled()
+	{
+		return GetDefault<USplatSettings>()->bFoveatedThinning;
+	}
+
+	/**
+	 * @return Rings of the view splats are thinned in, in any order.
+	 */
+	static const TArray<FSplatFoveationRing>& GetFoveationRings()
+	{
+		return GetDefault<USplatSettings>()->FoveationRings;
+	}
+
+	/**
+	 * @return Importance at which splats are never thinned, as their opacity
+	 * times their projected area, in pixels squared.
+	 */
+	static float GetFoveationImportanceArea()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->FoveationImportanceArea, 0.f);
+	}
+
+	/**
+	 * @return Time CPU sorting buffers are kept once unused, in seconds.
+	 */
+	static float GetSortingBufferIdleTimeout()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->SortingBufferIdleTimeout, 0.f);
+	}
+
+	/**
+	 * @return Distance from streaming sources within which chunks are loaded,
+	 * in centimeters.
+	 */
+	static float GetChunkLoadDistance()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->ChunkLoadDistance, 0.f);
+	}
+
+	/**
+	 * @return How much further than the load distance loaded chunks are kept,
+	 * as a fraction of the load distance.
+	 */
+	static float GetChunkUnloadHysteresis()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->ChunkUnloadHysteresis, 0.f);
+	}
+
+	/**
+	 * @return Most GPU memory used by loaded chunks, in bytes, or 0 for no
+	 * limit.
+	 */
+	static int64 GetChunkMemoryBudget()
+	{
+		constexpr int64 BYTES_PER_MB = 1024 * 1024;
+		return BYTES_PER_MB *
+		       FMath::Max(
+				   GetDefault<USplatSettings>()->ChunkMemoryBudgetMB, 0);
+	}
+
+	/**
+	 * @return Most chunks loading at once.
+	 */
+	static int32 GetMaxChunkLoads()
+	{
+		return FMath::Max(GetDefault<USplatSettings>()->MaxChunkLoads, 1);
+	}
+
+	/**
+	 * @return Most GPU memory the buffers of loaded splat assets may use, in
+	 * bytes, before those unused are evicted, or 0 to never evict them.
+	 */
+	static int64 GetResidencyBudget()
+	{
+		constexpr int64 BYTES_PER_MB = 1024 * 1024;
+		return BYTES_PER_MB *
+		       FMath::Max(GetDefault<USplatSettings>()->ResidencyBudgetMB, 0);
+	}
+
+	/**
+	 * @return Distance from a view within which evicted assets are uploaded
+	 * again, in centimeters.
+	 */
+	static float GetResidencyPrefetchDistance()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->ResidencyPrefetchDistance, 0.f);
+	}
+
+	/**
+	 * @return How far ahead the motion of views is extrapolated, to upload
+	 * evicted assets before they are reached, in seconds.
+	 */
+	static float GetResidencyLookahead()
+	{
+		return FMath::Max(
+			GetDefault<USplatSettings>()->ResidencyLookahead, 0.f);
 	}
 
 private:
@@ -101,17 +557,145 @@ private:
 	 * @see https://dev.epicgames.com/documentation/en-us/unreal-engine/property-specifiers?application_version=4.27
 	 */
 
-	/** Format used to store covariance (i.e. scaling and rotation) of splats. Larger formats increase asset size, memory usage and time spent reading data in shaders, in exchange for improved visual quality. */
+	/** Format used to store covariance (i.e. scaling and rotation) of newly imported splats. Larger formats increase asset size, memory usage and time spent reading data in shaders, in exchange for improved visual quality. The codebook format clusters similar covariances at import, storing a shared table of them and a 16-bit index per splat, which are expanded each frame before use. */
 	UPROPERTY(
 		Category = Configuration,
 		Config,
 		EditAnywhere,
-		meta =
-			(ConfigRestartRequired = true,
-	         DisplayName = "Covariance Format",
-	         EditCondition = false))
+		meta = (DisplayName = "Covariance Format"))
 	ECovarianceFormat CovarianceFormat = ECovarianceFormat::Float10;
 
+	/** With the codebook covariance format, the maximum number of distinct covariances stored per asset. Larger codebooks reduce error, at the cost of import time and a little memory. */
+	UPROPERTY(
+		Category = Configuration,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 256,
+	         ClampMax = 65536,
+	         DisplayName = "Covariance Codebook Size",
+	         EditCondition =
+	             "CovarianceFormat == ECovarianceFormat::Codebook16"))
+	int32 CovarianceCodebookSize = 65536;
+
+	/** Format used to store the higher-order spherical harmonics of newly imported splats, which make their color vary with view direction. Without them, only the base color is kept. The codebook format clusters similar coefficients at import, storing a shared table of them and a 16-bit index per splat. The range quantized format stores 8 bits per coefficient per splat, so is more accurate but larger. */
+	UPROPERTY(
+		Category = Configuration,
+		Config,
+		EditAnywhere,
+		meta = (DisplayName = "Spherical Harmonics Format"))
+	ESHFormat SHFormat = ESHFormat::Codebook;
+
+	/** With the codebook spherical harmonics format, the maximum number of distinct sets of coefficients stored per asset. Larger codebooks reduce error, at the cost of import time and memory. */
+	UPROPERTY(
+		Category = Configuration,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 256,
+	         ClampMax = 65536,
+	         DisplayName = "Spherical Harmonics Codebook Size",
+	         EditCondition = "SHFormat == ESHFormat::Codebook"))
+	int32 SHCodebookSize = 8192;
+
+	/** Highest degree of spherical harmonics evaluated when drawing. Each degree adds more view-dependent detail (e.g. reflections), at the cost of time spent reading and evaluating coefficients every frame. 0 draws only the base color. Assets imported with fewer degrees use all they have. */
+	UPROPERTY(
+		Category = Configuration,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         ClampMax = 3,
+	         DisplayName = "Max Spherical Harmonics Degree"))
+	int32 MaxSHDegree = 3;
+
+	/** Whether splat data is compressed with Oodle when assets are saved. Compression shrinks packages and, usually, load times, at the cost of time spent decompressing on load. Applies to assets saved after this is changed. */
+	UPROPERTY(
+		Category = Configuration,
+		Config,
+		EditAnywhere,
+		meta = (DisplayName = "Compress Asset Data"))
+	bool bCompressAssetData = true;
+
+	/** Newly imported splats less opaque than this are removed, as they contribute little to the image but cost as much to sort and draw as any other. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, ClampMax = 1, DisplayName = "Min Opacity"))
+	float MinImportOpacity = 1.f / 255.f;
+
+	/** Newly imported splats whose largest axis is smaller than this are removed. Splats with non-finite positions, rotations or scales are always removed. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, Units = "cm", DisplayName = "Min Scale"))
+	float MinImportScale = 0.001f;
+
+	/** Newly imported splats closer than this to one another, with similar colors and sizes, are merged into one preserving their combined shape. Reduces splat count in densely trained regions, at the cost of some fine detail. 0 disables merging. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, Units = "cm", DisplayName = "Merge Distance"))
+	float ImportMergeDistance = 0.f;
+
+	/** Newly imported splats less opaque than this are left out of the convex hull used for collision and bounds, so sparse, faint floaters do not inflate it. Splats outside the hull may be culled while on screen. 0 includes every splat. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         ClampMax = 1,
+	         DisplayName = "Convex Hull Min Opacity"))
+	float HullMinOpacity = 0.f;
+
+	/** Newly imported assets are given a level of detail hierarchy, built by merging neighboring splats into coarser parents, level by level. Only as much detail as can be seen is then drawn, so distant scans cost less, at the cost of about a third more memory. When sorting on CPU, only the detail drawn is sorted too, but when sorting on GPU every level is still sorted, so assets sorted on GPU pay for the coarser levels without sorting any less. Mutually exclusive with ordering splats by importance, and takes precedence over it. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta = (DisplayName = "Generate Levels of Detail"))
+	bool bGenerateLOD = false;
+
+	/** Splats of newly imported assets are grouped into spatial blocks, and ordered so that the most important of every block, by opacity, volume and contrast with their neighbors, come first. Assets far away then draw only a leading fraction of their splats, made more opaque to compensate, without the memory of a level of detail hierarchy. Mutually exclusive with generating levels of detail, which order splats by their hierarchy instead, so only takes effect with that disabled. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta = (DisplayName = "Order Splats by Importance"))
+	bool bOrderByImportance = false;
+
+	/** Files larger than this are imported a window of splats at a time, through temporary files, so memory used by import stays bounded by the packed asset rather than by the file. Streamed imports do not merge splats, generate levels of detail or order splats by importance, and store covariances and spherical harmonics per splat rather than in codebooks. 0 streams every import. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         Units = "MB",
+	         DisplayName = "Streamed Import Size"))
+	int32 StreamedImportSizeMB = 2048;
+
+	/** Newly imported scans wider than this are split into columns of this size, each saved as its own splat asset next to a chunked splat asset referencing them all. Placed with a Splat Chunked Actor, only the chunks near streaming sources (i.e. players, or Editor viewports) are loaded. Streamed imports are never split. 0 never splits scans for size, though they may still be for Max Position Step. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, DisplayName = "Chunk Size", Units = "cm"))
+	float ChunkSize = 0.f;
+
+	/** Newly imported scans too wide for positions to be quantized horizontally in steps of this size are split into chunks, as with Chunk Size, narrow enough that they are. Positions are quantized in 11 bits horizontally, so chunks are at most 2047 times this size. Tall scans may still be quantized more coarsely vertically, in 10 bits. Streamed imports are never split. 0 never splits scans for precision. */
+	UPROPERTY(
+		Category = Import,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0, DisplayName = "Max Position Step", Units = "cm"))
+	float MaxPositionStep = 0.f;
+
 	/** Format used for depth values when sorting splats. Higher bit counts may have slightly better results in certain scenes, at an increased performance cost. */
 	UPROPERTY(
 		Category = Configuration,
@@ -134,7 +718,7 @@ private:
 	         EditCondition = false))
 	EPositionFormat PositionFormat = EPositionFormat::UNorm10;
 
-	/** How splat sorting is performed. Asynchronous methods will be faster in exchange for a slight (albeit likely no noticeable) decrease in visual fidelity. CPU sorting will generally net a much higher framerate, but use a significant amount of CPU time. */
+	/** How splat sorting is performed. Asynchronous methods will be faster in exchange for a slight (albeit likely no noticeable) decrease in visual fidelity. CPU sorting will generally net a much higher framerate, but use a significant amount of CPU time. Hybrid sorting switches each splat between CPU and GPU sorting at runtime, based on measured frame times, at the cost of memory for both. */
 	UPROPERTY(
 		Category = Configuration,
 		Config,
@@ -142,6 +726,257 @@ private:
 		meta = (ConfigRestartRequired = true, DisplayName = "Sorting Method"))
 	ESortingMethod SortingMethod = ESortingMethod::CPUAsynchronous;
 
+	/** With hybrid sorting, the frame rate to hold. While the GPU takes longer than a frame at this rate, more splats are sorted on CPU. */
+	UPROPERTY(
+		Category = Sorting,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 1,
+	         DisplayName = "Hybrid Target Frame Rate",
+	         Units = "Hz"))
+	float HybridTargetFrameRate = 72.f;
+
+	/** With hybrid sorting, the worker thread time CPU sorting may use each frame, summed across all threads. While exceeded, more splats are sorted on GPU. */
+	UPROPERTY(
+		Category = Sorting,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "Hybrid CPU Sort Budget",
+	         Units = "ms"))
+	float HybridCPUSortBudgetMs = 8.f;
+
+	/** Maximum number of splats a CPU sorting task processes each frame. Assets larger than this are sorted over several frames, showing the previous order until finished. Lower values reduce worker thread time per frame, at the cost of a staler order, and of 8 bytes per splat to hold distances between frames. 0 sorts every asset in a single frame, without that memory. */
+	UPROPERTY(
+		Category = Sorting,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, DisplayName = "CPU Sort Slice Budget"))
+	int32 CPUSortSliceBudget = 0;
+
+	/** When a CPU sort spans multiple frames, draw its coarse order once the nearest splats are finalized, rather than waiting for the full sort. */
+	UPROPERTY(
+		Category = Sorting,
+		Config,
+		EditAnywhere,
+		meta = (DisplayName = "Publish Partial Sort"))
+	bool bPublishPartialSort = true;
+
+	/** When sorting on CPU, splats whose projected radius is smaller than this are culled, and not sorted, uploaded or drawn. Larger values save more time on large captures viewed from afar, at the cost of thinning fine detail. With foveated thinning, these are also culled when sorting on GPU, so either device keeps the same splats. 0 disables culling. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "Min Splat Radius",
+	         Units = "px"))
+	float MinSplatRadiusPixels = 0.5f;
+
+	/** For assets with levels of detail, coarser levels are drawn in place of finer ones while their projected error, i.e. how far they misplace detail, is at most this. Larger values save more time on scans viewed from afar, at the cost of blurring their detail. 0 draws only the finest level. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, DisplayName = "Max LOD Error", Units = "px"))
+	float MaxLODErrorPixels = 1.f;
+
+	/** For assets ordered by importance, every splat is drawn within this distance of their bounds. Beyond it, the fraction drawn falls with the square of distance, as does the area they cover on screen. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 1,
+	         DisplayName = "Importance Full Detail Distance",
+	         Units = "cm"))
+	float ImportanceFullDetailDistance = 1000.f;
+
+	/** For assets ordered by importance, the smallest fraction of their splats drawn, however far away or over budget. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0.01,
+	         ClampMax = 1,
+	         DisplayName = "Min Importance Fraction"))
+	float MinImportanceFraction = 0.1f;
+
+	/** Most splats drawn per view, across every visible asset, shared between them by how much of the screen each covers. Assets over their share draw fewer splats, as far as they can: those ordered by importance draw a shorter prefix, down to their min importance fraction, and others draw coarser levels of detail, or cull more small splats when sorted on CPU. 0 draws as many as distance allows. Overridden by `PICOSplat.Budget`. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, DisplayName = "Splat Budget"))
+	int32 SplatBudget = 0;
+
+	/** Whether to adjust the splat budget at runtime to hold the budget target frame rate. The budget shrinks while the render thread or GPU takes longer than a frame at that rate, or CPU sorting exceeds its time, and grows again once all are comfortably within. Never exceeds the splat budget, if set. Overridden by `PICOSplat.Budget.Govern`. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta = (DisplayName = "Govern Splat Budget"))
+	bool bGovernSplatBudget = false;
+
+	/** With a governed splat budget, the frame rate to hold. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 1,
+	         DisplayName = "Budget Target Frame Rate",
+	         Units = "Hz"))
+	float BudgetTargetFrameRate = 72.f;
+
+	/** With a governed splat budget, the worker thread time CPU sorting may use each frame, summed across all threads, before the budget shrinks. 0 ignores time spent CPU sorting. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "Budget CPU Sort Time",
+	         Units = "ms"))
+	float BudgetCPUSortMs = 8.f;
+
+	/** How splats covering more of the screen than the max screen fraction are handled, e.g. when leaning into a scan in VR. These cost the most fill rate, as every pixel is blended. Culling removes them, clamping shrinks them to the maximum size, and fading lowers their opacity in proportion to their excess area. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta = (DisplayName = "Oversized Splat Policy"))
+	EOversizedSplatPolicy OversizedSplatPolicy = EOversizedSplatPolicy::None;
+
+	/** Largest projected diameter of a splat, as a fraction of the view width, before the oversized splat policy applies. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         ClampMax = 4,
+	         DisplayName = "Max Splat Screen Fraction",
+	         EditCondition =
+	             "OversizedSplatPolicy != EOversizedSplatPolicy::None"))
+	float MaxSplatScreenFraction = 0.5f;
+
+	/** Whether to thin splats towards the edges of the view, where headset lenses resolve the least detail. Low-importance splats are dropped at random, but consistently for each splat so they do not shimmer, and the rest are made more opaque to compensate. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta = (DisplayName = "Foveated Thinning"))
+	bool bFoveatedThinning = false;
+
+	/** Rings of the view, each thinning splats outside it to its density. Up to 4 rings are used, ordered by radius. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta =
+			(DisplayName = "Foveation Rings",
+	         EditCondition = "bFoveatedThinning"))
+	TArray<FSplatFoveationRing> FoveationRings = {
+		FSplatFoveationRing(0.5f, 0.5f),
+		FSplatFoveationRing(0.8f, 0.25f)};
+
+	/** Splats whose opacity times projected area, in pixels squared, exceeds this are never thinned, while less important splats are thinned towards their ring's density. Larger values thin more of the scene. */
+	UPROPERTY(
+		Category = Culling,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "Foveation Importance Area",
+	         EditCondition = "bFoveatedThinning"))
+	float FoveationImportanceArea = 64.f;
+
+	/** How long CPU sorting buffers are kept once a splat is no longer sorted on CPU (e.g. hidden, or sorted on GPU), before being returned to a shared pool. Pooled buffers are reused by other splats, and freed once unused for the same time. Longer times avoid a splat needing to be sorted again before it is drawn, at the cost of memory. */
+	UPROPERTY(
+		Category = Sorting,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "Sorting Buffer Idle Timeout",
+	         Units = "s"))
+	float SortingBufferIdleTimeout = 5.f;
+
+	/** Chunks of chunked splat assets are loaded, nearest first, while within this distance of a streaming source, i.e. a player or Editor viewport, as World Partition streams cells. */
+	UPROPERTY(
+		Category = Streaming,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "Chunk Load Distance",
+	         Units = "cm"))
+	float ChunkLoadDistance = 10000.f;
+
+	/** How much further than the load distance a loaded chunk is kept, as a fraction of the load distance, so chunks at the edge are not loaded and unloaded repeatedly as streaming sources move. Loaded chunks are likewise favored over nearer chunks by this fraction when the memory budget is full. */
+	UPROPERTY(
+		Category = Streaming,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 0, DisplayName = "Chunk Unload Hysteresis"))
+	float ChunkUnloadHysteresis = 0.25f;
+
+	/** Most GPU memory loaded chunks may use, across every chunked splat asset. Once full, the furthest chunks are unloaded to make room for nearer ones. 0 loads every chunk within the load distance. In the Editor, chunks are assets kept loaded once loaded, so unloaded chunks stop drawing but keep their memory. */
+	UPROPERTY(
+		Category = Streaming,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "Chunk Memory Budget",
+	         Units = "MB"))
+	int32 ChunkMemoryBudgetMB = 4096;
+
+	/** Most chunks loading at once. Lower values spread loading and uploads over more frames. */
+	UPROPERTY(
+		Category = Streaming,
+		Config,
+		EditAnywhere,
+		meta = (ClampMin = 1, DisplayName = "Max Chunk Loads"))
+	int32 MaxChunkLoads = 4;
+
+	/** Most GPU memory the buffers of loaded splat assets may use. Once over, the buffers of assets not near any view are released, least recently visible first, and uploaded again as views approach. Only cooked assets whose buffers the platform memory-maps are evicted, as their mappings are kept to upload from. Elsewhere, buffers stay uploaded. Takes effect for assets loaded afterwards. 0 keeps every asset's buffers uploaded. */
+	UPROPERTY(
+		Category = Streaming,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "GPU Residency Budget",
+	         Units = "MB"))
+	int32 ResidencyBudgetMB = 0;
+
+	/** Evicted assets within this distance of a view are uploaded again, as are those in view. */
+	UPROPERTY(
+		Category = Streaming,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "GPU Residency Prefetch Distance",
+	         Units = "cm"))
+	float ResidencyPrefetchDistance = 5000.f;
+
+	/** Evicted assets within the prefetch distance of where views will be after this long, moving as they did last frame, are also uploaded again, so they are ready once reached. */
+	UPROPERTY(
+		Category = Streaming,
+		Config,
+		EditAnywhere,
+		meta =
+			(ClampMin = 0,
+	         DisplayName = "GPU Residency Lookahead",
+	         Units = "s"))
+	float ResidencyLookahead = 1.f;
+
 	/** The distance from the center of each splat, in standard deviations σ, in which to evaluate it. Larger values will improve visual fidelity with diminishing returns, while costing increasingly more time in fragment shading. */
 	UPROPERTY(
 		Category = Configuration,